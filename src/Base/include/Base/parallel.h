@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief Parallel execution interface
+ */
+#ifndef BASE_PARALLEL_H
+#define BASE_PARALLEL_H
+
+/**
+ * \brief A task executed by PAR_run()
+ *
+ * \param[in,out] context The context passed to PAR_run()
+ * \param[in] index The index of the task, in range [0, number_of_tasks)
+ */
+typedef void (*PAR_Task)(void *context, int index);
+
+/**
+ * \brief Get a suitable number of threads for parallel work, i.e. the number of online CPUs
+ *
+ * \param[in] max_threads The maximum number of threads
+ *
+ * \return Number of threads in range [1, max_threads]
+ */
+int PAR_get_number_of_threads(
+    int max_threads);
+
+/**
+ * \brief Run tasks in parallel, one thread per task
+ *
+ * The calling thread runs the first task itself and blocks until all tasks are done. Tasks that
+ * could not be started in a separate thread are run by the calling thread.
+ *
+ * \param[in] task The task
+ * \param[in,out] context The context passed to each task
+ * \param[in] number_of_tasks The number of tasks
+ */
+void PAR_run(
+    PAR_Task task,
+    void *context,
+    int number_of_tasks);
+
+#endif /* BASE_PARALLEL_H */
@@ -0,0 +1,68 @@
+/**
+ * \file
+ * \brief Triple buffer interface
+ *
+ * Lock-free exchange of snapshots between one writer thread and one reader thread. The writer
+ * fills the write buffer and publishes it, the reader gets the latest published snapshot. Neither
+ * side ever waits for the other: the writer always has a buffer to fill and the reader always has
+ * a complete snapshot to read, snapshots published between two reads are skipped.
+ */
+#ifndef BASE_TRIPLE_BUFFER_H
+#define BASE_TRIPLE_BUFFER_H
+
+#include <stddef.h>
+
+struct TB_TripleBuffer;
+
+/**
+ * \brief Create a triple buffer, all buffers are zero initialized
+ *
+ * \param[in] size The size of a snapshot [bytes]
+ *
+ * \return Triple buffer
+ */
+struct TB_TripleBuffer * TB_create(
+    size_t size);
+
+/**
+ * \brief Destroy a triple buffer
+ *
+ * \param[in] triple_buffer The triple buffer to destroy, do not use it anymore
+ */
+void TB_destroy(
+    struct TB_TripleBuffer *triple_buffer);
+
+/**
+ * \brief Get the buffer to write the next snapshot to, may only be called by the writer
+ *
+ * The buffer is not cleared, it contains an older snapshot.
+ *
+ * \param[in] triple_buffer The triple buffer
+ *
+ * \return The write buffer, valid until TB_publish() is called
+ */
+void * TB_get_write_buffer(
+    const struct TB_TripleBuffer *triple_buffer);
+
+/**
+ * \brief Publish the write buffer as the latest snapshot, may only be called by the writer
+ *
+ * \param[in,out] triple_buffer The triple buffer
+ */
+void TB_publish(
+    struct TB_TripleBuffer *triple_buffer);
+
+/**
+ * \brief Get the latest published snapshot, may only be called by the reader
+ *
+ * The same snapshot is returned again if nothing has been published since the last call. All
+ * buffers are zero if nothing has been published yet.
+ *
+ * \param[in,out] triple_buffer The triple buffer
+ *
+ * \return The snapshot, valid until the next call
+ */
+const void * TB_read(
+    struct TB_TripleBuffer *triple_buffer);
+
+#endif /* BASE_TRIPLE_BUFFER_H */
@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \brief Parallel execution implementation
+ */
+#include <Base/parallel.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * \brief Argument of a thread running a task
+ */
+struct TaskArgument
+{
+    PAR_Task task; /**< The task */
+    void *context; /**< The context of the task */
+    int index; /**< The index of the task */
+};
+
+/**
+ * \brief Thread entry point, runs a task
+ *
+ * \param[in] argument The task (struct TaskArgument)
+ *
+ * \return NULL
+ */
+static void * run_task(
+    void *const argument)
+{
+    const struct TaskArgument *const task_argument = argument;
+
+    task_argument->task(task_argument->context, task_argument->index);
+
+    return NULL;
+}
+
+int PAR_get_number_of_threads(
+    const int max_threads)
+{
+    const long online_processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (online_processors < 1)
+    {
+        return 1;
+    }
+
+    return (online_processors < max_threads) ? (int)online_processors : ((max_threads < 1) ? 1 : max_threads);
+}
+
+void PAR_run(
+    const PAR_Task task,
+    void *const context,
+    const int number_of_tasks)
+{
+    if (number_of_tasks <= 0)
+    {
+        return;
+    }
+
+    pthread_t *const threads = calloc((size_t)number_of_tasks, sizeof(*threads));
+    struct TaskArgument *const arguments = calloc((size_t)number_of_tasks, sizeof(*arguments));
+    int *const created = calloc((size_t)number_of_tasks, sizeof(*created));
+
+    for (int i = 0; i < number_of_tasks; ++i)
+    {
+        arguments[i].task = task;
+        arguments[i].context = context;
+        arguments[i].index = i;
+
+        created[i] = (i > 0) && (pthread_create(&threads[i], NULL, run_task, &arguments[i]) == 0);
+    }
+
+    for (int i = 0; i < number_of_tasks; ++i)
+    {
+        if (!created[i])
+        {
+            task(context, i);
+        }
+    }
+
+    for (int i = 0; i < number_of_tasks; ++i)
+    {
+        if (created[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    free(created);
+    free(arguments);
+    free(threads);
+}
@@ -0,0 +1,46 @@
+#include <Base/common.h>
+#include <Base/parallel.h>
+#include <TestFramework/test_framework.h>
+
+int TF_test_case_status;
+
+static void square_task(
+    void *const context,
+    const int index)
+{
+    int *const values = context;
+
+    values[index] = index * index;
+}
+
+static void test_PAR_run(void)
+{
+    int values[17] = {0};
+
+    PAR_run(square_task, values, LENGTH(values));
+
+    for (int i = 0; i < (int)LENGTH(values); ++i)
+    {
+        TF_assert(values[i] == i * i);
+    }
+}
+
+static void test_PAR_get_number_of_threads(void)
+{
+    TF_assert(PAR_get_number_of_threads(1) == 1);
+    TF_assert(PAR_get_number_of_threads(0) == 1);
+    TF_assert(PAR_get_number_of_threads(1000) >= 1);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_PAR_run,
+        test_PAR_get_number_of_threads,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
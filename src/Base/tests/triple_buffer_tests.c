@@ -0,0 +1,131 @@
+#include <Base/common.h>
+#include <Base/parallel.h>
+#include <Base/triple_buffer.h>
+#include <TestFramework/test_framework.h>
+
+#include <stdatomic.h>
+
+#define SNAPSHOT_LENGTH (64)
+#define NUMBER_OF_SNAPSHOTS (100000)
+
+int TF_test_case_status;
+
+/* A snapshot is consistent if all values are equal. */
+struct Snapshot
+{
+    int values[SNAPSHOT_LENGTH];
+};
+
+struct Context
+{
+    struct TB_TripleBuffer *triple_buffer;
+    atomic_int done;
+    int consistent;
+    int in_order;
+};
+
+static void write_snapshot(
+    struct TB_TripleBuffer *const triple_buffer,
+    const int value)
+{
+    struct Snapshot *const snapshot = TB_get_write_buffer(triple_buffer);
+
+    for (int i = 0; i < SNAPSHOT_LENGTH; ++i)
+    {
+        snapshot->values[i] = value;
+    }
+
+    TB_publish(triple_buffer);
+}
+
+static void test_TB_read(void)
+{
+    struct TB_TripleBuffer *const triple_buffer = TB_create(sizeof(struct Snapshot));
+    const struct Snapshot *snapshot = TB_read(triple_buffer);
+
+    TF_assert(snapshot->values[0] == 0);
+
+    write_snapshot(triple_buffer, 1);
+    snapshot = TB_read(triple_buffer);
+    TF_assert(snapshot->values[0] == 1);
+
+    /* Nothing new published */
+    snapshot = TB_read(triple_buffer);
+    TF_assert(snapshot->values[0] == 1);
+
+    /* Only the latest snapshot is read */
+    write_snapshot(triple_buffer, 2);
+    write_snapshot(triple_buffer, 3);
+    write_snapshot(triple_buffer, 4);
+    snapshot = TB_read(triple_buffer);
+    TF_assert(snapshot->values[SNAPSHOT_LENGTH - 1] == 4);
+
+    TB_destroy(triple_buffer);
+}
+
+static void concurrent_task(
+    void *const argument,
+    const int index)
+{
+    struct Context *const context = argument;
+
+    if (index == 0)
+    {
+        int previous_value = 0;
+
+        while (!atomic_load(&context->done))
+        {
+            const struct Snapshot *const snapshot = TB_read(context->triple_buffer);
+
+            for (int i = 0; i < SNAPSHOT_LENGTH; ++i)
+            {
+                context->consistent &= (snapshot->values[i] == snapshot->values[0]);
+            }
+
+            context->in_order &= (snapshot->values[0] >= previous_value);
+            previous_value = snapshot->values[0];
+        }
+    }
+    else
+    {
+        for (int i = 1; i <= NUMBER_OF_SNAPSHOTS; ++i)
+        {
+            write_snapshot(context->triple_buffer, i);
+        }
+
+        atomic_store(&context->done, 1);
+    }
+}
+
+static void test_TB_concurrent(void)
+{
+    struct Context context = {
+        .triple_buffer = TB_create(sizeof(struct Snapshot)),
+        .consistent = 1,
+        .in_order = 1
+    };
+    atomic_init(&context.done, 0);
+
+    PAR_run(concurrent_task, &context, 2);
+
+    TF_assert(context.consistent);
+    TF_assert(context.in_order);
+
+    const struct Snapshot *const snapshot = TB_read(context.triple_buffer);
+    TF_assert(snapshot->values[0] == NUMBER_OF_SNAPSHOTS);
+
+    TB_destroy(context.triple_buffer);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_TB_read,
+        test_TB_concurrent,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
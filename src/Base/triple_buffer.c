@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \brief Triple buffer implementation
+ */
+#include <Base/triple_buffer.h>
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define NUMBER_OF_BUFFERS (3)
+/* Set in the shared index when the shared buffer holds a snapshot that has not been read. */
+#define NEW_SNAPSHOT (4U)
+
+/**
+ * \brief Triple buffer
+ *
+ * At any time the writer owns one buffer, the reader owns one buffer, and the third is shared.
+ * Publishing and reading swap the owned buffer with the shared one in a single atomic exchange.
+ */
+struct TB_TripleBuffer
+{
+    unsigned char *buffers; /**< The buffers, stored after each other */
+    size_t size; /**< The size of a buffer [bytes] */
+    unsigned int write_index; /**< The buffer owned by the writer */
+    unsigned int read_index; /**< The buffer owned by the reader */
+    atomic_uint shared_index; /**< The shared buffer, combined with NEW_SNAPSHOT */
+};
+
+struct TB_TripleBuffer * TB_create(
+    const size_t size)
+{
+    struct TB_TripleBuffer *const triple_buffer = calloc(1, sizeof(*triple_buffer));
+
+    triple_buffer->buffers = calloc(NUMBER_OF_BUFFERS, size);
+    triple_buffer->size = size;
+    triple_buffer->write_index = 0;
+    triple_buffer->read_index = 1;
+    atomic_init(&triple_buffer->shared_index, 2);
+
+    return triple_buffer;
+}
+
+void TB_destroy(
+    struct TB_TripleBuffer *const triple_buffer)
+{
+    free(triple_buffer->buffers);
+    free(triple_buffer);
+}
+
+void * TB_get_write_buffer(
+    const struct TB_TripleBuffer *const triple_buffer)
+{
+    return &triple_buffer->buffers[triple_buffer->write_index * triple_buffer->size];
+}
+
+void TB_publish(
+    struct TB_TripleBuffer *const triple_buffer)
+{
+    /* Release makes the written snapshot visible to the reader that acquires it. */
+    const unsigned int previous_index = atomic_exchange_explicit(
+        &triple_buffer->shared_index, triple_buffer->write_index | NEW_SNAPSHOT, memory_order_acq_rel);
+
+    triple_buffer->write_index = previous_index & ~NEW_SNAPSHOT;
+}
+
+const void * TB_read(
+    struct TB_TripleBuffer *const triple_buffer)
+{
+    /* Only the reader clears NEW_SNAPSHOT, so it stays set until the exchange below. */
+    if (atomic_load_explicit(&triple_buffer->shared_index, memory_order_relaxed) & NEW_SNAPSHOT)
+    {
+        const unsigned int previous_index = atomic_exchange_explicit(
+            &triple_buffer->shared_index, triple_buffer->read_index, memory_order_acq_rel);
+
+        triple_buffer->read_index = previous_index & ~NEW_SNAPSHOT;
+    }
+
+    return &triple_buffer->buffers[triple_buffer->read_index * triple_buffer->size];
+}
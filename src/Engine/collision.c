@@ -0,0 +1,431 @@
+/**
+ * \file
+ * \brief Collision detection implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/collision.h>
+#include <Engine/object.h>
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define INITIAL_PAIRS_CAPACITY (1024)
+
+/**
+ * \brief A cell in a uniform grid
+ */
+struct Cell
+{
+    int64_t x; /**< Cell index in the x direction */
+    int64_t y; /**< Cell index in the y direction */
+    int64_t z; /**< Cell index in the z direction */
+};
+
+/**
+ * \brief A uniform grid of cells
+ */
+struct Grid
+{
+    double cell_size; /**< The side of a cell */
+    uint64_t row_stride; /**< The difference in cell index between neighboring rows (y) */
+    uint64_t slice_stride; /**< The difference in cell index between neighboring slices (z) */
+    uint64_t mask; /**< The number of buckets minus one, the number of buckets is a power of two */
+};
+
+/**
+ * \brief A body in the spatial hash
+ */
+struct SortedBody
+{
+    struct COLL_Body body; /**< The body */
+    struct Cell cell; /**< The cell of the body */
+    int index; /**< The index of the body */
+};
+
+/**
+ * \brief The beginning of the bounding box of a body along the x-axis, see sweep and prune
+ */
+struct Interval
+{
+    double begin; /**< The smallest x value of the bounding box */
+    int index; /**< The index of the body */
+};
+
+/**
+ * \brief Broad phase
+ */
+struct COLL_BroadPhase
+{
+    struct COLL_Pair *pairs; /**< The candidate pairs */
+    int pairs_length; /**< Number of candidate pairs */
+    int pairs_capacity; /**< Number of pairs that fit in pairs */
+    /**
+     * The index in sorted_bodies of the first body in each bucket of the spatial hash, followed by
+     * the number of bodies. The bodies in a bucket are thus found in the range
+     * [bucket_begin[bucket], bucket_begin[bucket + 1]).
+     */
+    int *bucket_begin;
+    int buckets_capacity; /**< Number of buckets that fit in bucket_begin, not counting the end */
+    /**
+     * Copies of the bodies sorted by bucket, so that the bodies in a bucket are stored next to each
+     * other
+     */
+    struct SortedBody *sorted_bodies;
+    uint64_t *body_buckets; /**< The bucket of each body */
+    struct Interval *intervals; /**< The bodies sorted along the x-axis */
+    int bodies_capacity; /**< Number of bodies that fit in the body buffers */
+};
+
+/**
+ * \brief Get the cell of a coordinate
+ *
+ * \param[in] coordinate The coordinate
+ * \param[in] cell_size The side of a cell
+ * \param[out] cell The cell
+ */
+static void get_cell(
+    const struct COORD_Coordinate3D *const coordinate,
+    const double cell_size,
+    struct Cell *const cell)
+{
+    cell->x = (int64_t)floor(coordinate->x / cell_size);
+    cell->y = (int64_t)floor(coordinate->y / cell_size);
+    cell->z = (int64_t)floor(coordinate->z / cell_size);
+}
+
+/**
+ * \brief Get the bucket of a cell in the spatial hash, different cells may share a bucket
+ *
+ * The hash is the index of the cell in a grid that covers all bodies, wrapped to the number of
+ * buckets. Neighboring cells are thus in nearby buckets, and the bodies in neighboring cells are
+ * stored close to each other, which makes finding the pairs cache friendly.
+ *
+ * \param[in] grid The grid
+ * \param[in] cell The cell
+ *
+ * \return The bucket
+ */
+static uint64_t get_bucket(
+    const struct Grid *const grid,
+    const struct Cell *const cell)
+{
+    return ((uint64_t)cell->x + ((uint64_t)cell->y * grid->row_stride) + ((uint64_t)cell->z * grid->slice_stride)) &
+        grid->mask;
+}
+
+/**
+ * \brief Get a grid covering bodies, the cells are as large as the largest bounding box
+ *
+ * \param[in] bodies The bodies
+ * \param[in] length The number of bodies, at least one
+ * \param[in] number_of_buckets The number of buckets, a power of two
+ * \param[out] grid The grid
+ */
+static void get_grid(
+    const struct COLL_Body *const bodies,
+    const int length,
+    const int number_of_buckets,
+    struct Grid *const grid)
+{
+    struct COORD_Coordinate3D min = bodies[0].position;
+    struct COORD_Coordinate3D max = bodies[0].position;
+    double max_radius = 0.0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        const struct COORD_Coordinate3D *const position = &bodies[i].position;
+
+        min.x = fmin(min.x, position->x);
+        min.y = fmin(min.y, position->y);
+        min.z = fmin(min.z, position->z);
+        max.x = fmax(max.x, position->x);
+        max.y = fmax(max.y, position->y);
+        max.z = fmax(max.z, position->z);
+        max_radius = fmax(max_radius, bodies[i].radius);
+    }
+
+    /* Bodies with overlapping bounding boxes are in the same or neighboring cells. */
+    grid->cell_size = (max_radius > 0.0) ? (2.0 * max_radius) : 1.0;
+    grid->mask = (uint64_t)number_of_buckets - 1U;
+
+    /* One extra cell on each side so that neighbors of different rows do not share buckets, the
+     * strides only matter modulo the number of buckets. */
+    const double buckets = number_of_buckets;
+    const double columns = fmin(floor((max.x - min.x) / grid->cell_size) + 3.0, buckets);
+    const double rows = fmin(floor((max.y - min.y) / grid->cell_size) + 3.0, buckets);
+    grid->row_stride = (uint64_t)columns;
+    grid->slice_stride = ((uint64_t)columns * (uint64_t)rows) & grid->mask;
+}
+
+/**
+ * \brief Check if the bounding boxes of two bodies overlap
+ *
+ * \param[in] a The first body
+ * \param[in] b The second body
+ *
+ * \return Non-zero if the bounding boxes overlap
+ */
+static int is_overlapping(
+    const struct COLL_Body *const a,
+    const struct COLL_Body *const b)
+{
+    const double radii = a->radius + b->radius;
+
+    return (fabs(a->position.x - b->position.x) <= radii) &&
+        (fabs(a->position.y - b->position.y) <= radii) &&
+        (fabs(a->position.z - b->position.z) <= radii);
+}
+
+/**
+ * \brief Add a candidate pair
+ *
+ * \param[in,out] broad_phase The broad phase
+ * \param[in] a The index of one body
+ * \param[in] b The index of the other body
+ */
+static void add_pair(
+    struct COLL_BroadPhase *const broad_phase,
+    const int a,
+    const int b)
+{
+    if (broad_phase->pairs_length == broad_phase->pairs_capacity)
+    {
+        broad_phase->pairs_capacity *= 2;
+        broad_phase->pairs =
+            realloc(broad_phase->pairs, (size_t)broad_phase->pairs_capacity * sizeof(*broad_phase->pairs));
+    }
+
+    struct COLL_Pair *const pair = &broad_phase->pairs[broad_phase->pairs_length++];
+    pair->first = (a < b) ? a : b;
+    pair->second = (a < b) ? b : a;
+}
+
+/**
+ * \brief Make sure the buffers can hold a certain number of bodies
+ *
+ * \param[in,out] broad_phase The broad phase
+ * \param[in] length The number of bodies
+ */
+static void reserve_bodies(
+    struct COLL_BroadPhase *const broad_phase,
+    const int length)
+{
+    if (length > broad_phase->bodies_capacity)
+    {
+        free(broad_phase->intervals);
+        free(broad_phase->body_buckets);
+        free(broad_phase->sorted_bodies);
+        broad_phase->sorted_bodies = calloc((size_t)length, sizeof(*broad_phase->sorted_bodies));
+        broad_phase->body_buckets = calloc((size_t)length, sizeof(*broad_phase->body_buckets));
+        broad_phase->intervals = calloc((size_t)length, sizeof(*broad_phase->intervals));
+        broad_phase->bodies_capacity = length;
+    }
+}
+
+/**
+ * \brief Compare the beginning of two intervals, see qsort()
+ *
+ * \param[in] a First interval (struct Interval)
+ * \param[in] b Second interval (struct Interval)
+ *
+ * \return Negative if a begins before b, positive if a begins after b
+ */
+static int compare_intervals(
+    const void *const a,
+    const void *const b)
+{
+    const double begin_a = ((const struct Interval *)a)->begin;
+    const double begin_b = ((const struct Interval *)b)->begin;
+
+    return (begin_a > begin_b) - (begin_a < begin_b);
+}
+
+double COLL_get_bounding_radius(
+    const struct OBJ_BoundingBox *const bounds)
+{
+    /* The corner farthest from the origin */
+    const double x = fmax(fabs(bounds->min.x), fabs(bounds->max.x));
+    const double y = fmax(fabs(bounds->min.y), fabs(bounds->max.y));
+    const double z = fmax(fabs(bounds->min.z), fabs(bounds->max.z));
+
+    return sqrt((x * x) + (y * y) + (z * z));
+}
+
+struct COLL_BroadPhase * COLL_create(void)
+{
+    struct COLL_BroadPhase *const broad_phase = calloc(1, sizeof(*broad_phase));
+
+    broad_phase->pairs = calloc(INITIAL_PAIRS_CAPACITY, sizeof(*broad_phase->pairs));
+    broad_phase->pairs_capacity = INITIAL_PAIRS_CAPACITY;
+
+    return broad_phase;
+}
+
+void COLL_destroy(
+    struct COLL_BroadPhase *const broad_phase)
+{
+    free(broad_phase->intervals);
+    free(broad_phase->body_buckets);
+    free(broad_phase->sorted_bodies);
+    free(broad_phase->bucket_begin);
+    free(broad_phase->pairs);
+    free(broad_phase);
+}
+
+int COLL_find_pairs_spatial_hash(
+    struct COLL_BroadPhase *const broad_phase,
+    const struct COLL_Body *const bodies,
+    const int length,
+    const struct COLL_Pair **const pairs)
+{
+    broad_phase->pairs_length = 0;
+    *pairs = broad_phase->pairs;
+
+    if (length <= 0)
+    {
+        return 0;
+    }
+
+    reserve_bodies(broad_phase, length);
+
+    /* At least twice as many buckets as bodies keeps the buckets short */
+    int number_of_buckets = 1;
+    while (number_of_buckets < 2 * length)
+    {
+        number_of_buckets *= 2;
+    }
+
+    if (number_of_buckets > broad_phase->buckets_capacity)
+    {
+        free(broad_phase->bucket_begin);
+        broad_phase->bucket_begin = calloc((size_t)number_of_buckets + 1U, sizeof(*broad_phase->bucket_begin));
+        broad_phase->buckets_capacity = number_of_buckets;
+    }
+
+    struct Grid grid;
+    get_grid(bodies, length, number_of_buckets, &grid);
+
+    int *const bucket_begin = broad_phase->bucket_begin;
+    struct SortedBody *const sorted_bodies = broad_phase->sorted_bodies;
+    uint64_t *const body_buckets = broad_phase->body_buckets;
+
+    /* Counting sort of the bodies by bucket. First count the bodies in each bucket, then let each
+     * bucket begin where the next bucket begins, and finally fill each bucket from the end. */
+    for (int i = 0; i <= number_of_buckets; ++i)
+    {
+        bucket_begin[i] = 0;
+    }
+
+    for (int i = 0; i < length; ++i)
+    {
+        struct Cell cell;
+        get_cell(&bodies[i].position, grid.cell_size, &cell);
+        body_buckets[i] = get_bucket(&grid, &cell);
+        ++bucket_begin[body_buckets[i]];
+    }
+
+    for (int i = 1; i <= number_of_buckets; ++i)
+    {
+        bucket_begin[i] += bucket_begin[i - 1];
+    }
+
+    for (int i = length; i > 0; --i)
+    {
+        struct SortedBody *const sorted_body = &sorted_bodies[--bucket_begin[body_buckets[i - 1]]];
+
+        sorted_body->body = bodies[i - 1];
+        get_cell(&bodies[i - 1].position, grid.cell_size, &sorted_body->cell);
+        sorted_body->index = i - 1;
+    }
+
+    /* The bodies are visited in sorted order, so bodies close to each other look in the same
+     * buckets after each other. Each pair is found from both bodies but only added from the one
+     * sorted first. */
+    for (int i = 0; i < length; ++i)
+    {
+        const struct SortedBody *const sorted_body = &sorted_bodies[i];
+
+        for (int64_t dz = -1; dz <= 1; ++dz)
+        {
+            for (int64_t dy = -1; dy <= 1; ++dy)
+            {
+                for (int64_t dx = -1; dx <= 1; ++dx)
+                {
+                    const struct Cell neighbor = {
+                        .x = sorted_body->cell.x + dx,
+                        .y = sorted_body->cell.y + dy,
+                        .z = sorted_body->cell.z + dz
+                    };
+                    const uint64_t bucket = get_bucket(&grid, &neighbor);
+                    const int begin = (bucket_begin[bucket] > i) ? bucket_begin[bucket] : (i + 1);
+
+                    for (int j = begin; j < bucket_begin[bucket + 1U]; ++j)
+                    {
+                        const struct SortedBody *const other = &sorted_bodies[j];
+
+                        /* Other cells may share the bucket */
+                        if ((other->cell.x == neighbor.x) &&
+                            (other->cell.y == neighbor.y) &&
+                            (other->cell.z == neighbor.z) &&
+                            is_overlapping(&sorted_body->body, &other->body))
+                        {
+                            add_pair(broad_phase, sorted_body->index, other->index);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    *pairs = broad_phase->pairs;
+
+    return broad_phase->pairs_length;
+}
+
+int COLL_find_pairs_sweep_and_prune(
+    struct COLL_BroadPhase *const broad_phase,
+    const struct COLL_Body *const bodies,
+    const int length,
+    const struct COLL_Pair **const pairs)
+{
+    broad_phase->pairs_length = 0;
+    *pairs = broad_phase->pairs;
+
+    if (length <= 0)
+    {
+        return 0;
+    }
+
+    reserve_bodies(broad_phase, length);
+
+    struct Interval *const intervals = broad_phase->intervals;
+
+    for (int i = 0; i < length; ++i)
+    {
+        intervals[i].begin = bodies[i].position.x - bodies[i].radius;
+        intervals[i].index = i;
+    }
+
+    qsort(intervals, (size_t)length, sizeof(*intervals), compare_intervals);
+
+    for (int i = 0; i < length; ++i)
+    {
+        const struct COLL_Body *const body = &bodies[intervals[i].index];
+        const double end = body->position.x + body->radius;
+
+        /* The following bodies begin after this body begins, they overlap along the x-axis until
+         * they begin after this body ends. */
+        for (int j = i + 1; (j < length) && (intervals[j].begin <= end); ++j)
+        {
+            if (is_overlapping(body, &bodies[intervals[j].index]))
+            {
+                add_pair(broad_phase, intervals[i].index, intervals[j].index);
+            }
+        }
+    }
+
+    *pairs = broad_phase->pairs;
+
+    return broad_phase->pairs_length;
+}
@@ -0,0 +1,283 @@
+/**
+ * \file
+ * \brief Compositor implementation
+ */
+#include <Engine/compositor.h>
+#include <Engine/renderer.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#define MAGIC (0x504D4F43U) /* "COMP" in little endian */
+
+/**
+ * \brief Frame header, sent before the pixels of each frame
+ */
+struct FrameHeader
+{
+    uint32_t magic; /**< Identifies the message as a frame */
+    uint32_t width; /**< The width of the frame [pixels] */
+    uint32_t height; /**< The height of the frame [pixels] */
+    uint32_t padding; /**< Always 0 */
+};
+
+/**
+ * \brief Compositor
+ */
+struct COMP_Compositor
+{
+    struct MAT_Matrix *frame_buffer; /**< The composited frame buffer */
+    struct MAT_Matrix *z_buffer; /**< The composited z buffer */
+    unsigned char *colors; /**< Buffer for the characters of a sent or received frame */
+    float *depths; /**< Buffer for the depths of a sent or received frame */
+};
+
+/**
+ * \brief Get the range of items a worker gets when the items are split in contiguous ranges
+ *
+ * \param[in] length The number of items
+ * \param[in] worker The index of the worker
+ * \param[in] number_of_workers The number of workers
+ * \param[out] begin The first item of the worker
+ * \param[out] end One past the last item of the worker
+ */
+static void get_range(
+    const int length,
+    const int worker,
+    const int number_of_workers,
+    int *const begin,
+    int *const end)
+{
+    *begin = (int)(((long long)length * worker) / number_of_workers);
+    *end = (int)(((long long)length * (worker + 1)) / number_of_workers);
+}
+
+/**
+ * \brief Send all bytes of a buffer
+ *
+ * \param[in] socket The socket
+ * \param[in] data The buffer
+ * \param[in] size The size of the buffer [bytes]
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int send_all(
+    const int socket,
+    const void *const data,
+    const size_t size)
+{
+    const unsigned char *const bytes = data;
+    size_t sent = 0;
+
+    while (sent < size)
+    {
+        /* No SIGPIPE if the other end is closed, the error is returned instead */
+        const ssize_t result = send(socket, &bytes[sent], size - sent, MSG_NOSIGNAL);
+
+        if ((result < 0) && (errno != EINTR))
+        {
+            return -1;
+        }
+
+        sent += (result < 0) ? 0U : (size_t)result;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Receive bytes until a buffer is full
+ *
+ * \param[in] socket The socket
+ * \param[out] data The buffer
+ * \param[in] size The size of the buffer [bytes]
+ *
+ * \return 0 on success a non-zero value otherwise, e.g. if the other end is closed
+ */
+static int receive_all(
+    const int socket,
+    void *const data,
+    const size_t size)
+{
+    unsigned char *const bytes = data;
+    size_t received = 0;
+
+    while (received < size)
+    {
+        const ssize_t result = recv(socket, &bytes[received], size - received, 0);
+
+        if ((result == 0) || ((result < 0) && (errno != EINTR)))
+        {
+            return -1;
+        }
+
+        received += (result < 0) ? 0U : (size_t)result;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Receive a frame into the buffers of a compositor
+ *
+ * \param[in,out] compositor The compositor
+ * \param[in] socket The socket
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int receive_frame(
+    struct COMP_Compositor *const compositor,
+    const int socket)
+{
+    const size_t number_of_pixels = (size_t)compositor->frame_buffer->rows * (size_t)compositor->frame_buffer->cols;
+    struct FrameHeader header;
+
+    if ((receive_all(socket, &header, sizeof(header)) != 0) ||
+        (header.magic != MAGIC) ||
+        (header.width != (uint32_t)compositor->frame_buffer->cols) ||
+        (header.height != (uint32_t)compositor->frame_buffer->rows))
+    {
+        return -1;
+    }
+
+    return (receive_all(socket, compositor->colors, number_of_pixels * sizeof(*compositor->colors)) != 0) ||
+        (receive_all(socket, compositor->depths, number_of_pixels * sizeof(*compositor->depths)) != 0);
+}
+
+void COMP_get_partition(
+    const struct REND_Objects *const objects,
+    const int worker,
+    const int number_of_workers,
+    struct REND_Objects *const partition)
+{
+    assert((worker >= 0) && (worker < number_of_workers)); // LCOV_EXCL_LINE
+
+    int begin;
+    int end;
+
+    get_range(objects->length, worker, number_of_workers, &begin, &end);
+    partition->objects = &objects->objects[begin];
+    partition->length = end - begin;
+
+    get_range(objects->number_of_instances, worker, number_of_workers, &begin, &end);
+    partition->instances = &objects->instances[begin];
+    partition->number_of_instances = end - begin;
+
+    get_range(objects->number_of_particle_systems, worker, number_of_workers, &begin, &end);
+    partition->particle_systems = &objects->particle_systems[begin];
+    partition->number_of_particle_systems = end - begin;
+}
+
+struct COMP_Compositor * COMP_create(
+    const int width,
+    const int height)
+{
+    struct COMP_Compositor *const compositor = calloc(1, sizeof(*compositor));
+    const size_t number_of_pixels = (size_t)width * (size_t)height;
+
+    compositor->frame_buffer = MAT_alloc(height, width);
+    compositor->z_buffer = MAT_alloc(height, width);
+    compositor->colors = calloc(number_of_pixels, sizeof(*compositor->colors));
+    compositor->depths = calloc(number_of_pixels, sizeof(*compositor->depths));
+    MAT_set_all_elements(compositor->frame_buffer, (double)' ');
+    MAT_set_all_elements(compositor->z_buffer, INFINITY);
+
+    return compositor;
+}
+
+void COMP_destroy(
+    struct COMP_Compositor *const compositor)
+{
+    free(compositor->depths);
+    free(compositor->colors);
+    MAT_free(compositor->z_buffer);
+    MAT_free(compositor->frame_buffer);
+    free(compositor);
+}
+
+int COMP_send_frame(
+    struct COMP_Compositor *const compositor,
+    const int socket,
+    const struct MAT_Matrix *const frame_buffer,
+    const struct MAT_Matrix *const z_buffer)
+{
+    assert(frame_buffer->rows == compositor->frame_buffer->rows); // LCOV_EXCL_LINE
+    assert(frame_buffer->cols == compositor->frame_buffer->cols); // LCOV_EXCL_LINE
+
+    const size_t number_of_pixels = (size_t)frame_buffer->rows * (size_t)frame_buffer->cols;
+    const struct FrameHeader header = {
+        .magic = MAGIC,
+        .width = (uint32_t)frame_buffer->cols,
+        .height = (uint32_t)frame_buffer->rows
+    };
+
+    for (int y = 0; y < frame_buffer->rows; ++y)
+    {
+        for (int x = 0; x < frame_buffer->cols; ++x)
+        {
+            const int index = y * frame_buffer->cols + x;
+
+            compositor->colors[index] = (unsigned char)MAT_get_element(frame_buffer, y, x);
+            compositor->depths[index] = (float)MAT_get_element(z_buffer, y, x);
+        }
+    }
+
+    return (send_all(socket, &header, sizeof(header)) != 0) ||
+        (send_all(socket, compositor->colors, number_of_pixels * sizeof(*compositor->colors)) != 0) ||
+        (send_all(socket, compositor->depths, number_of_pixels * sizeof(*compositor->depths)) != 0);
+}
+
+int COMP_composite(
+    struct COMP_Compositor *const compositor,
+    const int *const sockets,
+    const int number_of_sockets)
+{
+    struct MAT_Matrix *const frame_buffer = compositor->frame_buffer;
+    struct MAT_Matrix *const z_buffer = compositor->z_buffer;
+
+    MAT_set_all_elements(frame_buffer, (double)' ');
+    MAT_set_all_elements(z_buffer, INFINITY);
+
+    for (int i = 0; i < number_of_sockets; ++i)
+    {
+        if (receive_frame(compositor, sockets[i]) != 0)
+        {
+            return -1;
+        }
+
+        for (int y = 0; y < frame_buffer->rows; ++y)
+        {
+            for (int x = 0; x < frame_buffer->cols; ++x)
+            {
+                const int index = y * frame_buffer->cols + x;
+                const double depth = compositor->depths[index];
+
+                if (depth < MAT_get_element(z_buffer, y, x))
+                {
+                    MAT_set_element(z_buffer, y, x, depth);
+                    MAT_set_element(frame_buffer, y, x, compositor->colors[index]);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+const struct MAT_Matrix * COMP_get_frame_buffer(
+    const struct COMP_Compositor *const compositor)
+{
+    return compositor->frame_buffer;
+}
+
+const struct MAT_Matrix * COMP_get_z_buffer(
+    const struct COMP_Compositor *const compositor)
+{
+    return compositor->z_buffer;
+}
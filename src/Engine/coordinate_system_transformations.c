@@ -78,6 +78,19 @@ void CST_world_coordinate_to_image_coordinate(
 struct MAT_Matrix * CST_get_extrinsic_rotation_matrix(
     const struct CST_Rotation3D *const rotation)
 {
+    struct MAT_Matrix *const rotation_matrix = MAT_alloc(3, 3);
+
+    CST_set_extrinsic_rotation_matrix(rotation, rotation_matrix);
+
+    return rotation_matrix;
+}
+
+void CST_set_extrinsic_rotation_matrix(
+    const struct CST_Rotation3D *const rotation,
+    struct MAT_Matrix *const rotation_matrix)
+{
+    assert((rotation_matrix->rows == 3) && (rotation_matrix->cols == 3)); // LCOV_EXCL_LINE
+
     const double a = rotation->pitch; /* x */
     const double b = rotation->yaw; /* y */
     const double g = rotation->roll; /* z */
@@ -118,13 +131,13 @@ struct MAT_Matrix * CST_get_extrinsic_rotation_matrix(
         .data = &roll_data[0][0],
     };
 
-    struct MAT_Matrix *const temp = MAT_alloc(3, 3);
-    struct MAT_Matrix *const output = MAT_alloc(3, 3);
-
-    MAT_matrix_matrix_multiplication(&roll, &yaw, temp);
-    MAT_matrix_matrix_multiplication(temp, &pitch, output);
-
-    MAT_free(temp);
+    double temp_data[3][3];
+    struct MAT_Matrix temp = {
+        .rows = 3,
+        .cols = 3,
+        .data = &temp_data[0][0],
+    };
 
-    return output;
+    MAT_matrix_matrix_multiplication(&roll, &yaw, &temp);
+    MAT_matrix_matrix_multiplication(&temp, &pitch, rotation_matrix);
 }
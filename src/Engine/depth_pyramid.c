@@ -0,0 +1,261 @@
+/**
+ * \file
+ * \brief Depth pyramid implementation
+ */
+#include "depth_pyramid.h"
+
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define BASE_TILE_SIZE (4) /* Number of z buffer cells along each side of a cell in the finest level */
+#define MAX_NUMBER_OF_LEVELS (24)
+#define MAX_TILES_PER_AXIS (4) /* A query uses the finest level with at most this many cells per axis */
+
+/**
+ * \brief One level of the pyramid
+ */
+struct Level
+{
+    double *depths; /**< The maximum depth of each cell, row major */
+    int width; /**< Number of cells in the x direction */
+    int height; /**< Number of cells in the y direction */
+};
+
+/**
+ * \brief Depth pyramid
+ */
+struct DPYR_DepthPyramid
+{
+    /**
+     * The levels, the cells of each level are twice as large (in each direction) as the cells of
+     * the previous level
+     */
+    struct Level levels[MAX_NUMBER_OF_LEVELS];
+    int number_of_levels; /**< Number of used levels, the last level has a single cell */
+    int width; /**< The width of the z buffer */
+    int height; /**< The height of the z buffer */
+};
+
+struct DPYR_DepthPyramid * DPYR_create(
+    const int width,
+    const int height)
+{
+    assert((width > 0) && (height > 0)); // LCOV_EXCL_LINE
+
+    struct DPYR_DepthPyramid *const pyramid = calloc(1, sizeof(*pyramid));
+
+    pyramid->width = width;
+    pyramid->height = height;
+
+    int level_width = (width + BASE_TILE_SIZE - 1) / BASE_TILE_SIZE;
+    int level_height = (height + BASE_TILE_SIZE - 1) / BASE_TILE_SIZE;
+
+    for (;;)
+    {
+        assert(pyramid->number_of_levels < MAX_NUMBER_OF_LEVELS); // LCOV_EXCL_LINE
+
+        struct Level *const level = &pyramid->levels[pyramid->number_of_levels++];
+
+        level->width = level_width;
+        level->height = level_height;
+        level->depths = calloc((size_t)level_width * (size_t)level_height, sizeof(*level->depths));
+
+        if ((level_width == 1) && (level_height == 1))
+        {
+            break;
+        }
+
+        level_width = (level_width + 1) / 2;
+        level_height = (level_height + 1) / 2;
+    }
+
+    return pyramid;
+}
+
+void DPYR_destroy(
+    struct DPYR_DepthPyramid *const pyramid)
+{
+    for (int i = 0; i < pyramid->number_of_levels; ++i)
+    {
+        free(pyramid->levels[i].depths);
+    }
+
+    free(pyramid);
+}
+
+/**
+ * \brief Get the maximum depth of the z buffer cells covered by a cell of the finest level
+ *
+ * \param[in] pyramid The pyramid
+ * \param[in] z_buffer The z buffer
+ * \param[in] cell_x The column of the cell
+ * \param[in] cell_y The row of the cell
+ *
+ * \return The maximum depth
+ */
+static double get_base_cell_depth(
+    const struct DPYR_DepthPyramid *const pyramid,
+    const struct MAT_Matrix *const z_buffer,
+    const int cell_x,
+    const int cell_y)
+{
+    const int x_begin = cell_x * BASE_TILE_SIZE;
+    const int y_begin = cell_y * BASE_TILE_SIZE;
+    const int x_end = (pyramid->width - x_begin < BASE_TILE_SIZE) ? pyramid->width : x_begin + BASE_TILE_SIZE;
+    const int y_end = (pyramid->height - y_begin < BASE_TILE_SIZE) ? pyramid->height : y_begin + BASE_TILE_SIZE;
+    double depth = -INFINITY;
+
+    for (int y = y_begin; y < y_end; ++y)
+    {
+        for (int x = x_begin; x < x_end; ++x)
+        {
+            depth = fmax(depth, MAT_get_element(z_buffer, y, x));
+        }
+    }
+
+    return depth;
+}
+
+/**
+ * \brief Get the maximum depth of the cells of the previous (finer) level covered by a cell
+ *
+ * \param[in] finer The previous level
+ * \param[in] cell_x The column of the cell
+ * \param[in] cell_y The row of the cell
+ *
+ * \return The maximum depth
+ */
+static double get_cell_depth(
+    const struct Level *const finer,
+    const int cell_x,
+    const int cell_y)
+{
+    const int x = 2 * cell_x;
+    const int y = 2 * cell_y;
+    const int has_right = (finer->width - x) > 1;
+    const int has_below = (finer->height - y) > 1;
+    const double *const row = &finer->depths[y * finer->width];
+    double depth = row[x];
+
+    if (has_right)
+    {
+        depth = fmax(depth, row[x + 1]);
+    }
+
+    if (has_below)
+    {
+        const double *const next_row = &row[finer->width];
+
+        depth = fmax(depth, next_row[x]);
+        depth = has_right ? fmax(depth, next_row[x + 1]) : depth;
+    }
+
+    return depth;
+}
+
+void DPYR_update(
+    struct DPYR_DepthPyramid *const pyramid,
+    const struct MAT_Matrix *const z_buffer)
+{
+    const struct DPYR_Rectangle screen = {
+        .x_begin = 0,
+        .x_end = pyramid->width - 1,
+        .y_begin = 0,
+        .y_end = pyramid->height - 1
+    };
+
+    DPYR_update_rectangle(pyramid, z_buffer, &screen);
+}
+
+void DPYR_update_rectangle(
+    struct DPYR_DepthPyramid *const pyramid,
+    const struct MAT_Matrix *const z_buffer,
+    const struct DPYR_Rectangle *const rectangle)
+{
+    assert((z_buffer->cols == pyramid->width) && (z_buffer->rows == pyramid->height)); // LCOV_EXCL_LINE
+    assert((rectangle->x_begin >= 0) && (rectangle->x_end < pyramid->width)); // LCOV_EXCL_LINE
+    assert((rectangle->y_begin >= 0) && (rectangle->y_end < pyramid->height)); // LCOV_EXCL_LINE
+    assert((rectangle->x_begin <= rectangle->x_end) && (rectangle->y_begin <= rectangle->y_end)); // LCOV_EXCL_LINE
+
+    /* The cells covering the rectangle in the current level, each cell of a level is the maximum of
+     * the cells it covers in the previous (finer) level. */
+    int x_begin = rectangle->x_begin / BASE_TILE_SIZE;
+    int x_end = rectangle->x_end / BASE_TILE_SIZE;
+    int y_begin = rectangle->y_begin / BASE_TILE_SIZE;
+    int y_end = rectangle->y_end / BASE_TILE_SIZE;
+    const struct Level *const base = &pyramid->levels[0];
+
+    for (int y = y_begin; y <= y_end; ++y)
+    {
+        for (int x = x_begin; x <= x_end; ++x)
+        {
+            base->depths[(y * base->width) + x] = get_base_cell_depth(pyramid, z_buffer, x, y);
+        }
+    }
+
+    for (int i = 1; i < pyramid->number_of_levels; ++i)
+    {
+        const struct Level *const level = &pyramid->levels[i];
+
+        x_begin /= 2;
+        x_end /= 2;
+        y_begin /= 2;
+        y_end /= 2;
+
+        for (int y = y_begin; y <= y_end; ++y)
+        {
+            for (int x = x_begin; x <= x_end; ++x)
+            {
+                level->depths[(y * level->width) + x] = get_cell_depth(&pyramid->levels[i - 1], x, y);
+            }
+        }
+    }
+}
+
+int DPYR_is_hidden(
+    const struct DPYR_DepthPyramid *const pyramid,
+    const struct DPYR_Rectangle *const rectangle,
+    const double depth)
+{
+    assert((rectangle->x_begin >= 0) && (rectangle->x_end < pyramid->width)); // LCOV_EXCL_LINE
+    assert((rectangle->y_begin >= 0) && (rectangle->y_end < pyramid->height)); // LCOV_EXCL_LINE
+    assert((rectangle->x_begin <= rectangle->x_end) && (rectangle->y_begin <= rectangle->y_end)); // LCOV_EXCL_LINE
+
+    /* Find the finest level where the rectangle covers only a few cells. */
+    int level_index = 0;
+    int tile_size = BASE_TILE_SIZE;
+
+    for (int i = 0; i < pyramid->number_of_levels; ++i)
+    {
+        level_index = i;
+        tile_size = BASE_TILE_SIZE << i;
+
+        const unsigned int x_tiles =
+            (unsigned int)(rectangle->x_end / tile_size) - (unsigned int)(rectangle->x_begin / tile_size);
+        const unsigned int y_tiles =
+            (unsigned int)(rectangle->y_end / tile_size) - (unsigned int)(rectangle->y_begin / tile_size);
+
+        if ((x_tiles < MAX_TILES_PER_AXIS) && (y_tiles < MAX_TILES_PER_AXIS))
+        {
+            break;
+        }
+    }
+
+    const struct Level *const level = &pyramid->levels[level_index];
+
+    for (int y = rectangle->y_begin / tile_size; y <= rectangle->y_end / tile_size; ++y)
+    {
+        for (int x = rectangle->x_begin / tile_size; x <= rectangle->x_end / tile_size; ++x)
+        {
+            if (level->depths[(y * level->width) + x] > depth)
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
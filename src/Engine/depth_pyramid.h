@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \brief Depth pyramid interface
+ *
+ * A hierarchical z buffer, i.e. a pyramid of coarse versions of the z buffer where each cell holds
+ * the maximum (farthest) depth of the z buffer cells it covers. It makes it possible to decide if
+ * something is hidden behind what is already drawn by checking a few cells instead of every z buffer
+ * cell it covers.
+ */
+#ifndef ENGINE_DEPTHPYRAMID_H
+#define ENGINE_DEPTHPYRAMID_H
+
+struct MAT_Matrix;
+
+struct DPYR_DepthPyramid;
+
+/**
+ * \brief A rectangle of z buffer cells, both the beginning and end are included
+ */
+struct DPYR_Rectangle
+{
+    int x_begin; /**< The first column */
+    int x_end; /**< The last column */
+    int y_begin; /**< The first row */
+    int y_end; /**< The last row */
+};
+
+/**
+ * \brief Create a depth pyramid
+ *
+ * \param[in] width The width of the z buffer
+ * \param[in] height The height of the z buffer
+ *
+ * \return Depth pyramid, must be updated with DPYR_update() before it is used
+ */
+struct DPYR_DepthPyramid * DPYR_create(
+    int width,
+    int height);
+
+/**
+ * \brief Destroy a depth pyramid
+ *
+ * \param[in] pyramid The pyramid to destroy, do not use it anymore
+ */
+void DPYR_destroy(
+    struct DPYR_DepthPyramid *pyramid);
+
+/**
+ * \brief Rebuild the pyramid from a z buffer
+ *
+ * \param[in,out] pyramid The pyramid
+ * \param[in] z_buffer The z buffer, same size as the pyramid was created with
+ */
+void DPYR_update(
+    struct DPYR_DepthPyramid *pyramid,
+    const struct MAT_Matrix *z_buffer);
+
+/**
+ * \brief Update the part of the pyramid covering a rectangle of the z buffer
+ *
+ * Only the cells covering the rectangle are recomputed, in every level. Use it instead of
+ * DPYR_update() when only a part of the z buffer has changed since the pyramid was updated.
+ *
+ * \param[in,out] pyramid The pyramid
+ * \param[in] z_buffer The z buffer, same size as the pyramid was created with
+ * \param[in] rectangle The z buffer cells that have changed, within the z buffer and not empty
+ */
+void DPYR_update_rectangle(
+    struct DPYR_DepthPyramid *pyramid,
+    const struct MAT_Matrix *z_buffer,
+    const struct DPYR_Rectangle *rectangle);
+
+/**
+ * \brief Check if something is hidden behind the z buffer
+ *
+ * The check is conservative, i.e. it may report something as visible even though it is hidden but
+ * never the other way around.
+ *
+ * \param[in] pyramid The pyramid
+ * \param[in] rectangle The cells covered by the thing to check, within the z buffer
+ * \param[in] depth The nearest depth of the thing to check
+ *
+ * \return Non-zero if all cells in the rectangle are closer than the depth
+ */
+int DPYR_is_hidden(
+    const struct DPYR_DepthPyramid *pyramid,
+    const struct DPYR_Rectangle *rectangle,
+    double depth);
+
+#endif /* ENGINE_DEPTHPYRAMID_H */
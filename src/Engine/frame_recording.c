@@ -0,0 +1,561 @@
+/**
+ * \file
+ * \brief Frame recording implementation
+ *
+ * A recording is a file header followed by the frames. Each frame is the time since the previous
+ * frame [us] and the size of the encoded frame [bytes], both as variable length integers (7 bits
+ * per byte, least significant first, the high bit is set in all but the last byte), followed by
+ * the encoded frame. The encoded frame is a sequence of operations on the characters of the
+ * previous frame (all spaces before the first frame), row by row. Each operation starts with a
+ * variable length integer that holds the number of characters shifted left two bits or-ed with the
+ * type of the operation. The characters after the last operation are unchanged.
+ */
+#include <Engine/frame_recording.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAGIC ("GEREC")
+#define VERSION (1U)
+#define BYTE_ORDER_MARK (0x01020304U) /* The header is stored in native byte order */
+#define OPERATION_BITS (2U)
+#define OPERATION_MASK ((1U << OPERATION_BITS) - 1U)
+#define MIN_RUN_LENGTH (3U) /* Shorter runs of the same character are stored as they are */
+#define MAX_VARINT_SIZE (10U) /* Bytes of a 64-bit variable length integer */
+
+/**
+ * \brief Recording file header, located at the beginning of the file
+ */
+struct FileHeader
+{
+    char magic[8]; /**< Identifies the file as a recording */
+    uint32_t version; /**< The version of the file format */
+    uint32_t byte_order_mark; /**< Used to detect files written on a machine with different byte order */
+    uint32_t width; /**< The width of the frames [pixels] */
+    uint32_t height; /**< The height of the frames [pixels] */
+};
+
+/**
+ * \brief Encoding operations
+ */
+enum Operation
+{
+    SKIP = 0, /**< The characters are unchanged */
+    RUN = 1, /**< The characters are the same character, which follows */
+    LITERAL = 2 /**< The characters follow */
+};
+
+/**
+ * \brief Recorder
+ */
+struct FREC_Recorder
+{
+    FILE *file; /**< The recording */
+    int width; /**< The width of the frames [pixels] */
+    int height; /**< The height of the frames [pixels] */
+    size_t length; /**< Number of characters of a frame */
+    char *previous; /**< The characters of the previous frame */
+    char *current; /**< The characters of the current frame */
+    unsigned char *encoded; /**< Buffer for the encoded frame, fits the largest possible encoding */
+    struct timespec start_time; /**< The time of the first frame */
+    unsigned long long previous_time; /**< The time of the previous frame relative to the first [us] */
+    int has_frames; /**< Non-zero if a frame has been recorded */
+};
+
+/**
+ * \brief Player
+ */
+struct FREC_Player
+{
+    FILE *file; /**< The recording */
+    size_t length; /**< Number of characters of a frame */
+    char *characters; /**< The characters of the current frame */
+    unsigned char *encoded; /**< Buffer for the encoded frame, fits the largest possible encoding */
+    struct MAT_Matrix *frame_buffer; /**< The current frame */
+    unsigned long long time; /**< The time of the current frame relative to the first [us] */
+};
+
+/**
+ * \brief Get the largest possible size of an encoded frame
+ *
+ * All operations except skips cover at least one character and store at most one byte per
+ * character, and every skip is followed by another operation.
+ *
+ * \param[in] length Number of characters of a frame
+ *
+ * \return The size [bytes]
+ */
+static size_t get_max_encoded_size(
+    const size_t length)
+{
+    return length * (2U * MAX_VARINT_SIZE + 1U);
+}
+
+/**
+ * \brief Append a variable length integer to a buffer
+ *
+ * \param[in] value The value
+ * \param[in,out] buffer The buffer
+ * \param[in,out] size The size of the buffer [bytes]
+ */
+static void put_varint(
+    unsigned long long value,
+    unsigned char *const buffer,
+    size_t *const size)
+{
+    while (value >= 0x80U)
+    {
+        buffer[(*size)++] = (unsigned char)((value & 0x7FU) | 0x80U);
+        value >>= 7U;
+    }
+
+    buffer[(*size)++] = (unsigned char)value;
+}
+
+/**
+ * \brief Read a variable length integer from a buffer
+ *
+ * \param[in] buffer The buffer
+ * \param[in] size The size of the buffer [bytes]
+ * \param[in,out] offset The offset of the integer in the buffer, the offset after the integer [bytes]
+ * \param[out] value The value
+ *
+ * \return 0 on success a non-zero value if the integer is incomplete or too long
+ */
+static int get_varint(
+    const unsigned char *const buffer,
+    const size_t size,
+    size_t *const offset,
+    unsigned long long *const value)
+{
+    *value = 0U;
+
+    for (unsigned int shift = 0U; (shift < 7U * MAX_VARINT_SIZE) && (*offset < size); shift += 7U)
+    {
+        const unsigned char byte = buffer[(*offset)++];
+
+        *value |= (unsigned long long)(byte & 0x7FU) << shift;
+
+        if ((byte & 0x80U) == 0U)
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Read a variable length integer from a file
+ *
+ * \param[in,out] file The file
+ * \param[out] value The value
+ *
+ * \return 1 on success, 0 at the end of the file and a negative value if the integer is incomplete
+ *         or too long
+ */
+static int read_varint(
+    FILE *const file,
+    unsigned long long *const value)
+{
+    unsigned char buffer[MAX_VARINT_SIZE];
+    size_t size = 0;
+    int byte = getc(file);
+
+    if (byte == EOF)
+    {
+        return 0;
+    }
+
+    buffer[size++] = (unsigned char)byte;
+
+    while (((buffer[size - 1U] & 0x80U) != 0U) && (size < MAX_VARINT_SIZE) && ((byte = getc(file)) != EOF))
+    {
+        buffer[size++] = (unsigned char)byte;
+    }
+
+    size_t offset = 0;
+
+    return (get_varint(buffer, size, &offset, value) == 0) ? 1 : -1;
+}
+
+/**
+ * \brief Check if a run of the same character, long enough to be run-length encoded, starts at a
+ *        character
+ *
+ * \param[in] characters The characters
+ * \param[in] begin The index of the character
+ * \param[in] length Number of characters
+ *
+ * \return Non-zero if a run starts at the character
+ */
+static int is_run(
+    const char *const characters,
+    const size_t begin,
+    const size_t length)
+{
+    if (length - begin < MIN_RUN_LENGTH)
+    {
+        return 0;
+    }
+
+    for (size_t i = 1U; i < MIN_RUN_LENGTH; ++i)
+    {
+        if (characters[begin + i] != characters[begin])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Append an operation to an encoded frame
+ *
+ * \param[in] operation The operation
+ * \param[in] count Number of characters
+ * \param[in] characters The characters of the operation, the first is used by RUN, count are used
+ *                       by LITERAL and none by SKIP
+ * \param[in,out] encoded The encoded frame
+ * \param[in,out] size The size of the encoded frame [bytes]
+ */
+static void put_operation(
+    const enum Operation operation,
+    const size_t count,
+    const char *const characters,
+    unsigned char *const encoded,
+    size_t *const size)
+{
+    put_varint(((unsigned long long)count << OPERATION_BITS) | (unsigned long long)operation, encoded, size);
+
+    switch (operation)
+    {
+        case SKIP:
+            break;
+        case RUN:
+            encoded[(*size)++] = (unsigned char)characters[0];
+            break;
+        case LITERAL:
+            memcpy(&encoded[*size], characters, count);
+            *size += count;
+            break;
+        default: // LCOV_EXCL_LINE
+            assert(0); // LCOV_EXCL_LINE
+    }
+}
+
+/**
+ * \brief Encode a frame as the difference to the previous frame
+ *
+ * \param[in] previous The characters of the previous frame
+ * \param[in] current The characters of the frame
+ * \param[in] length Number of characters
+ * \param[out] encoded The encoded frame, must fit get_max_encoded_size() bytes
+ *
+ * \return The size of the encoded frame [bytes]
+ */
+static size_t encode_frame(
+    const char *const previous,
+    const char *const current,
+    const size_t length,
+    unsigned char *const encoded)
+{
+    size_t size = 0;
+    size_t i = 0;
+
+    while (i < length)
+    {
+        size_t end = i + 1U;
+
+        if (current[i] == previous[i])
+        {
+            while ((end < length) && (current[end] == previous[end]))
+            {
+                ++end;
+            }
+
+            /* Unchanged characters at the end of the frame are implicit */
+            if (end < length)
+            {
+                put_operation(SKIP, end - i, NULL, encoded, &size);
+            }
+        }
+        else if (is_run(current, i, length))
+        {
+            while ((end < length) && (current[end] == current[i]))
+            {
+                ++end;
+            }
+
+            put_operation(RUN, end - i, &current[i], encoded, &size);
+        }
+        else
+        {
+            while ((end < length) && (current[end] != previous[end]) && !is_run(current, end, length))
+            {
+                ++end;
+            }
+
+            put_operation(LITERAL, end - i, &current[i], encoded, &size);
+        }
+
+        i = end;
+    }
+
+    return size;
+}
+
+/**
+ * \brief Apply an encoded frame to the characters of the previous frame
+ *
+ * \param[in] encoded The encoded frame
+ * \param[in] size The size of the encoded frame [bytes]
+ * \param[in] length Number of characters
+ * \param[in,out] characters The characters of the previous frame, the characters of the frame
+ *
+ * \return 0 on success a non-zero value if the encoded frame is corrupt
+ */
+static int decode_frame(
+    const unsigned char *const encoded,
+    const size_t size,
+    const size_t length,
+    char *const characters)
+{
+    size_t offset = 0;
+    size_t i = 0;
+
+    while (offset < size)
+    {
+        unsigned long long operation;
+
+        if (get_varint(encoded, size, &offset, &operation) != 0)
+        {
+            return -1;
+        }
+
+        const unsigned long long count = operation >> OPERATION_BITS;
+
+        if ((count == 0U) || (count > length - i))
+        {
+            return -1;
+        }
+
+        switch ((enum Operation)(operation & OPERATION_MASK))
+        {
+            case SKIP:
+                break;
+            case RUN:
+                if (offset >= size)
+                {
+                    return -1;
+                }
+                memset(&characters[i], encoded[offset++], (size_t)count);
+                break;
+            case LITERAL:
+                if (count > (size - offset))
+                {
+                    return -1;
+                }
+                memcpy(&characters[i], &encoded[offset], (size_t)count);
+                offset += (size_t)count;
+                break;
+            default:
+                return -1;
+        }
+
+        i += (size_t)count;
+    }
+
+    return 0;
+}
+
+struct FREC_Recorder * FREC_create(
+    const char *const path,
+    const int width,
+    const int height)
+{
+    FILE *const file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    struct FileHeader header = {
+        .version = VERSION,
+        .byte_order_mark = BYTE_ORDER_MARK,
+        .width = (uint32_t)width,
+        .height = (uint32_t)height
+    };
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    struct FREC_Recorder *const recorder = calloc(1, sizeof(*recorder));
+
+    recorder->file = file;
+    recorder->width = width;
+    recorder->height = height;
+    recorder->length = (size_t)width * (size_t)height;
+    recorder->previous = malloc(recorder->length);
+    recorder->current = malloc(recorder->length);
+    recorder->encoded = malloc(get_max_encoded_size(recorder->length));
+    memset(recorder->previous, ' ', recorder->length);
+
+    return recorder;
+}
+
+int FREC_destroy(
+    struct FREC_Recorder *const recorder)
+{
+    const int error = fclose(recorder->file) != 0;
+
+    free(recorder->encoded);
+    free(recorder->current);
+    free(recorder->previous);
+    free(recorder);
+
+    return error ? -1 : 0;
+}
+
+int FREC_record_frame(
+    struct FREC_Recorder *const recorder,
+    const struct MAT_Matrix *const frame_buffer)
+{
+    assert((frame_buffer->cols == recorder->width) && (frame_buffer->rows == recorder->height)); // LCOV_EXCL_LINE
+
+    struct timespec current_time;
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+
+    if (!recorder->has_frames)
+    {
+        recorder->start_time = current_time;
+        recorder->has_frames = 1;
+    }
+
+    const long long elapsed_time = (current_time.tv_sec - recorder->start_time.tv_sec) * 1000000LL +
+        (current_time.tv_nsec - recorder->start_time.tv_nsec) / 1000L;
+    const unsigned long long time = (unsigned long long)elapsed_time;
+
+    for (int y = 0; y < frame_buffer->rows; ++y)
+    {
+        for (int x = 0; x < frame_buffer->cols; ++x)
+        {
+            recorder->current[y * frame_buffer->cols + x] = (char)MAT_get_element(frame_buffer, y, x);
+        }
+    }
+
+    unsigned char prefix[2U * MAX_VARINT_SIZE];
+    size_t prefix_size = 0;
+    const size_t size = encode_frame(recorder->previous, recorder->current, recorder->length, recorder->encoded);
+
+    put_varint(time - recorder->previous_time, prefix, &prefix_size);
+    put_varint(size, prefix, &prefix_size);
+
+    recorder->previous_time = time;
+
+    char *const previous = recorder->previous;
+    recorder->previous = recorder->current;
+    recorder->current = previous;
+
+    const int error = (fwrite(prefix, 1, prefix_size, recorder->file) != prefix_size) ||
+        (fwrite(recorder->encoded, 1, size, recorder->file) != size);
+
+    return error ? -1 : 0;
+}
+
+struct FREC_Player * FREC_open(
+    const char *const path)
+{
+    FILE *const file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    struct FileHeader header;
+
+    if ((fread(&header, sizeof(header), 1, file) != 1) ||
+        (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) ||
+        (header.version != VERSION) ||
+        (header.byte_order_mark != BYTE_ORDER_MARK) ||
+        (header.width == 0U) ||
+        (header.height == 0U) ||
+        ((uint64_t)header.width * header.height > (uint64_t)(INT32_MAX / (2 * MAX_VARINT_SIZE + 1))))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    struct FREC_Player *const player = calloc(1, sizeof(*player));
+
+    player->file = file;
+    player->length = (size_t)header.width * header.height;
+    player->characters = malloc(player->length);
+    player->encoded = malloc(get_max_encoded_size(player->length));
+    player->frame_buffer = MAT_alloc((int)header.height, (int)header.width);
+    memset(player->characters, ' ', player->length);
+
+    return player;
+}
+
+void FREC_close(
+    struct FREC_Player *const player)
+{
+    fclose(player->file);
+    MAT_free(player->frame_buffer);
+    free(player->encoded);
+    free(player->characters);
+    free(player);
+}
+
+int FREC_read_frame(
+    struct FREC_Player *const player,
+    const struct MAT_Matrix **const frame_buffer,
+    double *const time)
+{
+    unsigned long long time_step;
+    unsigned long long size;
+    const int status = read_varint(player->file, &time_step);
+
+    if (status <= 0)
+    {
+        return status;
+    }
+
+    if ((read_varint(player->file, &size) != 1) ||
+        (size > get_max_encoded_size(player->length)) ||
+        (fread(player->encoded, 1, (size_t)size, player->file) != size) ||
+        (decode_frame(player->encoded, (size_t)size, player->length, player->characters) != 0))
+    {
+        return -1;
+    }
+
+    struct MAT_Matrix *const frame = player->frame_buffer;
+
+    for (int y = 0; y < frame->rows; ++y)
+    {
+        for (int x = 0; x < frame->cols; ++x)
+        {
+            MAT_set_element(frame, y, x, player->characters[y * frame->cols + x]);
+        }
+    }
+
+    player->time += time_step;
+    *frame_buffer = frame;
+    *time = (double)player->time * 1e-6;
+
+    return 1;
+}
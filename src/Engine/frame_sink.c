@@ -0,0 +1,361 @@
+/**
+ * \file
+ * \brief Frame sink implementation
+ *
+ * The sequence number of each slot works as a sequence lock: the writer sets it to 0 before the
+ * frame is overwritten and to the sequence number of the new frame when the frame is complete. A
+ * reader checks the sequence number before and after reading the frame.
+ */
+#include <Engine/frame_sink.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIC ("GEFRAME")
+#define VERSION (1U)
+#define BYTE_ORDER_MARK (0x01020304U) /* The shared memory is only shared on the same machine */
+#define CACHE_LINE_SIZE (64U)
+#define MAX_NAME_LENGTH (256)
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The sequence numbers must be lock free to be shared between processes");
+
+/**
+ * \brief Header of the shared memory, followed by the slots
+ */
+struct SharedHeader
+{
+    char magic[8]; /**< Identifies the shared memory as a frame sink, written last */
+    uint32_t version; /**< The version of the layout */
+    uint32_t byte_order_mark; /**< Used to detect a writer with different byte order */
+    uint32_t width; /**< The width of the frames [pixels] */
+    uint32_t height; /**< The height of the frames [pixels] */
+    uint32_t number_of_slots; /**< The number of slots */
+    uint32_t has_depths; /**< Non-zero if the slots contain depths */
+    uint64_t slot_size; /**< The size of a slot [bytes] */
+    uint64_t depths_offset; /**< The offset of the depths from the beginning of a slot [bytes] */
+    /** The sequence number of the latest frame, on its own cache line as it is written each frame */
+    _Alignas(CACHE_LINE_SIZE) atomic_ullong latest_sequence;
+    atomic_int is_closed; /**< Non-zero when the writer has destroyed the frame sink */
+};
+
+/**
+ * \brief Header of a slot, followed by the characters and the depths of the frame
+ */
+struct SlotHeader
+{
+    /** The sequence number of the frame in the slot, 0 if the slot is empty or being written */
+    _Alignas(CACHE_LINE_SIZE) atomic_ullong sequence;
+};
+
+/**
+ * \brief Frame sink, the writer side
+ */
+struct FSINK_FrameSink
+{
+    char name[MAX_NAME_LENGTH]; /**< The name of the shared memory object */
+    unsigned char *data; /**< The mapped shared memory */
+    size_t size; /**< The size of the shared memory [bytes] */
+    unsigned long long sequence; /**< The sequence number of the latest written frame */
+};
+
+/**
+ * \brief Frame sink reader
+ */
+struct FSINK_Reader
+{
+    unsigned char *data; /**< The mapped shared memory, read only */
+    size_t size; /**< The size of the shared memory [bytes] */
+};
+
+/**
+ * \brief Round up a size to the closest multiple of the cache line size
+ *
+ * \param[in] size The size [bytes]
+ *
+ * \return The aligned size [bytes]
+ */
+static uint64_t align_size(
+    const uint64_t size)
+{
+    return ((size + CACHE_LINE_SIZE - 1U) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+}
+
+/**
+ * \brief Compute the layout of the shared memory
+ *
+ * \param[in,out] header The header, the size fields are set from the others
+ *
+ * \return The size of the shared memory [bytes]
+ */
+static uint64_t compute_layout(
+    struct SharedHeader *const header)
+{
+    const uint64_t number_of_pixels = (uint64_t)header->width * header->height;
+
+    header->depths_offset = align_size(sizeof(struct SlotHeader) + number_of_pixels);
+    header->slot_size =
+        header->depths_offset + (header->has_depths ? align_size(number_of_pixels * sizeof(float)) : 0U);
+
+    return align_size(sizeof(struct SharedHeader)) + header->number_of_slots * header->slot_size;
+}
+
+/**
+ * \brief Get the offset of the slot of a frame
+ *
+ * \param[in] header The header of the shared memory
+ * \param[in] sequence The sequence number of the frame
+ *
+ * \return The offset of the slot from the beginning of the shared memory [bytes]
+ */
+static size_t get_slot_offset(
+    const struct SharedHeader *const header,
+    const unsigned long long sequence)
+{
+    const uint64_t index = sequence % header->number_of_slots;
+
+    return (size_t)(align_size(sizeof(*header)) + index * header->slot_size);
+}
+
+struct FSINK_FrameSink * FSINK_create(
+    const char *const name,
+    const int width,
+    const int height,
+    const int number_of_slots,
+    const int with_depths)
+{
+    assert((width > 0) && (height > 0) && (number_of_slots > 0)); // LCOV_EXCL_LINE
+
+    struct SharedHeader layout = {
+        .width = (uint32_t)width,
+        .height = (uint32_t)height,
+        .number_of_slots = (uint32_t)number_of_slots,
+        .has_depths = with_depths != 0
+    };
+    const size_t size = (size_t)compute_layout(&layout);
+    struct FSINK_FrameSink *const sink = calloc(1, sizeof(*sink));
+    const int length = snprintf(sink->name, sizeof(sink->name), "%s", name);
+    const int fd = ((length < 0) || ((size_t)length >= sizeof(sink->name))) ?
+        -1 : shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+
+    if (fd < 0)
+    {
+        free(sink);
+        return NULL;
+    }
+
+    void *const data = (ftruncate(fd, (off_t)size) == 0) ?
+        mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+
+    close(fd); /* The mapping keeps a reference to the shared memory object. */
+
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(name);
+        free(sink);
+        return NULL;
+    }
+
+    sink->data = data;
+    sink->size = size;
+
+    /* The shared memory is zero filled, i.e. all slots are empty */
+    struct SharedHeader *const header = data;
+    header->version = VERSION;
+    header->byte_order_mark = BYTE_ORDER_MARK;
+    header->width = layout.width;
+    header->height = layout.height;
+    header->number_of_slots = layout.number_of_slots;
+    header->has_depths = layout.has_depths;
+    header->slot_size = layout.slot_size;
+    header->depths_offset = layout.depths_offset;
+
+    /* The magic is written last, a reader that sees it sees a complete header */
+    atomic_thread_fence(memory_order_release);
+    memcpy(header->magic, MAGIC, sizeof(MAGIC));
+
+    return sink;
+}
+
+void FSINK_destroy(
+    struct FSINK_FrameSink *const sink)
+{
+    struct SharedHeader *const header = (void *)sink->data;
+
+    atomic_store_explicit(&header->is_closed, 1, memory_order_release);
+    munmap(sink->data, sink->size);
+    shm_unlink(sink->name);
+    free(sink);
+}
+
+void FSINK_write_frame(
+    struct FSINK_FrameSink *const sink,
+    const struct MAT_Matrix *const frame_buffer,
+    const struct MAT_Matrix *const z_buffer)
+{
+    struct SharedHeader *const header = (void *)sink->data;
+
+    assert(frame_buffer->cols == (int)header->width); // LCOV_EXCL_LINE
+    assert(frame_buffer->rows == (int)header->height); // LCOV_EXCL_LINE
+
+    const unsigned long long sequence = ++sink->sequence;
+    unsigned char *const slot_data = &sink->data[get_slot_offset(header, sequence)];
+    struct SlotHeader *const slot = (void *)slot_data;
+    char *const characters = (char *)&slot_data[sizeof(*slot)];
+    float *const depths = (void *)&slot_data[header->depths_offset];
+
+    /* Readers of the previous frame in the slot see that it is being overwritten */
+    atomic_store_explicit(&slot->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (int y = 0; y < frame_buffer->rows; ++y)
+    {
+        for (int x = 0; x < frame_buffer->cols; ++x)
+        {
+            characters[y * frame_buffer->cols + x] = (char)MAT_get_element(frame_buffer, y, x);
+        }
+    }
+
+    if (header->has_depths)
+    {
+        for (int y = 0; y < z_buffer->rows; ++y)
+        {
+            for (int x = 0; x < z_buffer->cols; ++x)
+            {
+                depths[y * z_buffer->cols + x] = (float)MAT_get_element(z_buffer, y, x);
+            }
+        }
+    }
+
+    atomic_store_explicit(&slot->sequence, sequence, memory_order_release);
+    atomic_store_explicit(&header->latest_sequence, sequence, memory_order_release);
+}
+
+struct FSINK_Reader * FSINK_open(
+    const char *const name)
+{
+    const int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat status;
+
+    if ((fstat(fd, &status) != 0) || (status.st_size < (off_t)sizeof(struct SharedHeader)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t size = (size_t)status.st_size;
+    unsigned char *const data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    close(fd); /* The mapping keeps a reference to the shared memory object. */
+
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    const struct SharedHeader *const header = (const void *)data;
+    int is_valid = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0;
+
+    atomic_thread_fence(memory_order_acquire);
+
+    struct SharedHeader layout = {
+        .width = header->width,
+        .height = header->height,
+        .number_of_slots = header->number_of_slots,
+        .has_depths = header->has_depths
+    };
+
+    is_valid = is_valid &&
+        (header->version == VERSION) &&
+        (header->byte_order_mark == BYTE_ORDER_MARK) &&
+        (header->number_of_slots > 0U) &&
+        (compute_layout(&layout) == size) &&
+        (layout.slot_size == header->slot_size) &&
+        (layout.depths_offset == header->depths_offset);
+
+    if (!is_valid)
+    {
+        munmap(data, size);
+        return NULL;
+    }
+
+    struct FSINK_Reader *const reader = calloc(1, sizeof(*reader));
+
+    reader->data = data;
+    reader->size = size;
+
+    return reader;
+}
+
+void FSINK_close(
+    struct FSINK_Reader *const reader)
+{
+    munmap(reader->data, reader->size);
+    free(reader);
+}
+
+unsigned long long FSINK_get_latest_sequence(
+    const struct FSINK_Reader *const reader)
+{
+    const struct SharedHeader *const header = (const void *)reader->data;
+
+    return atomic_load_explicit(&header->latest_sequence, memory_order_acquire);
+}
+
+int FSINK_is_closed(
+    const struct FSINK_Reader *const reader)
+{
+    const struct SharedHeader *const header = (const void *)reader->data;
+
+    return atomic_load_explicit(&header->is_closed, memory_order_acquire);
+}
+
+int FSINK_get_frame(
+    const struct FSINK_Reader *const reader,
+    const unsigned long long sequence,
+    struct FSINK_Frame *const frame)
+{
+    const struct SharedHeader *const header = (const void *)reader->data;
+    const unsigned char *const slot_data = &reader->data[get_slot_offset(header, sequence)];
+    const struct SlotHeader *const slot = (const void *)slot_data;
+
+    if ((sequence == 0U) || (atomic_load_explicit(&slot->sequence, memory_order_acquire) != sequence))
+    {
+        return 0;
+    }
+
+    frame->sequence = sequence;
+    frame->width = (int)header->width;
+    frame->height = (int)header->height;
+    frame->characters = (const char *)&slot_data[sizeof(*slot)];
+    frame->depths = header->has_depths ? (const void *)&slot_data[header->depths_offset] : NULL;
+
+    return 1;
+}
+
+int FSINK_is_valid(
+    const struct FSINK_Reader *const reader,
+    const struct FSINK_Frame *const frame)
+{
+    const struct SharedHeader *const header = (const void *)reader->data;
+    const struct SlotHeader *const slot = (const void *)&reader->data[get_slot_offset(header, frame->sequence)];
+
+    /* Orders the reads of the frame before the read of the sequence number */
+    atomic_thread_fence(memory_order_acquire);
+
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == frame->sequence;
+}
@@ -38,7 +38,7 @@ void SYNC_destroy(
     free(frame_synchronizer);
 }
 
-void SYNC_sync(
+double SYNC_sync(
     struct SYNC_Frame_Synchronizer *frame_synchronizer)
 {
     struct timeval current_time;
@@ -65,4 +65,6 @@ void SYNC_sync(
     }
 
     gettimeofday(&frame_synchronizer->previous_time, 0);
+
+    return (double)elapsed / (double)frame_synchronizer->delta_time_nsec;
 }
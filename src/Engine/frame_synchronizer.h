@@ -29,8 +29,11 @@ void SYNC_destroy(
  * \brief Sync frames, sleeps until specified frame rate is achieved
  *
  * \param[in] frame_synchronizer The frame synchronizer
+ *
+ * \return The load, i.e. the time since the previous sync (before sleeping) as a fraction of the
+ *         specified frame time
  */
-void SYNC_sync(
+double SYNC_sync(
     struct SYNC_Frame_Synchronizer *frame_synchronizer);
 
 #endif /* ENGINE_FRAMESYNCHRONIZER_H */
@@ -0,0 +1,188 @@
+/**
+ * \file
+ * \brief Image sequence implementation
+ */
+#include <Engine/image_sequence.h>
+#include <Engine/renderer.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PATH_LENGTH (4096)
+#define MAX_HEADER_LENGTH (32) /* "P5\n<width> <height>\n255\n" */
+#define MAX_GRAY (255)
+
+/**
+ * \brief Image sequence writer
+ */
+struct IMGS_Writer
+{
+    char *directory; /**< The directory the images are written to */
+    enum IMGS_Format format; /**< What is written of each frame */
+    int width; /**< The width of the frames [pixels] */
+    int height; /**< The height of the frames [pixels] */
+    double max_depth; /**< The depth written as the darkest gray */
+    unsigned char *image; /**< Buffer for the image, header included */
+    size_t header_size; /**< The size of the header of the image [bytes] */
+    size_t image_size; /**< The size of the image, header included [bytes] */
+};
+
+/**
+ * \brief Convert a depth to a gray level
+ *
+ * \param[in] depth The depth
+ * \param[in] max_depth The depth of the darkest gray
+ *
+ * \return The gray level, 0 (black) if the depth is farther than the max depth, e.g. infinite
+ */
+static unsigned char convert_depth_to_gray(
+    const double depth,
+    const double max_depth)
+{
+    if (!(depth <= max_depth))
+    {
+        return 0U;
+    }
+
+    return (unsigned char)lround(1.0 + (MAX_GRAY - 1.0) * fmax(1.0 - depth / max_depth, 0.0));
+}
+
+/**
+ * \brief Convert a pixel color to a gray level
+ *
+ * \param[in] color The pixel color
+ *
+ * \return The gray level, 0 (black) if the color is not an illumination level
+ */
+static unsigned char convert_color_to_gray(
+    const char color)
+{
+    const double illumination = REND_get_illumination(color);
+
+    return (illumination < 0.0) ? 0U : (unsigned char)lround(MAX_GRAY * illumination);
+}
+
+/**
+ * \brief Convert a frame to the pixels of the image
+ *
+ * \param[in] writer The writer
+ * \param[in] frame_buffer The frame buffer
+ * \param[in] z_buffer The z buffer
+ * \param[out] pixels The pixels, row by row
+ */
+static void convert_frame(
+    const struct IMGS_Writer *const writer,
+    const struct MAT_Matrix *const frame_buffer,
+    const struct MAT_Matrix *const z_buffer,
+    unsigned char *const pixels)
+{
+    unsigned char *pixel = pixels;
+
+    for (int y = 0; y < writer->height; ++y)
+    {
+        for (int x = 0; x < writer->width; ++x)
+        {
+            switch (writer->format)
+            {
+                case IMGS_DEPTH:
+                    *pixel++ = convert_depth_to_gray(MAT_get_element(z_buffer, y, x), writer->max_depth);
+                    break;
+                case IMGS_ILLUMINATION:
+                    *pixel++ = convert_color_to_gray((char)MAT_get_element(frame_buffer, y, x));
+                    break;
+                case IMGS_TEXT:
+                    *pixel++ = (unsigned char)MAT_get_element(frame_buffer, y, x);
+                    break;
+                default: // LCOV_EXCL_LINE
+                    assert(0); // LCOV_EXCL_LINE
+            }
+        }
+
+        if (writer->format == IMGS_TEXT)
+        {
+            *pixel++ = '\n';
+        }
+    }
+}
+
+struct IMGS_Writer * IMGS_create(
+    const char *const directory,
+    const enum IMGS_Format format,
+    const int width,
+    const int height,
+    const double max_depth)
+{
+    assert((width > 0) && (height > 0)); // LCOV_EXCL_LINE
+    assert(max_depth > 0.0); // LCOV_EXCL_LINE
+
+    struct IMGS_Writer *const writer = calloc(1, sizeof(*writer));
+    char header[MAX_HEADER_LENGTH] = "";
+    size_t pixels_size = (size_t)width * (size_t)height;
+
+    if (format == IMGS_TEXT)
+    {
+        pixels_size += (size_t)height;
+    }
+    else
+    {
+        snprintf(header, sizeof(header), "P5\n%d %d\n%d\n", width, height, MAX_GRAY);
+    }
+
+    writer->directory = malloc(strlen(directory) + 1U);
+    strcpy(writer->directory, directory);
+    writer->format = format;
+    writer->width = width;
+    writer->height = height;
+    writer->max_depth = max_depth;
+    writer->header_size = strlen(header);
+    writer->image_size = writer->header_size + pixels_size;
+    writer->image = malloc(writer->image_size);
+    memcpy(writer->image, header, writer->header_size);
+
+    return writer;
+}
+
+void IMGS_destroy(
+    struct IMGS_Writer *const writer)
+{
+    free(writer->image);
+    free(writer->directory);
+    free(writer);
+}
+
+int IMGS_write_frame(
+    struct IMGS_Writer *const writer,
+    const int index,
+    const struct MAT_Matrix *const frame_buffer,
+    const struct MAT_Matrix *const z_buffer)
+{
+    assert((frame_buffer->cols == writer->width) && (frame_buffer->rows == writer->height)); // LCOV_EXCL_LINE
+    assert((z_buffer->cols == writer->width) && (z_buffer->rows == writer->height)); // LCOV_EXCL_LINE
+
+    char path[MAX_PATH_LENGTH];
+    const char *const extension = (writer->format == IMGS_TEXT) ? "txt" : "pgm";
+    const int length = snprintf(path, sizeof(path), "%s/frame_%06d.%s", writer->directory, index, extension);
+
+    if ((length < 0) || ((size_t)length >= sizeof(path)))
+    {
+        return -1;
+    }
+
+    convert_frame(writer, frame_buffer, z_buffer, &writer->image[writer->header_size]);
+
+    FILE *const file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    /* The image is complete in memory, it is written directly without copying it to the buffer of the file */
+    const int is_written = fwrite(writer->image, 1, writer->image_size, file) == writer->image_size;
+
+    return ((fclose(file) == 0) && is_written) ? 0 : -1;
+}
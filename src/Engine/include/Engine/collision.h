@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief Collision detection interface
+ *
+ * Broad phase collision detection, i.e. finding the candidate pairs of bodies that may collide
+ * without checking all pairs. Each body is bounded by a sphere and two bodies are a candidate pair
+ * if the axis aligned bounding boxes of their spheres overlap. The candidate pairs are found either
+ * with a uniform grid spatial hash, built in linear time, or by sweep and prune along the x-axis.
+ * Both give the same pairs, the spatial hash scales better when the bodies have similar sizes and
+ * sweep and prune when the sizes vary a lot.
+ */
+#ifndef ENGINE_COLLISION_H
+#define ENGINE_COLLISION_H
+
+#include <Base/coordinates.h>
+
+struct OBJ_BoundingBox;
+
+struct COLL_BroadPhase;
+
+/**
+ * \brief A body bounded by a sphere
+ */
+struct COLL_Body
+{
+    struct COORD_Coordinate3D position; /**< The center of the bounding sphere */
+    double radius; /**< The radius of the bounding sphere */
+};
+
+/**
+ * \brief A candidate pair of bodies, the indices of the bodies with first < second
+ */
+struct COLL_Pair
+{
+    int first; /**< The first body */
+    int second; /**< The second body */
+};
+
+/**
+ * \brief Get the radius of a sphere around the origin of an object that encloses the object in
+ *        any rotation
+ *
+ * \param[in] bounds The bounding box of the object, see struct OBJ_Object
+ *
+ * \return The radius
+ */
+double COLL_get_bounding_radius(
+    const struct OBJ_BoundingBox *bounds);
+
+/**
+ * \brief Create a broad phase, keeps the buffers used to find pairs between the calls
+ *
+ * \return Broad phase
+ */
+struct COLL_BroadPhase * COLL_create(void);
+
+/**
+ * \brief Destroy a broad phase
+ *
+ * \param[in] broad_phase The broad phase to destroy, do not use it anymore
+ */
+void COLL_destroy(
+    struct COLL_BroadPhase *broad_phase);
+
+/**
+ * \brief Find the candidate pairs with a uniform grid spatial hash
+ *
+ * The cells are as large as the largest bounding box, so each body is checked against the bodies
+ * in its own cell and the 26 surrounding cells.
+ *
+ * \param[in,out] broad_phase The broad phase
+ * \param[in] bodies The bodies
+ * \param[in] length The number of bodies
+ * \param[out] pairs The candidate pairs, in no particular order, valid until the broad phase is
+ *                   used again
+ *
+ * \return Number of candidate pairs
+ */
+int COLL_find_pairs_spatial_hash(
+    struct COLL_BroadPhase *broad_phase,
+    const struct COLL_Body *bodies,
+    int length,
+    const struct COLL_Pair **pairs);
+
+/**
+ * \brief Find the candidate pairs by sweep and prune
+ *
+ * The bodies are sorted by the beginning of their bounding boxes along the x-axis, and each body is
+ * checked against the following bodies until they begin after it ends.
+ *
+ * \param[in,out] broad_phase The broad phase
+ * \param[in] bodies The bodies
+ * \param[in] length The number of bodies
+ * \param[out] pairs The candidate pairs, in no particular order, valid until the broad phase is
+ *                   used again
+ *
+ * \return Number of candidate pairs
+ */
+int COLL_find_pairs_sweep_and_prune(
+    struct COLL_BroadPhase *broad_phase,
+    const struct COLL_Body *bodies,
+    int length,
+    const struct COLL_Pair **pairs);
+
+#endif /* ENGINE_COLLISION_H */
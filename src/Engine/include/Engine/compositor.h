@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief Compositor interface
+ *
+ * Sort-last parallel rendering. Each worker renders a disjoint partition of the objects, see
+ * COMP_get_partition(), into its own frame buffer and z buffer and sends both buffers to the
+ * compositor. The compositor merges the frames of all workers by keeping the closest depth of each
+ * pixel, which gives the same frame as rendering all objects in one renderer.
+ *
+ * The frames are sent over connected stream sockets, e.g. Unix domain sockets between processes
+ * on the same machine or TCP sockets between machines. A frame is a small header followed by one
+ * byte (the character) and one float (the depth) per pixel, in native byte order. All workers must
+ * thus have the same byte order as the compositor.
+ */
+#ifndef ENGINE_COMPOSITOR_H
+#define ENGINE_COMPOSITOR_H
+
+struct MAT_Matrix;
+struct REND_Objects;
+
+struct COMP_Compositor;
+
+/**
+ * \brief Get the partition of the objects a worker renders
+ *
+ * The objects, instanced objects and particle systems are each split into contiguous ranges of
+ * (almost) equal length, one per worker. The partition refers to the arrays of the objects, no
+ * objects are copied.
+ *
+ * \param[in] objects All objects
+ * \param[in] worker The index of the worker [0, number_of_workers)
+ * \param[in] number_of_workers The number of workers
+ * \param[out] partition The objects the worker renders
+ */
+void COMP_get_partition(
+    const struct REND_Objects *objects,
+    int worker,
+    int number_of_workers,
+    struct REND_Objects *partition);
+
+/**
+ * \brief Create a compositor, also used by the workers to send their frames
+ *
+ * \param[in] width The width of the frames [pixels]
+ * \param[in] height The height of the frames [pixels]
+ *
+ * \return Compositor
+ */
+struct COMP_Compositor * COMP_create(
+    int width,
+    int height);
+
+/**
+ * \brief Destroy a compositor
+ *
+ * \param[in] compositor The compositor to destroy, do not use it anymore
+ */
+void COMP_destroy(
+    struct COMP_Compositor *compositor);
+
+/**
+ * \brief Send a rendered frame to the compositor, called by the workers
+ *
+ * Blocks until the frame is sent.
+ *
+ * \param[in,out] compositor The compositor of the worker, keeps the send buffer between the frames
+ * \param[in] socket A stream socket connected to the compositor
+ * \param[in] frame_buffer The frame buffer, see REND_get_frame_buffer()
+ * \param[in] z_buffer The z buffer, see REND_get_z_buffer()
+ *
+ * \return 0 on success a non-zero value otherwise, e.g. if the compositor has closed the socket
+ */
+int COMP_send_frame(
+    struct COMP_Compositor *compositor,
+    int socket,
+    const struct MAT_Matrix *frame_buffer,
+    const struct MAT_Matrix *z_buffer);
+
+/**
+ * \brief Receive one frame from each worker and merge them into one frame
+ *
+ * Blocks until all frames are received. A pixel gets the character of the worker with the closest
+ * depth, if several workers have the same depth the first of them is used.
+ *
+ * \param[in,out] compositor The compositor
+ * \param[in] sockets Stream sockets connected to the workers
+ * \param[in] number_of_sockets The number of sockets
+ *
+ * \return 0 on success a non-zero value otherwise, e.g. if a worker has closed its socket or sent
+ *         a frame of another size
+ */
+int COMP_composite(
+    struct COMP_Compositor *compositor,
+    const int *sockets,
+    int number_of_sockets);
+
+/**
+ * \brief Get the frame buffer of the last composited frame
+ *
+ * \param[in] compositor The compositor
+ *
+ * \return The frame buffer, see REND_show_frame()
+ */
+const struct MAT_Matrix * COMP_get_frame_buffer(
+    const struct COMP_Compositor *compositor);
+
+/**
+ * \brief Get the z buffer of the last composited frame
+ *
+ * \param[in] compositor The compositor
+ *
+ * \return The z buffer
+ */
+const struct MAT_Matrix * COMP_get_z_buffer(
+    const struct COMP_Compositor *compositor);
+
+#endif /* ENGINE_COMPOSITOR_H */
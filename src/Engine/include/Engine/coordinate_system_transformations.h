@@ -70,4 +70,17 @@ void CST_world_coordinate_to_image_coordinate(
 struct MAT_Matrix * CST_get_extrinsic_rotation_matrix(
     const struct CST_Rotation3D *rotation);
 
+/**
+ * \brief Set the elements of an existing matrix to the rotation matrix of a given rotation
+ *
+ * Gives the same matrix as CST_get_extrinsic_rotation_matrix() without allocating, e.g. when the
+ * rotation matrices of many instances are computed every frame.
+ *
+ * \param[in] rotation The rotation
+ * \param[out] rotation_matrix The 3x3 rotation matrix
+ */
+void CST_set_extrinsic_rotation_matrix(
+    const struct CST_Rotation3D *rotation,
+    struct MAT_Matrix *rotation_matrix);
+
 #endif /* ENGINE_COORDINATESYSTEMTRANSFORMATIONS_H */
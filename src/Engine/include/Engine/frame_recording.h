@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief Frame recording interface
+ *
+ * Records shown frames to a compact file and plays them back. Each frame is stored as the
+ * difference to the previous frame: runs of unchanged characters are skipped, runs of the same
+ * character are run-length encoded and other characters are stored as they are. Consecutive frames
+ * usually differ in few characters, a recorded frame is thus typically a few hundred bytes. The
+ * time of each frame is recorded too, so that a recording can be played back at its original
+ * speed.
+ */
+#ifndef ENGINE_FRAME_RECORDING_H
+#define ENGINE_FRAME_RECORDING_H
+
+struct MAT_Matrix;
+
+struct FREC_Recorder;
+struct FREC_Player;
+
+/**
+ * \brief Create a recording
+ *
+ * \param[in] path The path of the recording, an existing file is overwritten
+ * \param[in] width The width of the frames [pixels]
+ * \param[in] height The height of the frames [pixels]
+ *
+ * \return Recorder, NULL if the file could not be created
+ */
+struct FREC_Recorder * FREC_create(
+    const char *path,
+    int width,
+    int height);
+
+/**
+ * \brief Finish a recording
+ *
+ * \param[in] recorder The recorder to finish, do not use it anymore
+ *
+ * \return 0 on success a non-zero value if the recording could not be written
+ */
+int FREC_destroy(
+    struct FREC_Recorder *recorder);
+
+/**
+ * \brief Record a frame, the time of the frame is the current time
+ *
+ * The frame is written through a buffer, it is thus not necessarily written to the file before
+ * the recording is finished.
+ *
+ * \param[in,out] recorder The recorder
+ * \param[in] frame_buffer The frame buffer, one character per pixel
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+int FREC_record_frame(
+    struct FREC_Recorder *recorder,
+    const struct MAT_Matrix *frame_buffer);
+
+/**
+ * \brief Open a recording for playback
+ *
+ * \param[in] path The path of the recording
+ *
+ * \return Player, NULL if the file could not be opened or is not a recording
+ */
+struct FREC_Player * FREC_open(
+    const char *path);
+
+/**
+ * \brief Close a recording
+ *
+ * \param[in] player The player to close, do not use it anymore
+ */
+void FREC_close(
+    struct FREC_Player *player);
+
+/**
+ * \brief Read the next frame of a recording
+ *
+ * \param[in,out] player The player
+ * \param[out] frame_buffer The frame buffer, see REND_show_frame(), valid until the next frame is read
+ * \param[out] time The time of the frame relative to the first frame [s]
+ *
+ * \return 1 if a frame was read, 0 at the end of the recording and a negative value if the
+ *         recording is corrupt
+ */
+int FREC_read_frame(
+    struct FREC_Player *player,
+    const struct MAT_Matrix **frame_buffer,
+    double *time);
+
+#endif /* ENGINE_FRAME_RECORDING_H */
@@ -0,0 +1,145 @@
+/**
+ * \file
+ * \brief Frame sink interface
+ *
+ * Publishes rendered frames to other processes, e.g. a recorder or a monitor, through a POSIX
+ * shared memory object. The shared memory holds a ring of slots, each frame is written to the next
+ * slot together with its sequence number. Neither the writer nor the readers make any system calls
+ * or copies per frame: the writer writes the frame directly into the slot and the readers read it
+ * directly from the slot.
+ *
+ * The writer never waits for the readers. A reader that falls behind more than the number of slots
+ * misses (drops) frames, which it detects from the sequence numbers. A frame may also be
+ * overwritten while it is read, the reader must thus check that the frame is still valid after
+ * reading it, see FSINK_is_valid().
+ */
+#ifndef ENGINE_FRAME_SINK_H
+#define ENGINE_FRAME_SINK_H
+
+struct MAT_Matrix;
+
+struct FSINK_FrameSink;
+struct FSINK_Reader;
+
+/**
+ * \brief A frame read from a frame sink, points directly into the shared memory
+ */
+struct FSINK_Frame
+{
+    unsigned long long sequence; /**< The sequence number of the frame, the first frame is 1 */
+    int width; /**< The width of the frame [pixels] */
+    int height; /**< The height of the frame [pixels] */
+    const char *characters; /**< The characters of the frame, row by row */
+    const float *depths; /**< The depths of the frame, row by row, NULL if the sink has no depths */
+};
+
+/**
+ * \brief Create a frame sink, i.e. a shared memory object with a ring of frame slots
+ *
+ * \param[in] name The name of the shared memory object, starts with a '/', see shm_open()
+ * \param[in] width The width of the frames [pixels]
+ * \param[in] height The height of the frames [pixels]
+ * \param[in] number_of_slots The number of frames in the ring
+ * \param[in] with_depths Non-zero if the depths are written together with the characters
+ *
+ * \return Frame sink, NULL if the shared memory object could not be created (e.g. if it already
+ *         exists)
+ */
+struct FSINK_FrameSink * FSINK_create(
+    const char *name,
+    int width,
+    int height,
+    int number_of_slots,
+    int with_depths);
+
+/**
+ * \brief Destroy a frame sink, the readers are told that no more frames will be written
+ *
+ * The shared memory object is removed, readers that have opened it can still read it.
+ *
+ * \param[in] sink The frame sink to destroy, do not use it anymore
+ */
+void FSINK_destroy(
+    struct FSINK_FrameSink *sink);
+
+/**
+ * \brief Write a frame to the next slot of a frame sink
+ *
+ * \param[in,out] sink The frame sink
+ * \param[in] frame_buffer The frame buffer, one character per pixel, see REND_get_frame_buffer()
+ * \param[in] z_buffer The z buffer, see REND_get_z_buffer(), only used if the sink has depths
+ */
+void FSINK_write_frame(
+    struct FSINK_FrameSink *sink,
+    const struct MAT_Matrix *frame_buffer,
+    const struct MAT_Matrix *z_buffer);
+
+/**
+ * \brief Open a frame sink for reading
+ *
+ * \param[in] name The name of the shared memory object, see FSINK_create()
+ *
+ * \return Reader, NULL if the frame sink does not exist or is not a valid frame sink
+ */
+struct FSINK_Reader * FSINK_open(
+    const char *name);
+
+/**
+ * \brief Close a frame sink reader
+ *
+ * \param[in] reader The reader to close, do not use it anymore
+ */
+void FSINK_close(
+    struct FSINK_Reader *reader);
+
+/**
+ * \brief Get the sequence number of the latest written frame
+ *
+ * \param[in] reader The reader
+ *
+ * \return The sequence number, 0 if no frame has been written
+ */
+unsigned long long FSINK_get_latest_sequence(
+    const struct FSINK_Reader *reader);
+
+/**
+ * \brief Check if the writer has destroyed the frame sink, i.e. if no more frames will be written
+ *
+ * \param[in] reader The reader
+ *
+ * \return Non-zero if the frame sink is closed
+ */
+int FSINK_is_closed(
+    const struct FSINK_Reader *reader);
+
+/**
+ * \brief Get a frame from its slot
+ *
+ * \param[in] reader The reader
+ * \param[in] sequence The sequence number of the frame
+ * \param[out] frame The frame, only set if the frame is available
+ *
+ * \return Non-zero if the frame is available, zero if it is not written yet or is already
+ *         overwritten by a later frame (dropped)
+ */
+int FSINK_get_frame(
+    const struct FSINK_Reader *reader,
+    unsigned long long sequence,
+    struct FSINK_Frame *frame);
+
+/**
+ * \brief Check if a frame is still valid, i.e. that the writer has not started to overwrite it
+ *
+ * Must be called after the frame is read, what was read must be discarded if the frame is not
+ * valid anymore.
+ *
+ * \param[in] reader The reader
+ * \param[in] frame The frame, see FSINK_get_frame()
+ *
+ * \return Non-zero if the frame is valid
+ */
+int FSINK_is_valid(
+    const struct FSINK_Reader *reader,
+    const struct FSINK_Frame *frame);
+
+#endif /* ENGINE_FRAME_SINK_H */
@@ -0,0 +1,72 @@
+/**
+ * \file
+ * \brief Image sequence interface
+ *
+ * Writes rendered frames to a directory as a sequence of numbered image files, e.g. for offline
+ * rendering. The depths or the illumination of a frame are written as binary grayscale PGM images,
+ * the characters as plain text. Each image is assembled in memory and written with a single write.
+ */
+#ifndef ENGINE_IMAGE_SEQUENCE_H
+#define ENGINE_IMAGE_SEQUENCE_H
+
+struct MAT_Matrix;
+
+struct IMGS_Writer;
+
+/**
+ * \brief What is written of each frame
+ */
+enum IMGS_Format
+{
+    IMGS_DEPTH, /**< The depths as a PGM image, near is bright and pixels where nothing is drawn are black */
+    IMGS_ILLUMINATION, /**< The illumination of the characters as a PGM image, see REND_get_illumination() */
+    IMGS_TEXT /**< The characters as text, one line per row */
+};
+
+/**
+ * \brief Create an image sequence writer
+ *
+ * \param[in] directory The directory to write the images to, must exist
+ * \param[in] format What is written of each frame
+ * \param[in] width The width of the frames [pixels]
+ * \param[in] height The height of the frames [pixels]
+ * \param[in] max_depth The depth written as the darkest gray for IMGS_DEPTH, farther pixels are black
+ *
+ * \return Writer
+ */
+struct IMGS_Writer * IMGS_create(
+    const char *directory,
+    enum IMGS_Format format,
+    int width,
+    int height,
+    double max_depth);
+
+/**
+ * \brief Destroy an image sequence writer
+ *
+ * \param[in] writer The writer to destroy, do not use it anymore
+ */
+void IMGS_destroy(
+    struct IMGS_Writer *writer);
+
+/**
+ * \brief Write a frame as the image with a given index in the sequence
+ *
+ * The image is named frame_<index>.pgm (frame_<index>.txt for IMGS_TEXT) with the index zero padded
+ * to six digits, an existing image is overwritten. Writers with different indices can write to
+ * the same directory concurrently.
+ *
+ * \param[in,out] writer The writer
+ * \param[in] index The index of the image
+ * \param[in] frame_buffer The frame buffer, one character per pixel
+ * \param[in] z_buffer The z buffer, the depth of each pixel
+ *
+ * \return 0 on success a non-zero value if the image could not be written
+ */
+int IMGS_write_frame(
+    struct IMGS_Writer *writer,
+    int index,
+    const struct MAT_Matrix *frame_buffer,
+    const struct MAT_Matrix *z_buffer);
+
+#endif /* ENGINE_IMAGE_SEQUENCE_H */
@@ -7,6 +7,17 @@
 
 #include <Base/coordinates.h>
 
+#include <stdint.h>
+
+/**
+ * \brief An axis aligned bounding box
+ */
+struct OBJ_BoundingBox
+{
+    struct COORD_Coordinate3D min; /**< The corner with the smallest x, y and z values */
+    struct COORD_Coordinate3D max; /**< The corner with the largest x, y and z values */
+};
+
 /**
  * \brief A 3D object
  */
@@ -19,7 +30,165 @@ struct OBJ_Object
      */
     struct COORD_Coordinate3D *coordinates;
     struct COORD_Coordinate3D *surface_normals; /**< The normal vectors of the surface of each coordinate */
-    int length; /**< Number of coordinates and surface_normals */
+    long long length; /**< Number of coordinates and surface_normals */
+    /**
+     * The distance between neighboring points [m]. Each point is rendered as a splat that covers
+     * the gap to its neighbors, a sparse object thus looks the same as a dense object. If 0 each
+     * point is rendered as a single pixel.
+     */
+    double sample_spacing;
+    struct OBJ_BoundingBox bounds; /**< Bounding box of the coordinates, see OBJ_update_bounds() */
+};
+
+/**
+ * \brief A 3D object made of indexed triangles
+ *
+ * Unlike struct OBJ_Object, where each point covers (at most) one pixel, the triangles are
+ * rasterized, i.e. all pixels covered by a triangle are drawn. A mesh thus needs a lot fewer
+ * vertices than an object needs points to cover the same pixels.
+ */
+struct OBJ_Mesh
+{
+    /**
+     * The 3D coordinates of the vertices, in the object internal coordinate system (see
+     * struct OBJ_Object)
+     */
+    struct COORD_Coordinate3D *coordinates;
+    struct COORD_Coordinate3D *surface_normals; /**< The normal vectors of the surface of each vertex */
+    long long length; /**< Number of coordinates and surface_normals (vertices) */
+    long long *indices; /**< Three vertex indices for each triangle */
+    long long number_of_triangles; /**< Number of triangles, i.e. a third of the number of indices */
+    struct OBJ_BoundingBox bounds; /**< Bounding box of the coordinates, see OBJ_get_bounds() */
+};
+
+/**
+ * \brief A point of a compressed object, 10 bytes instead of the 48 bytes of a coordinate and a
+ *        surface normal
+ */
+struct OBJ_CompressedPoint
+{
+    /**
+     * The coordinate quantized to 16 bits per axis relative to the bounding box of the object,
+     * i.e. 0 is the min and 65535 the max of the bounding box
+     */
+    uint16_t coordinate[3];
+    /**
+     * The surface normal in octahedral encoding: the normal is projected onto the octahedron
+     * |x| + |y| + |z| = 1, the lower half is folded over the upper half, and x and y are stored
+     * with 16 bits each in range [-32767, 32767]
+     */
+    int16_t surface_normal[2];
 };
 
+/**
+ * \brief A 3D object with its points stored in a compressed layout, see OBJ_compress()
+ *
+ * Rendering large objects is bound by memory bandwidth rather than arithmetic, so reading a fifth
+ * of the bytes per point and decoding them while rendering is faster. The quantization error is a
+ * small fraction of the point spacing and the normal error is far below an illumination level.
+ */
+struct OBJ_CompressedObject
+{
+    struct OBJ_CompressedPoint *points; /**< The points */
+    long long length; /**< Number of points */
+    double sample_spacing; /**< The distance between neighboring points [m], see struct OBJ_Object */
+    struct OBJ_BoundingBox bounds; /**< Bounding box of the coordinates, the quantization range */
+};
+
+/**
+ * \brief A source of points that are read in chunks
+ *
+ * Makes it possible to render objects, e.g. large point clouds stored in files, without having all
+ * points in memory at the same time.
+ */
+struct OBJ_PointSource
+{
+    /**
+     * Read the next chunk of points. The position is an opaque cursor that is advanced past the
+     * read points, start reading from the beginning by setting it to 0. Returns the number of read
+     * points (at most max_points), 0 when there are no more points. The coordinates and surface
+     * normals are given in the object internal coordinate system, see struct OBJ_Object.
+     */
+    long long (*read)(
+        const void *context,
+        long long *position,
+        struct COORD_Coordinate3D *coordinates,
+        struct COORD_Coordinate3D *surface_normals,
+        long long max_points);
+    const void *context; /**< Passed to read */
+    double sample_spacing; /**< The distance between neighboring points [m], see struct OBJ_Object */
+};
+
+/**
+ * \brief Get the bounding box of a set of coordinates
+ *
+ * \param[in] coordinates The coordinates
+ * \param[in] length The number of coordinates
+ * \param[out] bounds The bounding box, empty (min > max) if there are no coordinates
+ */
+void OBJ_get_bounds(
+    const struct COORD_Coordinate3D *coordinates,
+    long long length,
+    struct OBJ_BoundingBox *bounds);
+
+/**
+ * \brief Update the bounding box of an object so that it encloses all its coordinates
+ *
+ * Must be called whenever the coordinates of an object are changed.
+ *
+ * \param[in,out] object The object
+ */
+void OBJ_update_bounds(
+    struct OBJ_Object *object);
+
+/**
+ * \brief Compress an object
+ *
+ * The caller is responsible for the memory management of the compressed object, use
+ * OBJ_free_compressed() when it is not needed anymore.
+ *
+ * \param[in] object The object, its bounds must enclose its coordinates, see OBJ_update_bounds()
+ *
+ * \return Compressed object
+ */
+struct OBJ_CompressedObject * OBJ_compress(
+    const struct OBJ_Object *object);
+
+/**
+ * \brief Free a compressed object
+ *
+ * \param[in] object The compressed object to free, do not use it anymore
+ */
+void OBJ_free_compressed(
+    struct OBJ_CompressedObject *object);
+
+/**
+ * \brief Decode a point of a compressed object
+ *
+ * \param[in] object The compressed object
+ * \param[in] index The index of the point
+ * \param[out] coordinate The coordinate, in the object internal coordinate system
+ * \param[out] surface_normal The surface normal, of unit length
+ */
+void OBJ_get_compressed_point(
+    const struct OBJ_CompressedObject *object,
+    long long index,
+    struct COORD_Coordinate3D *coordinate,
+    struct COORD_Coordinate3D *surface_normal);
+
+/**
+ * \brief Get the bounding box of a range of points of a compressed object
+ *
+ * \param[in] object The compressed object
+ * \param[in] begin The index of the first point
+ * \param[in] length The number of points
+ * \param[out] bounds The bounding box of the decoded coordinates, empty (min > max) if there are no
+ *                    points
+ */
+void OBJ_get_compressed_bounds(
+    const struct OBJ_CompressedObject *object,
+    long long begin,
+    long long length,
+    struct OBJ_BoundingBox *bounds);
+
 #endif /* ENGINE_OBJECT_H */
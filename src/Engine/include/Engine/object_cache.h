@@ -0,0 +1,68 @@
+/**
+ * \file
+ * \brief Object cache interface
+ *
+ * Caches generated objects as object files on disk. The first time an object is requested it is
+ * generated and written to the cache, later requests (e.g. by later runs of the program) memory
+ * maps the cached file instead of generating the object again.
+ */
+#ifndef ENGINE_OBJECTCACHE_H
+#define ENGINE_OBJECTCACHE_H
+
+struct OBJ_Object;
+
+struct OBJC_CachedObject;
+
+/**
+ * \brief Generates an object given a set of parameters
+ */
+typedef struct OBJ_Object * (*OBJC_Generator)(const double parameters[]);
+
+/**
+ * \brief Frees an object created by a OBJC_Generator
+ */
+typedef void (*OBJC_Destructor)(struct OBJ_Object *object);
+
+/**
+ * \brief Get an object from the cache, generate (and cache) it if it is not already cached
+ *
+ * The object is identified by its name and the generator parameters, make sure to use a unique
+ * name for each generator. The caller must release the object using OBJC_release() when it is no
+ * longer used.
+ *
+ * \param[in] cache_directory The directory of the cache, NULL disables the cache
+ * \param[in] name The name of the object
+ * \param[in] parameters The generator parameters
+ * \param[in] number_of_parameters The number of generator parameters
+ * \param[in] generator The generator of the object
+ * \param[in] destructor The destructor of objects created by the generator
+ *
+ * \return Cached object
+ */
+struct OBJC_CachedObject * OBJC_get(
+    const char *cache_directory,
+    const char *name,
+    const double parameters[],
+    int number_of_parameters,
+    OBJC_Generator generator,
+    OBJC_Destructor destructor);
+
+/**
+ * \brief Get the object of a cached object
+ *
+ * \param[in] cached_object The cached object
+ *
+ * \return The object, valid until the cached object is released
+ */
+const struct OBJ_Object * OBJC_get_object(
+    const struct OBJC_CachedObject *cached_object);
+
+/**
+ * \brief Release a cached object
+ *
+ * \param[in,out] cached_object The cached object to release (do not use it anymore)
+ */
+void OBJC_release(
+    struct OBJC_CachedObject *cached_object);
+
+#endif /* ENGINE_OBJECTCACHE_H */
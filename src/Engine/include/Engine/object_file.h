@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief Object file interface
+ *
+ * A versioned binary file format for objects. The file consists of a header (including the
+ * bounding box of the object) followed by the coordinates and the surface normals stored as two
+ * separate arrays. The arrays are stored in the same layout as in struct OBJ_Object, which makes it
+ * possible to memory map a file and use it as an object directly without any parsing or copying.
+ */
+#ifndef ENGINE_OBJECTFILE_H
+#define ENGINE_OBJECTFILE_H
+
+struct OBJ_Object;
+
+struct OBJF_MappedObject;
+
+/**
+ * \brief Write an object to a file
+ *
+ * \param[in] path The path of the file, an existing file is overwritten
+ * \param[in] object The object to write
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+int OBJF_write(
+    const char *path,
+    const struct OBJ_Object *object);
+
+/**
+ * \brief Memory map an object file (read only)
+ *
+ * The caller must unmap the object using OBJF_unmap() when it is no longer used.
+ *
+ * \param[in] path The path of the file
+ *
+ * \return Mapped object, NULL if the file could not be mapped or is not a valid object file of the
+ *         current version
+ */
+struct OBJF_MappedObject * OBJF_map(
+    const char *path);
+
+/**
+ * \brief Get the object of a mapped object file
+ *
+ * \param[in] mapped_object The mapped object file
+ *
+ * \return The object, valid until the file is unmapped
+ */
+const struct OBJ_Object * OBJF_get_object(
+    const struct OBJF_MappedObject *mapped_object);
+
+/**
+ * \brief Unmap an object file
+ *
+ * \param[in,out] mapped_object The mapped object file to unmap (do not use it anymore)
+ */
+void OBJF_unmap(
+    struct OBJF_MappedObject *mapped_object);
+
+#endif /* ENGINE_OBJECTFILE_H */
@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief Object optimization interface
+ *
+ * Optimization passes that modify the points of an object in place to make it faster to render.
+ * The passes do not change the rendered image (more than marginally).
+ */
+#ifndef ENGINE_OBJECTOPTIMIZATION_H
+#define ENGINE_OBJECTOPTIMIZATION_H
+
+struct OBJ_Object;
+
+/**
+ * \brief Sort the points of an object in Morton order (Z-order)
+ *
+ * The Morton order is a space filling curve, points that are close in the order are also close
+ * in space. Consecutive points are thus projected to neighboring screen cells, which makes the
+ * frame and z buffer accesses of the renderer cache friendly. The surface normals are kept in sync
+ * with the coordinates. The bounds of the object must be up to date.
+ *
+ * \param[in,out] object The object to sort
+ */
+void OBJOPT_sort_morton(
+    struct OBJ_Object *object);
+
+/**
+ * \brief Weld (remove) coincident or near coincident points of an object
+ *
+ * A point is removed if it is within a certain distance of a preceding point that is kept, i.e.
+ * the first point of a cluster is kept. The order of the kept points is preserved. The arrays of
+ * the object are not reallocated, only the length of the object is decreased. The bounds of the
+ * object are updated.
+ *
+ * \param[in,out] object The object to weld
+ * \param[in] tolerance The maximum distance between two points that are welded
+ *
+ * \return The number of removed points
+ */
+long long OBJOPT_weld(
+    struct OBJ_Object *object,
+    double tolerance);
+
+#endif /* ENGINE_OBJECTOPTIMIZATION_H */
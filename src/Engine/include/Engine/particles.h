@@ -0,0 +1,104 @@
+/**
+ * \file
+ * \brief Particle system interface
+ *
+ * Large numbers of short-lived point particles, e.g. sparks or smoke. The particles are stored as
+ * structure of arrays and updated entire arrays at a time, in loops simple enough for the compiler
+ * to vectorize. Dead particles are removed by compacting the arrays in place, so the live particles
+ * are always stored densely. All storage is allocated when the particle system is created.
+ *
+ * The particles are drawn as single pixels with a fixed intensity, without illumination, see
+ * struct REND_Objects.
+ */
+#ifndef ENGINE_PARTICLES_H
+#define ENGINE_PARTICLES_H
+
+#include <Base/coordinates.h>
+
+struct PART_ParticleSystem;
+
+/**
+ * \brief Emitter, spawns particles at a position
+ */
+struct PART_Emitter
+{
+    struct COORD_Coordinate3D position; /**< The position the particles are spawned at */
+    struct COORD_Coordinate3D velocity; /**< The mean initial velocity of the particles [m / s] */
+    /**
+     * Each component of the initial velocity is perturbed by a uniformly distributed random value in
+     * the range [-velocity_spread, velocity_spread] [m / s]
+     */
+    double velocity_spread;
+    double lifetime; /**< The time the particles live [s] */
+    double intensity; /**< The intensity the particles are drawn with, see ILL_get_illumination() */
+};
+
+/**
+ * \brief Read-only view of the live particles
+ */
+struct PART_Particles
+{
+    const double *x; /**< The x coordinates of the particles */
+    const double *y; /**< The y coordinates of the particles */
+    const double *z; /**< The z coordinates of the particles */
+    const double *intensity; /**< The intensities of the particles */
+    int length; /**< Number of live particles */
+};
+
+/**
+ * \brief Create a particle system
+ *
+ * \param[in] capacity The maximum number of live particles
+ * \param[in] seed The seed of the random velocity perturbations
+ *
+ * \return Particle system
+ */
+struct PART_ParticleSystem * PART_create(
+    int capacity,
+    unsigned int seed);
+
+/**
+ * \brief Destroy a particle system
+ *
+ * \param[in] particle_system The particle system to destroy, do not use it anymore
+ */
+void PART_destroy(
+    struct PART_ParticleSystem *particle_system);
+
+/**
+ * \brief Spawn particles from an emitter
+ *
+ * \param[in,out] particle_system The particle system
+ * \param[in] emitter The emitter
+ * \param[in] count The number of particles to spawn, not negative
+ *
+ * \return The number of spawned particles, less than count if the particle system is full
+ */
+int PART_emit(
+    struct PART_ParticleSystem *particle_system,
+    const struct PART_Emitter *emitter,
+    int count);
+
+/**
+ * \brief Advance all particles in time with a constant acceleration and remove the dead particles
+ *
+ * \param[in,out] particle_system The particle system
+ * \param[in] acceleration The acceleration of all particles, e.g. gravity [m / s^2]
+ * \param[in] time_step The time step [s]
+ */
+void PART_update(
+    struct PART_ParticleSystem *particle_system,
+    const struct COORD_Coordinate3D *acceleration,
+    double time_step);
+
+/**
+ * \brief Get the live particles
+ *
+ * \param[in] particle_system The particle system
+ * \param[out] particles The live particles, valid until the particle system is changed
+ */
+void PART_get_particles(
+    const struct PART_ParticleSystem *particle_system,
+    struct PART_Particles *particles);
+
+#endif /* ENGINE_PARTICLES_H */
@@ -0,0 +1,76 @@
+/**
+ * \file
+ * \brief Point cloud interface
+ *
+ * Loads point clouds (coordinates with surface normals) from files. The following formats are
+ * supported:
+ *     - Binary little endian PLY, the first element must be "vertex" with the (scalar) properties
+ *       x, y, z, nx, ny and nz, other properties are ignored.
+ *     - XYZ, a text file with one point per line: "x y z nx ny nz". Empty lines and lines starting
+ *       with # are ignored.
+ * The file is memory mapped. It can either be loaded into an object (converted in parallel) or
+ * streamed in chunks directly from the mapped file.
+ */
+#ifndef ENGINE_POINTCLOUD_H
+#define ENGINE_POINTCLOUD_H
+
+struct OBJ_Object;
+struct OBJ_PointSource;
+
+struct PCL_PointCloud;
+
+/**
+ * \brief Open (memory map) a point cloud file
+ *
+ * The caller must close the point cloud using PCL_close() when it is no longer used.
+ *
+ * \param[in] path The path of the file
+ *
+ * \return Point cloud, NULL if the file could not be opened or is not a supported point cloud file
+ */
+struct PCL_PointCloud * PCL_open(
+    const char *path);
+
+/**
+ * \brief Close a point cloud file
+ *
+ * \param[in,out] point_cloud The point cloud to close (do not use it anymore)
+ */
+void PCL_close(
+    struct PCL_PointCloud *point_cloud);
+
+/**
+ * \brief Load an entire point cloud into an object
+ *
+ * The file is converted in parallel chunks. The caller must free the object using
+ * PCL_free_object() when it is no longer used, the object does not depend on the point cloud file.
+ *
+ * \param[in] point_cloud The point cloud
+ *
+ * \return Object, NULL if the file is malformed
+ */
+struct OBJ_Object * PCL_load(
+    const struct PCL_PointCloud *point_cloud);
+
+/**
+ * \brief Free an object loaded by PCL_load()
+ *
+ * \param[in,out] object The object to free (do not use it anymore)
+ */
+void PCL_free_object(
+    struct OBJ_Object *object);
+
+/**
+ * \brief Get a point source that streams the points directly from the mapped file
+ *
+ * Malformed points are skipped. The sample spacing of the points is unknown, i.e. 0, so each point
+ * is drawn as a single pixel.
+ *
+ * \param[in] point_cloud The point cloud
+ *
+ * \return Point source, valid until the point cloud is closed
+ */
+const struct OBJ_PointSource * PCL_get_point_source(
+    const struct PCL_PointCloud *point_cloud);
+
+#endif /* ENGINE_POINTCLOUD_H */
@@ -9,6 +9,11 @@
 #include <Engine/coordinate_system_transformations.h>
 
 struct CAM_CameraParameters;
+struct MAT_Matrix;
+struct OBJ_Mesh;
+struct OBJ_Object;
+struct OBJ_PointSource;
+struct PART_ParticleSystem;
 
 struct REND_Renderer;
 
@@ -18,8 +23,50 @@ struct REND_Renderer;
 struct REND_ObjectWithPosition
 {
     const struct OBJ_Object *object; /**< Arbitrary object */
+    /**
+     * Used instead of the object if the object is NULL. The points are read (streamed) in chunks
+     * from the source, it is thus not necessary to have all points in memory at the same time.
+     */
+    const struct OBJ_PointSource *point_source;
+    /**
+     * Used instead of the object and the point source if both are NULL. The triangles of the mesh
+     * are rasterized, i.e. filled, instead of drawing one pixel per point.
+     */
+    const struct OBJ_Mesh *mesh;
+    /**
+     * Used instead of the object, the point source and the mesh if they are all NULL. The points
+     * are decoded while they are rendered, see struct OBJ_CompressedObject.
+     */
+    const struct OBJ_CompressedObject *compressed_object;
     struct COORD_Coordinate3D position; /**< The position of the object in the world */
     struct CST_Rotation3D rotation; /**< The rotation of the object in the world */
+    /**
+     * Used instead of the rotation if not NULL, a 3x3 rotation matrix. Makes it possible to use a
+     * rotation that is already computed, e.g. the cached world rotation of a scene graph node.
+     */
+    const struct MAT_Matrix *rotation_matrix;
+    /**
+     * Non-zero if the object does not move. Static objects are drawn to a cached layer once and
+     * the layer is reused as the background of the following frames. The layer is drawn again
+     * when a static object is added, removed or moved, or when the light source or camera changes.
+     * The points of a static object must not be modified while it is static.
+     */
+    int is_static;
+};
+
+/**
+ * \brief Many instances of the same object, e.g. particles
+ *
+ * The instances are drawn front-to-back in batches, each point of the object is transformed and
+ * drawn for all instances of a batch before the next point, so the points are only read from
+ * memory once per batch.
+ */
+struct REND_Instances
+{
+    const struct OBJ_Object *object; /**< The object shared by all instances */
+    const struct COORD_Coordinate3D *positions; /**< The position of each instance in the world */
+    const struct CST_Rotation3D *rotations; /**< The rotation of each instance in the world, NULL if not rotated */
+    int length; /**< Number of instances */
 };
 
 /**
@@ -27,8 +74,16 @@ struct REND_ObjectWithPosition
  */
 struct REND_Objects
 {
-    struct REND_ObjectWithPosition *objects; /**< Objects in the world */
+    const struct REND_ObjectWithPosition *objects; /**< Objects in the world */
     int length; /**< Number of objects in the collection */
+    const struct REND_Instances *instances; /**< Instanced objects in the world, drawn after the objects */
+    int number_of_instances; /**< Number of instanced objects in the collection */
+    /**
+     * Particle systems in the world, drawn last. The particles are drawn as single pixels with the
+     * intensity of each particle, they are not illuminated by the light source.
+     */
+    const struct PART_ParticleSystem *const *particle_systems;
+    int number_of_particle_systems; /**< Number of particle systems in the collection */
 };
 
 /**
@@ -47,6 +102,30 @@ struct REND_Renderer * REND_create(
     int screen_height,
     double fps);
 
+/**
+ * \brief Enable or disable occlusion culling, it is enabled by default
+ *
+ * Objects and chunks of points hidden behind what is already drawn are skipped when occlusion
+ * culling is enabled. The frames are the same either way, disabling it is only useful to measure
+ * what it saves.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] is_enabled Non-zero to enable occlusion culling
+ */
+void REND_set_occlusion_culling(
+    struct REND_Renderer *renderer,
+    int is_enabled);
+
+/**
+ * \brief Change the camera of a renderer
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] calibration The new camera parameters/calibration
+ */
+void REND_set_camera(
+    struct REND_Renderer *renderer,
+    const struct CAM_CameraParameters *calibration);
+
 /**
  * \brief Destroy a renderer
  *
@@ -58,6 +137,9 @@ void REND_destroy(
 /**
  * \brief Render a model
  *
+ * The quality of the non-static objects is adapted to the frame times, if the frame rate can not be
+ * achieved fewer points are drawn with larger splats, see REND_get_quality_level().
+ *
  * \param[in,out] renderer The renderer
  * \param[in] light_source The position of the light source
  * \param[in] objects The objects with corresponding world positions to render
@@ -67,4 +149,90 @@ void REND_render(
     const struct COORD_Coordinate3D *light_source,
     const struct REND_Objects *objects);
 
+/**
+ * \brief Render a model into the frame buffer and the z buffer without showing it
+ *
+ * The frame is neither synchronized to the frame rate nor drawn to the screen, and the quality is
+ * not adapted. Used when the frame is consumed by something else than the screen, e.g. when it
+ * is composited with frames rendered by other processes.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] objects The objects with corresponding world positions to render
+ */
+void REND_render_frame(
+    struct REND_Renderer *renderer,
+    const struct COORD_Coordinate3D *light_source,
+    const struct REND_Objects *objects);
+
+/**
+ * \brief Render a model to several views, e.g. split screen or stereo, without showing it
+ *
+ * Each renderer is a view with its own camera, frame buffer and z buffer, see REND_render_frame().
+ * The points of objects and point sources are transformed to the world and illuminated once, only
+ * the projection and the drawing is done per view, so a second view costs a fraction of a second
+ * renderer. Meshes, instances, particles and the static layers are rendered per view. All views
+ * are rendered with the quality of the first view.
+ *
+ * \param[in,out] renderers The renderers of the views
+ * \param[in] number_of_views The number of views
+ * \param[in] light_source The position of the light source
+ * \param[in] objects The objects with corresponding world positions to render
+ */
+void REND_render_views(
+    struct REND_Renderer *const *renderers,
+    int number_of_views,
+    const struct COORD_Coordinate3D *light_source,
+    const struct REND_Objects *objects);
+
+/**
+ * \brief Get the frame buffer of the last rendered frame
+ *
+ * \param[in] renderer The renderer
+ *
+ * \return The frame buffer, one character per pixel, valid until the next frame is rendered
+ */
+const struct MAT_Matrix * REND_get_frame_buffer(
+    const struct REND_Renderer *renderer);
+
+/**
+ * \brief Get the z buffer of the last rendered frame
+ *
+ * \param[in] renderer The renderer
+ *
+ * \return The z buffer, the depth of each pixel (INFINITY where nothing is drawn), valid until the
+ *         next frame is rendered
+ */
+const struct MAT_Matrix * REND_get_z_buffer(
+    const struct REND_Renderer *renderer);
+
+/**
+ * \brief Draw a frame buffer to the screen
+ *
+ * \param[in] frame_buffer The frame buffer, one character per pixel
+ */
+void REND_show_frame(
+    const struct MAT_Matrix *frame_buffer);
+
+/**
+ * \brief Get the illumination a pixel color represents, i.e. the inverse of the shading
+ *
+ * \param[in] color The pixel color
+ *
+ * \return The illumination at the middle of the illumination level of the color [0, 1], a negative
+ *         value if the color is not an illumination level, e.g. the background
+ */
+double REND_get_illumination(
+    char color);
+
+/**
+ * \brief Get the quality level the next frame is rendered with
+ *
+ * \param[in] renderer The renderer
+ *
+ * \return The quality level, 0 is full quality and each level halves the number of points drawn
+ */
+int REND_get_quality_level(
+    const struct REND_Renderer *renderer);
+
 #endif /* GAME_RENDERER_H */
@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief Scene graph interface
+ *
+ * A hierarchy of nodes where the transform (position and rotation) of each node is relative to its
+ * parent, e.g. the parts of an articulated model. The world transforms of the nodes are cached and
+ * only recomputed for nodes whose local transform, or the local transform of an ancestor, has
+ * changed. The nodes that have something to draw are exported as a flat draw list for the
+ * renderer.
+ */
+#ifndef ENGINE_SCENEGRAPH_H
+#define ENGINE_SCENEGRAPH_H
+
+#include <Base/coordinates.h>
+#include <Engine/coordinate_system_transformations.h>
+
+struct REND_ObjectWithPosition;
+struct REND_Objects;
+
+#define SG_ROOT (-1) /**< The parent of nodes at the top of the hierarchy */
+
+struct SG_SceneGraph;
+
+/**
+ * \brief Create an empty scene graph
+ *
+ * \return Scene graph
+ */
+struct SG_SceneGraph * SG_create(void);
+
+/**
+ * \brief Destroy a scene graph
+ *
+ * \param[in] graph The scene graph to destroy, do not use it anymore
+ */
+void SG_destroy(
+    struct SG_SceneGraph *graph);
+
+/**
+ * \brief Add a node to the scene graph
+ *
+ * \param[in,out] graph The scene graph
+ * \param[in] parent The parent node, SG_ROOT if the node has no parent
+ * \param[in] node What to draw (object, point source, mesh or compressed object, all NULL if the
+ *                 node only transforms its children) and the local transform of the node, i.e. the
+ *                 position and rotation relative to the parent. The rotation matrix is ignored.
+ *
+ * \return The node, parents always have a lower value than their children
+ */
+int SG_add_node(
+    struct SG_SceneGraph *graph,
+    int parent,
+    const struct REND_ObjectWithPosition *node);
+
+/**
+ * \brief Set the local transform of a node, the world transforms are updated by SG_update()
+ *
+ * \param[in,out] graph The scene graph
+ * \param[in] node The node
+ * \param[in] position The position relative to the parent
+ * \param[in] rotation The rotation relative to the parent
+ */
+void SG_set_local_transform(
+    struct SG_SceneGraph *graph,
+    int node,
+    const struct COORD_Coordinate3D *position,
+    const struct CST_Rotation3D *rotation);
+
+/**
+ * \brief Recompute the world transforms of the nodes that have changed, and their descendants
+ *
+ * \param[in,out] graph The scene graph
+ *
+ * \return The number of nodes whose world transform was recomputed
+ */
+int SG_update(
+    struct SG_SceneGraph *graph);
+
+/**
+ * \brief Get the world position of a node, as of the last SG_update()
+ *
+ * \param[in] graph The scene graph
+ * \param[in] node The node
+ * \param[out] position The world position
+ */
+void SG_get_world_position(
+    const struct SG_SceneGraph *graph,
+    int node,
+    struct COORD_Coordinate3D *position);
+
+/**
+ * \brief Get the draw list, i.e. the nodes that have something to draw with their world transforms
+ *
+ * The objects use the cached world rotation matrices of the nodes (see
+ * struct REND_ObjectWithPosition). The list is updated in place by SG_update() and is valid until
+ * a node is added or the scene graph is destroyed.
+ *
+ * \param[in] graph The scene graph
+ * \param[out] objects The draw list, to render with REND_render()
+ */
+void SG_get_objects(
+    const struct SG_SceneGraph *graph,
+    struct REND_Objects *objects);
+
+#endif /* ENGINE_SCENEGRAPH_H */
@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \brief World streaming interface
+ *
+ * Streams a world that does not fit in memory from disk. The world is partitioned into cubic
+ * chunks by WS_write_world(), each chunk is stored as an object file with the points of all
+ * objects inside the chunk in world coordinates. A background thread loads (memory maps) the
+ * chunks within a radius of the camera, nearest first, and evicts chunks that are far away or that
+ * must give room for nearer chunks when the memory budget is used up. The renderer only sees the
+ * resident chunks, loading never blocks the rendering.
+ */
+#ifndef ENGINE_WORLD_STREAMING_H
+#define ENGINE_WORLD_STREAMING_H
+
+struct CAM_ExtrinsicParameters;
+struct REND_ObjectWithPosition;
+struct REND_Objects;
+
+struct WS_World;
+
+/**
+ * \brief World streaming statistics
+ */
+struct WS_Statistics
+{
+    long long memory_in_use; /**< The size of the loaded chunks [bytes] */
+    int number_of_resident_chunks; /**< Number of chunks the renderer sees */
+    int number_of_loads; /**< Number of chunks loaded since the world was opened */
+    int number_of_evictions; /**< Number of chunks evicted since the world was opened */
+    double last_load_latency; /**< The time it took to load the last chunk [s] */
+    double average_load_latency; /**< The average time it took to load a chunk [s] */
+    double max_load_latency; /**< The longest time it took to load a chunk [s] */
+};
+
+/**
+ * \brief Partition objects into chunks and write the chunks to a directory
+ *
+ * Each point is assigned to the chunk that contains its world coordinate, i.e. an object may be
+ * split between several chunks. Only objects given by an OBJ_Object are written, point sources
+ * and meshes are ignored. The sample spacing of a chunk is the largest sample spacing of the
+ * objects in the chunk.
+ *
+ * \param[in] directory An existing directory, an already written world in it is overwritten
+ * \param[in] chunk_size The length of the sides of the chunks [m]
+ * \param[in] objects The objects in the world
+ * \param[in] length The number of objects
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+int WS_write_world(
+    const char *directory,
+    double chunk_size,
+    const struct REND_ObjectWithPosition *objects,
+    int length);
+
+/**
+ * \brief Open a world written by WS_write_world() and start streaming it
+ *
+ * No chunks are loaded until the camera is set with WS_set_camera().
+ *
+ * \param[in] directory The directory of the world
+ * \param[in] load_radius The chunks closer to the camera than this are loaded [m]
+ * \param[in] memory_budget The maximum size of the loaded chunks [bytes]
+ *
+ * \return World, NULL if the world could not be read
+ */
+struct WS_World * WS_open(
+    const char *directory,
+    double load_radius,
+    long long memory_budget);
+
+/**
+ * \brief Stop streaming and close a world, all chunks are unloaded
+ *
+ * \param[in] world The world to close, do not use it anymore
+ */
+void WS_close(
+    struct WS_World *world);
+
+/**
+ * \brief Set the camera the chunks are loaded around
+ *
+ * Only the translation of the camera is used.
+ *
+ * \param[in,out] world The world
+ * \param[in] extrinsic The extrinsic camera parameters
+ */
+void WS_set_camera(
+    struct WS_World *world,
+    const struct CAM_ExtrinsicParameters *extrinsic);
+
+/**
+ * \brief Wait until all chunks around the camera are loaded, or until the memory budget is used up
+ *
+ * Evicted chunks are only unloaded by WS_get_objects(), which must thus be called if the loading
+ * waits for memory.
+ *
+ * \param[in,out] world The world
+ */
+void WS_wait(
+    struct WS_World *world);
+
+/**
+ * \brief Get the resident chunks as objects to render
+ *
+ * Unloads the chunks evicted since the last call, the objects of the previous call must thus not
+ * be used anymore. The chunks are static objects, see struct REND_ObjectWithPosition.
+ *
+ * \param[in,out] world The world
+ * \param[out] objects The resident chunks, valid until the next call
+ */
+void WS_get_objects(
+    struct WS_World *world,
+    struct REND_Objects *objects);
+
+/**
+ * \brief Get the streaming statistics
+ *
+ * \param[in,out] world The world
+ * \param[out] statistics The statistics
+ */
+void WS_get_statistics(
+    struct WS_World *world,
+    struct WS_Statistics *statistics);
+
+#endif /* ENGINE_WORLD_STREAMING_H */
@@ -0,0 +1,238 @@
+/**
+ * \file
+ * \brief Object implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MAX_QUANTIZED_COORDINATE (65535.0)
+#define MAX_QUANTIZED_NORMAL (32767.0)
+
+/**
+ * \brief Quantize a coordinate to 16 bits
+ *
+ * \param[in] value The coordinate
+ * \param[in] min The min of the quantization range
+ * \param[in] max The max of the quantization range
+ *
+ * \return The quantized coordinate, 0 for min and 65535 for max
+ */
+static uint16_t quantize_coordinate(
+    const double value,
+    const double min,
+    const double max)
+{
+    if (!(max > min))
+    {
+        return 0U;
+    }
+
+    const double normalized = fmin(fmax((value - min) / (max - min), 0.0), 1.0);
+
+    return (uint16_t)lround(MAX_QUANTIZED_COORDINATE * normalized);
+}
+
+/**
+ * \brief Get the coordinate of a quantized coordinate
+ *
+ * \param[in] quantized The quantized coordinate
+ * \param[in] min The min of the quantization range
+ * \param[in] max The max of the quantization range
+ *
+ * \return The coordinate
+ */
+static double dequantize_coordinate(
+    const uint16_t quantized,
+    const double min,
+    const double max)
+{
+    return min + (max - min) * (quantized / MAX_QUANTIZED_COORDINATE);
+}
+
+/**
+ * \brief Get the sign of a value, 0 is positive
+ *
+ * \param[in] value The value
+ *
+ * \return -1.0 or 1.0
+ */
+static double get_sign(
+    const double value)
+{
+    return (value < 0.0) ? -1.0 : 1.0;
+}
+
+/**
+ * \brief Encode a surface normal in octahedral encoding, see struct OBJ_CompressedPoint
+ *
+ * \param[in] surface_normal The surface normal, of any length
+ * \param[out] encoded The encoded surface normal, the positive z axis for a zero normal
+ */
+static void encode_surface_normal(
+    const struct COORD_Coordinate3D *const surface_normal,
+    int16_t encoded[2])
+{
+    const double sum = fabs(surface_normal->x) + fabs(surface_normal->y) + fabs(surface_normal->z);
+
+    if (!(sum > 0.0))
+    {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+
+    double u = surface_normal->x / sum;
+    double v = surface_normal->y / sum;
+
+    if (surface_normal->z < 0.0)
+    {
+        const double folded_u = (1.0 - fabs(v)) * get_sign(u);
+        v = (1.0 - fabs(u)) * get_sign(v);
+        u = folded_u;
+    }
+
+    encoded[0] = (int16_t)lround(MAX_QUANTIZED_NORMAL * u);
+    encoded[1] = (int16_t)lround(MAX_QUANTIZED_NORMAL * v);
+}
+
+void OBJ_get_bounds(
+    const struct COORD_Coordinate3D *const coordinates,
+    const long long length,
+    struct OBJ_BoundingBox *const bounds)
+{
+    bounds->min.x = INFINITY;
+    bounds->min.y = INFINITY;
+    bounds->min.z = INFINITY;
+    bounds->max.x = -INFINITY;
+    bounds->max.y = -INFINITY;
+    bounds->max.z = -INFINITY;
+
+    for (long long i = 0; i < length; ++i)
+    {
+        const struct COORD_Coordinate3D *const coordinate = &coordinates[i];
+
+        bounds->min.x = fmin(bounds->min.x, coordinate->x);
+        bounds->min.y = fmin(bounds->min.y, coordinate->y);
+        bounds->min.z = fmin(bounds->min.z, coordinate->z);
+        bounds->max.x = fmax(bounds->max.x, coordinate->x);
+        bounds->max.y = fmax(bounds->max.y, coordinate->y);
+        bounds->max.z = fmax(bounds->max.z, coordinate->z);
+    }
+}
+
+void OBJ_update_bounds(
+    struct OBJ_Object *const object)
+{
+    OBJ_get_bounds(object->coordinates, object->length, &object->bounds);
+}
+
+struct OBJ_CompressedObject * OBJ_compress(
+    const struct OBJ_Object *const object)
+{
+    struct OBJ_CompressedObject *const compressed = malloc(sizeof(*compressed));
+    const struct OBJ_BoundingBox *const bounds = &object->bounds;
+
+    compressed->points = malloc((size_t)object->length * sizeof(*compressed->points));
+    compressed->length = object->length;
+    compressed->sample_spacing = object->sample_spacing;
+    compressed->bounds = object->bounds;
+
+    for (long long i = 0; i < object->length; ++i)
+    {
+        const struct COORD_Coordinate3D *const coordinate = &object->coordinates[i];
+        struct OBJ_CompressedPoint *const point = &compressed->points[i];
+
+        point->coordinate[0] = quantize_coordinate(coordinate->x, bounds->min.x, bounds->max.x);
+        point->coordinate[1] = quantize_coordinate(coordinate->y, bounds->min.y, bounds->max.y);
+        point->coordinate[2] = quantize_coordinate(coordinate->z, bounds->min.z, bounds->max.z);
+        encode_surface_normal(&object->surface_normals[i], point->surface_normal);
+    }
+
+    return compressed;
+}
+
+void OBJ_free_compressed(
+    struct OBJ_CompressedObject *const object)
+{
+    free(object->points);
+    free(object);
+}
+
+void OBJ_get_compressed_point(
+    const struct OBJ_CompressedObject *const object,
+    const long long index,
+    struct COORD_Coordinate3D *const coordinate,
+    struct COORD_Coordinate3D *const surface_normal)
+{
+    assert((index >= 0) && (index < object->length)); // LCOV_EXCL_LINE
+
+    const struct OBJ_CompressedPoint *const point = &object->points[index];
+    const struct OBJ_BoundingBox *const bounds = &object->bounds;
+
+    coordinate->x = dequantize_coordinate(point->coordinate[0], bounds->min.x, bounds->max.x);
+    coordinate->y = dequantize_coordinate(point->coordinate[1], bounds->min.y, bounds->max.y);
+    coordinate->z = dequantize_coordinate(point->coordinate[2], bounds->min.z, bounds->max.z);
+
+    /* Unfold the lower half of the octahedron */
+    double x = point->surface_normal[0] / MAX_QUANTIZED_NORMAL;
+    double y = point->surface_normal[1] / MAX_QUANTIZED_NORMAL;
+    const double z = 1.0 - fabs(x) - fabs(y);
+
+    if (z < 0.0)
+    {
+        const double unfolded_x = (1.0 - fabs(y)) * get_sign(x);
+        y = (1.0 - fabs(x)) * get_sign(y);
+        x = unfolded_x;
+    }
+
+    const double norm = sqrt(x * x + y * y + z * z);
+
+    surface_normal->x = x / norm;
+    surface_normal->y = y / norm;
+    surface_normal->z = z / norm;
+}
+
+void OBJ_get_compressed_bounds(
+    const struct OBJ_CompressedObject *const object,
+    const long long begin,
+    const long long length,
+    struct OBJ_BoundingBox *const bounds)
+{
+    assert((begin >= 0) && (length >= 0) && (length <= object->length - begin)); // LCOV_EXCL_LINE
+
+    if (length == 0)
+    {
+        OBJ_get_bounds(NULL, 0, bounds);
+        return;
+    }
+
+    uint16_t min[3] = {UINT16_MAX, UINT16_MAX, UINT16_MAX};
+    uint16_t max[3] = {0U, 0U, 0U};
+    const struct OBJ_CompressedPoint *const points = &object->points[begin];
+
+    /* The dequantization is monotonic, the bounds of the quantized coordinates are the bounds of the coordinates */
+    for (long long i = 0; i < length; ++i)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const uint16_t value = points[i].coordinate[axis];
+
+            min[axis] = (value < min[axis]) ? value : min[axis];
+            max[axis] = (value > max[axis]) ? value : max[axis];
+        }
+    }
+
+    const struct OBJ_BoundingBox *const range = &object->bounds;
+
+    bounds->min.x = dequantize_coordinate(min[0], range->min.x, range->max.x);
+    bounds->min.y = dequantize_coordinate(min[1], range->min.y, range->max.y);
+    bounds->min.z = dequantize_coordinate(min[2], range->min.z, range->max.z);
+    bounds->max.x = dequantize_coordinate(max[0], range->min.x, range->max.x);
+    bounds->max.y = dequantize_coordinate(max[1], range->min.y, range->max.y);
+    bounds->max.z = dequantize_coordinate(max[2], range->min.z, range->max.z);
+}
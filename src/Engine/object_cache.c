@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief Object cache implementation
+ */
+#include <Engine/object_cache.h>
+#include <Engine/object_file.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_PATH_LENGTH (4096)
+/* Part of the cache file names. Increase when the content of cached objects changes without the
+ * names or parameters changing, e.g. the object file format, so that stale files are not used. */
+#define CACHE_VERSION (2U)
+
+/**
+ * \brief Cached object
+ *
+ * Either a mapped object file or, if the cache is disabled or could not be written, a generated
+ * object.
+ */
+struct OBJC_CachedObject
+{
+    struct OBJF_MappedObject *mapped_object; /**< The mapped object file, NULL if not mapped */
+    struct OBJ_Object *generated_object; /**< The generated object, NULL if mapped */
+    OBJC_Destructor destructor; /**< Destructor of the generated object */
+};
+
+/**
+ * \brief Get the path of the cache file of an object
+ *
+ * The parameters are encoded using their exact binary representation, i.e. the path differs if
+ * any parameter differs. The path also contains the cache version.
+ *
+ * \param[in] cache_directory The directory of the cache
+ * \param[in] name The name of the object
+ * \param[in] parameters The generator parameters
+ * \param[in] number_of_parameters The number of generator parameters
+ * \param[out] path The path
+ * \param[in] path_size The size of the path buffer
+ *
+ * \return 0 on success a non-zero value if the path does not fit in the buffer
+ */
+static int get_cache_path(
+    const char *const cache_directory,
+    const char *const name,
+    const double parameters[],
+    const int number_of_parameters,
+    char *const path,
+    const size_t path_size)
+{
+    int written = snprintf(path, path_size, "%s/%s-v%u", cache_directory, name, CACHE_VERSION);
+    size_t length = (written < 0) ? path_size : (size_t)written;
+
+    for (int i = 0; (i < number_of_parameters) && (length < path_size); ++i)
+    {
+        uint64_t bits = 0U;
+        memcpy(&bits, &parameters[i], sizeof(bits));
+        written = snprintf(&path[length], path_size - length, "-%016llx", (unsigned long long)bits);
+        length = (written < 0) ? path_size : (length + (size_t)written);
+    }
+
+    if (length < path_size)
+    {
+        written = snprintf(&path[length], path_size - length, ".obj");
+        length = (written < 0) ? path_size : (length + (size_t)written);
+    }
+
+    return length >= path_size;
+}
+
+/**
+ * \brief Write an object to the cache
+ *
+ * The object is first written to a unique temporary file which is then renamed, this makes sure
+ * that other processes or threads never map partially written files, and that processes or
+ * threads caching the same object at the same time never write to the same file.
+ *
+ * \param[in] path The path of the cache file
+ * \param[in] object The object to write
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int write_cache_file(
+    const char *const path,
+    const struct OBJ_Object *const object)
+{
+    char temporary_path[MAX_PATH_LENGTH];
+    const int length = snprintf(temporary_path, sizeof(temporary_path), "%s.XXXXXX", path);
+
+    if ((length < 0) || ((size_t)length >= sizeof(temporary_path)))
+    {
+        return -1;
+    }
+
+    const int fd = mkstemp(temporary_path);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    close(fd);
+
+    if (OBJF_write(temporary_path, object) != 0)
+    {
+        remove(temporary_path);
+        return -1;
+    }
+
+    if (rename(temporary_path, path) != 0)
+    {
+        remove(temporary_path);
+        return -1;
+    }
+
+    return 0;
+}
+
+struct OBJC_CachedObject * OBJC_get(
+    const char *const cache_directory,
+    const char *const name,
+    const double parameters[],
+    const int number_of_parameters,
+    const OBJC_Generator generator,
+    const OBJC_Destructor destructor)
+{
+    struct OBJC_CachedObject *const cached_object = calloc(1, sizeof(*cached_object));
+    char path[MAX_PATH_LENGTH];
+    const int use_cache = (cache_directory != NULL) &&
+        (get_cache_path(cache_directory, name, parameters, number_of_parameters, path, sizeof(path)) == 0);
+
+    cached_object->destructor = destructor;
+
+    if (use_cache)
+    {
+        cached_object->mapped_object = OBJF_map(path);
+
+        if (cached_object->mapped_object != NULL)
+        {
+            return cached_object;
+        }
+    }
+
+    struct OBJ_Object *const object = generator(parameters);
+
+    if (use_cache && (write_cache_file(path, object) == 0))
+    {
+        cached_object->mapped_object = OBJF_map(path);
+    }
+
+    if (cached_object->mapped_object != NULL)
+    {
+        destructor(object);
+    }
+    else
+    {
+        cached_object->generated_object = object;
+    }
+
+    return cached_object;
+}
+
+const struct OBJ_Object * OBJC_get_object(
+    const struct OBJC_CachedObject *const cached_object)
+{
+    if (cached_object->mapped_object != NULL)
+    {
+        return OBJF_get_object(cached_object->mapped_object);
+    }
+
+    assert(cached_object->generated_object != NULL); // LCOV_EXCL_LINE
+
+    return cached_object->generated_object;
+}
+
+void OBJC_release(
+    struct OBJC_CachedObject *const cached_object)
+{
+    if (cached_object->mapped_object != NULL)
+    {
+        OBJF_unmap(cached_object->mapped_object);
+    }
+    else
+    {
+        cached_object->destructor(cached_object->generated_object);
+    }
+
+    free(cached_object);
+}
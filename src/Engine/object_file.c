@@ -0,0 +1,226 @@
+/**
+ * \file
+ * \brief Object file implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/object_file.h>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIC ("GEOBJ")
+#define VERSION (2U)
+#define BYTE_ORDER_MARK (0x01020304U) /* Files are stored in native byte order */
+#define ARRAY_ALIGNMENT (64U) /* Cache line size */
+
+_Static_assert(sizeof(struct COORD_Coordinate3D) == (3 * sizeof(double)), "Coordinates must not be padded");
+
+/**
+ * \brief Object file header, located at the beginning of the file
+ */
+struct FileHeader
+{
+    char magic[8]; /**< Identifies the file as an object file */
+    uint32_t version; /**< The version of the file format */
+    uint32_t byte_order_mark; /**< Used to detect files written on a machine with different byte order */
+    uint64_t length; /**< Number of coordinates and surface normals */
+    uint64_t coordinates_offset; /**< Offset from the beginning of the file to the coordinates [bytes] */
+    uint64_t surface_normals_offset; /**< Offset from the beginning of the file to the surface normals [bytes] */
+    struct OBJ_BoundingBox bounds; /**< Bounding box of the coordinates */
+    double sample_spacing; /**< The distance between neighboring points [m] */
+};
+
+/**
+ * \brief Mapped object file
+ */
+struct OBJF_MappedObject
+{
+    void *data; /**< The mapped file */
+    size_t size; /**< The size of the mapped file [bytes] */
+    struct OBJ_Object object; /**< The object, the arrays points into the mapped file */
+};
+
+/**
+ * \brief Round up an offset to the closest multiple of the array alignment
+ *
+ * \param[in] offset The offset [bytes]
+ *
+ * \return The aligned offset [bytes]
+ */
+static uint64_t align_offset(
+    const uint64_t offset)
+{
+    return ((offset + ARRAY_ALIGNMENT - 1U) / ARRAY_ALIGNMENT) * ARRAY_ALIGNMENT;
+}
+
+/**
+ * \brief Write zero padding to a file until a certain offset is reached
+ *
+ * \param[in,out] file The file
+ * \param[in] current_offset The current offset in the file [bytes]
+ * \param[in] offset The offset to pad to [bytes]
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int write_padding(
+    FILE *const file,
+    const uint64_t current_offset,
+    const uint64_t offset)
+{
+    static const unsigned char padding[ARRAY_ALIGNMENT] = {0};
+    const size_t padding_size = (size_t)(offset - current_offset);
+
+    return fwrite(padding, 1, padding_size, file) != padding_size;
+}
+
+/**
+ * \brief Check if an array is entirely inside a file
+ *
+ * \param[in] offset The offset of the array from the beginning of the file [bytes]
+ * \param[in] array_size The size of the array [bytes]
+ * \param[in] size The size of the file [bytes]
+ *
+ * \return Non-zero value if the array is inside the file, 0 otherwise
+ */
+static int is_array_in_file(
+    const uint64_t offset,
+    const uint64_t array_size,
+    const size_t size)
+{
+    /* Written without adding the offset and size, which may wrap around for a corrupt header */
+    return (array_size <= size) && (offset <= size - array_size);
+}
+
+/**
+ * \brief Check if a mapped file contains a valid object file header
+ *
+ * \param[in] header The header
+ * \param[in] size The size of the file [bytes]
+ *
+ * \return Non-zero value if valid, 0 otherwise
+ */
+static int is_valid_header(
+    const struct FileHeader *const header,
+    const size_t size)
+{
+    if ((memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) ||
+        (header->version != VERSION) ||
+        (header->byte_order_mark != BYTE_ORDER_MARK) ||
+        (header->length > (LLONG_MAX / sizeof(struct COORD_Coordinate3D))))
+    {
+        return 0;
+    }
+
+    const uint64_t array_size = header->length * sizeof(struct COORD_Coordinate3D);
+
+    return ((header->coordinates_offset % ARRAY_ALIGNMENT) == 0U) &&
+        ((header->surface_normals_offset % ARRAY_ALIGNMENT) == 0U) &&
+        (header->coordinates_offset >= sizeof(*header)) &&
+        is_array_in_file(header->coordinates_offset, array_size, size) &&
+        (header->surface_normals_offset >= header->coordinates_offset + array_size) &&
+        is_array_in_file(header->surface_normals_offset, array_size, size);
+}
+
+int OBJF_write(
+    const char *const path,
+    const struct OBJ_Object *const object)
+{
+    const uint64_t array_size = (uint64_t)object->length * sizeof(struct COORD_Coordinate3D);
+    struct FileHeader header = {
+        .version = VERSION,
+        .byte_order_mark = BYTE_ORDER_MARK,
+        .length = (uint64_t)object->length,
+        .coordinates_offset = align_offset(sizeof(header)),
+        .bounds = object->bounds,
+        .sample_spacing = object->sample_spacing
+    };
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.surface_normals_offset = align_offset(header.coordinates_offset + array_size);
+
+    FILE *const file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    int error = fwrite(&header, sizeof(header), 1, file) != 1;
+    error = error || write_padding(file, sizeof(header), header.coordinates_offset);
+    error = error || (fwrite(object->coordinates, 1, (size_t)array_size, file) != array_size);
+    error = error || write_padding(file, header.coordinates_offset + array_size, header.surface_normals_offset);
+    error = error || (fwrite(object->surface_normals, 1, (size_t)array_size, file) != array_size);
+    error = (fclose(file) != 0) || error;
+
+    return error ? -1 : 0;
+}
+
+struct OBJF_MappedObject * OBJF_map(
+    const char *const path)
+{
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat file_status;
+
+    if ((fstat(fd, &file_status) != 0) || (file_status.st_size < (off_t)sizeof(struct FileHeader)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t size = (size_t)file_status.st_size;
+    unsigned char *const data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd); /* The mapping keeps a reference to the file. */
+
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    const struct FileHeader *const header = (const void *)data;
+
+    if (!is_valid_header(header, size))
+    {
+        munmap(data, size);
+        return NULL;
+    }
+
+    struct OBJF_MappedObject *const mapped_object = calloc(1, sizeof(*mapped_object));
+
+    mapped_object->data = data;
+    mapped_object->size = size;
+    mapped_object->object.coordinates = (void *)&data[header->coordinates_offset];
+    mapped_object->object.surface_normals = (void *)&data[header->surface_normals_offset];
+    mapped_object->object.length = (long long)header->length;
+    mapped_object->object.bounds = header->bounds;
+    mapped_object->object.sample_spacing = header->sample_spacing;
+
+    return mapped_object;
+}
+
+const struct OBJ_Object * OBJF_get_object(
+    const struct OBJF_MappedObject *const mapped_object)
+{
+    return &mapped_object->object;
+}
+
+void OBJF_unmap(
+    struct OBJF_MappedObject *const mapped_object)
+{
+    munmap(mapped_object->data, mapped_object->size);
+    free(mapped_object);
+}
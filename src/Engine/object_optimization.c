@@ -0,0 +1,372 @@
+/**
+ * \file
+ * \brief Object optimization implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/object_optimization.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MORTON_BITS_PER_AXIS (21) /* 3 * 21 = 63 bits, fits in a 64-bit key */
+#define RADIX_BITS (8)
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+/**
+ * \brief A cell in a uniform grid
+ */
+struct Cell
+{
+    int64_t x; /**< Cell index in the x direction */
+    int64_t y; /**< Cell index in the y direction */
+    int64_t z; /**< Cell index in the z direction */
+};
+
+/**
+ * \brief A slot in a spatial hash table, contains all points in a cell
+ */
+struct Slot
+{
+    struct Cell cell; /**< The cell */
+    long long head; /**< The first point in the cell, -1 if the slot is empty */
+};
+
+/**
+ * \brief A spatial hash table (open addressing)
+ */
+struct SpatialHash
+{
+    struct Slot *slots; /**< The slots */
+    uint64_t mask; /**< The number of slots minus one, the number of slots is a power of two */
+    long long *next; /**< The next point in the same cell, -1 for the last point */
+};
+
+/**
+ * \brief A point index and its sort key
+ */
+struct KeyIndex
+{
+    uint64_t key; /**< The sort key */
+    long long index; /**< The index of the point */
+};
+
+/**
+ * \brief Spread the bits of a value so that there are two zero bits between each bit
+ *
+ * \param[in] value A value with at most MORTON_BITS_PER_AXIS bits
+ *
+ * \return The spread value
+ */
+static uint64_t spread_bits(
+    const uint64_t value)
+{
+    uint64_t x = value & 0x1fffffU;
+
+    x = (x | (x << 32U)) & 0x1f00000000ffffU;
+    x = (x | (x << 16U)) & 0x1f0000ff0000ffU;
+    x = (x | (x << 8U)) & 0x100f00f00f00f00fU;
+    x = (x | (x << 4U)) & 0x10c30c30c30c30c3U;
+    x = (x | (x << 2U)) & 0x1249249249249249U;
+
+    return x;
+}
+
+/**
+ * \brief Quantize a coordinate axis to an integer in range [0, 2^MORTON_BITS_PER_AXIS)
+ *
+ * \param[in] value The value to quantize
+ * \param[in] min_value The minimum value of the axis
+ * \param[in] max_value The maximum value of the axis
+ *
+ * \return Quantized value
+ */
+static uint64_t quantize(
+    const double value,
+    const double min_value,
+    const double max_value)
+{
+    static const double max_quantized = (double)((1U << MORTON_BITS_PER_AXIS) - 1U);
+    const double extent = max_value - min_value;
+
+    if (!(extent > 0.0))
+    {
+        return 0U;
+    }
+
+    const double normalized = (value - min_value) / extent;
+
+    return (uint64_t)fmax(0.0, fmin(max_quantized, normalized * max_quantized));
+}
+
+/**
+ * \brief Get the Morton code of a coordinate
+ *
+ * \param[in] coordinate The coordinate
+ * \param[in] bounds The bounding box of all coordinates
+ *
+ * \return Morton code
+ */
+static uint64_t get_morton_code(
+    const struct COORD_Coordinate3D *const coordinate,
+    const struct OBJ_BoundingBox *const bounds)
+{
+    const uint64_t x = quantize(coordinate->x, bounds->min.x, bounds->max.x);
+    const uint64_t y = quantize(coordinate->y, bounds->min.y, bounds->max.y);
+    const uint64_t z = quantize(coordinate->z, bounds->min.z, bounds->max.z);
+
+    return spread_bits(x) | (spread_bits(y) << 1U) | (spread_bits(z) << 2U);
+}
+
+/**
+ * \brief Sort keys (stable) using a least significant digit radix sort
+ *
+ * \param[in,out] keys The keys to sort
+ * \param[in,out] buffer Temporary buffer of the same length as the keys
+ * \param[in] length The number of keys
+ * \param[in] key_bits The number of significant bits of the keys
+ */
+static void radix_sort(
+    struct KeyIndex *keys,
+    struct KeyIndex *buffer,
+    const long long length,
+    const unsigned int key_bits)
+{
+    for (unsigned int shift = 0U; shift < key_bits; shift += RADIX_BITS)
+    {
+        long long counts[RADIX_SIZE] = {0};
+
+        for (long long i = 0; i < length; ++i)
+        {
+            ++counts[(keys[i].key >> shift) & (RADIX_SIZE - 1U)];
+        }
+
+        long long offset = 0;
+
+        for (int digit = 0; digit < RADIX_SIZE; ++digit)
+        {
+            const long long count = counts[digit];
+            counts[digit] = offset;
+            offset += count;
+        }
+
+        for (long long i = 0; i < length; ++i)
+        {
+            buffer[counts[(keys[i].key >> shift) & (RADIX_SIZE - 1U)]++] = keys[i];
+        }
+
+        struct KeyIndex *const temp = keys;
+        keys = buffer;
+        buffer = temp;
+    }
+}
+
+/**
+ * \brief Reorder the points of an object
+ *
+ * \param[in,out] object The object
+ * \param[in] order The new order, element i is the index of the point that is moved to index i
+ */
+static void reorder_points(
+    struct OBJ_Object *const object,
+    const struct KeyIndex *const order)
+{
+    const size_t size = (size_t)object->length * sizeof(*object->coordinates);
+    struct COORD_Coordinate3D *const coordinates = malloc(size);
+    struct COORD_Coordinate3D *const surface_normals = malloc(size);
+
+    memcpy(coordinates, object->coordinates, size);
+    memcpy(surface_normals, object->surface_normals, size);
+
+    for (long long i = 0; i < object->length; ++i)
+    {
+        object->coordinates[i] = coordinates[order[i].index];
+        object->surface_normals[i] = surface_normals[order[i].index];
+    }
+
+    free(surface_normals);
+    free(coordinates);
+}
+
+void OBJOPT_sort_morton(
+    struct OBJ_Object *const object)
+{
+    if (object->length <= 1)
+    {
+        return;
+    }
+
+    struct KeyIndex *const keys = calloc((size_t)object->length, sizeof(*keys));
+    struct KeyIndex *const buffer = calloc((size_t)object->length, sizeof(*buffer));
+
+    for (long long i = 0; i < object->length; ++i)
+    {
+        keys[i].key = get_morton_code(&object->coordinates[i], &object->bounds);
+        keys[i].index = i;
+    }
+
+    /* Sorting all 64 bits takes an even number of passes, which leaves the result in keys. */
+    radix_sort(keys, buffer, object->length, 64U);
+
+    reorder_points(object, keys);
+
+    free(buffer);
+    free(keys);
+}
+
+/**
+ * \brief Get the grid cell of a coordinate
+ *
+ * \param[in] coordinate The coordinate
+ * \param[in] cell_size The size of a cell
+ * \param[out] cell The cell
+ */
+static void get_cell(
+    const struct COORD_Coordinate3D *const coordinate,
+    const double cell_size,
+    struct Cell *const cell)
+{
+    cell->x = (int64_t)floor(coordinate->x / cell_size);
+    cell->y = (int64_t)floor(coordinate->y / cell_size);
+    cell->z = (int64_t)floor(coordinate->z / cell_size);
+}
+
+/**
+ * \brief Find the slot of a cell in a spatial hash table
+ *
+ * \param[in] spatial_hash The spatial hash table
+ * \param[in] cell The cell
+ *
+ * \return The slot of the cell, or the empty slot where the cell shall be inserted
+ */
+static struct Slot * find_slot(
+    const struct SpatialHash *const spatial_hash,
+    const struct Cell *const cell)
+{
+    const uint64_t hash =
+        ((uint64_t)cell->x * 0x9e3779b97f4a7c15U) ^
+        ((uint64_t)cell->y * 0xc2b2ae3d27d4eb4fU) ^
+        ((uint64_t)cell->z * 0x165667b19e3779f9U);
+
+    for (uint64_t i = (hash ^ (hash >> 29U)) & spatial_hash->mask; ; i = (i + 1U) & spatial_hash->mask)
+    {
+        struct Slot *const slot = &spatial_hash->slots[i];
+
+        if ((slot->head < 0) || ((slot->cell.x == cell->x) && (slot->cell.y == cell->y) && (slot->cell.z == cell->z)))
+        {
+            return slot;
+        }
+    }
+}
+
+/**
+ * \brief Check if there is a point within a certain distance of a coordinate in the neighborhood
+ *        (the cell of the coordinate and the 26 surrounding cells)
+ *
+ * \param[in] spatial_hash The spatial hash table
+ * \param[in] coordinates The coordinates of the points in the table
+ * \param[in] coordinate The coordinate
+ * \param[in] cell The cell of the coordinate
+ * \param[in] tolerance The distance, equal to the cell size
+ *
+ * \return Non-zero value if there is such a point
+ */
+static int has_close_point(
+    const struct SpatialHash *const spatial_hash,
+    const struct COORD_Coordinate3D *const coordinates,
+    const struct COORD_Coordinate3D *const coordinate,
+    const struct Cell *const cell,
+    const double tolerance)
+{
+    const double squared_tolerance = tolerance * tolerance;
+
+    for (int64_t dz = -1; dz <= 1; ++dz)
+    {
+        for (int64_t dy = -1; dy <= 1; ++dy)
+        {
+            for (int64_t dx = -1; dx <= 1; ++dx)
+            {
+                const struct Cell neighbor = {.x = cell->x + dx, .y = cell->y + dy, .z = cell->z + dz};
+
+                for (long long p = find_slot(spatial_hash, &neighbor)->head; p >= 0; p = spatial_hash->next[p])
+                {
+                    struct COORD_Coordinate3D difference;
+                    COORD_Coordinate3D_sub(&coordinates[p], coordinate, &difference);
+
+                    const double squared_distance =
+                        (difference.x * difference.x) + (difference.y * difference.y) + (difference.z * difference.z);
+
+                    if (squared_distance <= squared_tolerance)
+                    {
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+long long OBJOPT_weld(
+    struct OBJ_Object *const object,
+    const double tolerance)
+{
+    assert(tolerance > 0.0); // LCOV_EXCL_LINE
+
+    uint64_t number_of_slots = 1U;
+
+    while (number_of_slots < (2U * (uint64_t)object->length))
+    {
+        number_of_slots <<= 1U;
+    }
+
+    const struct SpatialHash spatial_hash = {
+        .slots = malloc((size_t)number_of_slots * sizeof(*spatial_hash.slots)),
+        .mask = number_of_slots - 1U,
+        .next = malloc(((size_t)object->length + 1U) * sizeof(*spatial_hash.next))
+    };
+
+    for (uint64_t i = 0U; i < number_of_slots; ++i)
+    {
+        spatial_hash.slots[i].head = -1;
+    }
+
+    /* The kept points are compacted in place. A point is always read before it is overwritten,
+     * and the hash table refers to the compacted (kept) points. */
+    long long kept = 0;
+
+    for (long long i = 0; i < object->length; ++i)
+    {
+        const struct COORD_Coordinate3D coordinate = object->coordinates[i];
+        struct Cell cell;
+        get_cell(&coordinate, tolerance, &cell);
+
+        if (!has_close_point(&spatial_hash, object->coordinates, &coordinate, &cell, tolerance))
+        {
+            struct Slot *const slot = find_slot(&spatial_hash, &cell);
+
+            object->coordinates[kept] = coordinate;
+            object->surface_normals[kept] = object->surface_normals[i];
+
+            slot->cell = cell;
+            spatial_hash.next[kept] = slot->head;
+            slot->head = kept;
+
+            ++kept;
+        }
+    }
+
+    free(spatial_hash.next);
+    free(spatial_hash.slots);
+
+    const long long removed = object->length - kept;
+
+    object->length = kept;
+    OBJ_update_bounds(object);
+
+    return removed;
+}
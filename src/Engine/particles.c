@@ -0,0 +1,207 @@
+/**
+ * \file
+ * \brief Particle system implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/particles.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+/**
+ * \brief The component arrays, each component has one array of doubles
+ */
+enum Component
+{
+    POSITION_X,
+    POSITION_Y,
+    POSITION_Z,
+    VELOCITY_X,
+    VELOCITY_Y,
+    VELOCITY_Z,
+    LIFETIME,
+    INTENSITY,
+    NUMBER_OF_COMPONENTS
+};
+
+/**
+ * \brief Particle system
+ */
+struct PART_ParticleSystem
+{
+    double *components[NUMBER_OF_COMPONENTS]; /**< The component arrays, the live particles first */
+    int length; /**< Number of live particles */
+    int capacity; /**< The maximum number of live particles */
+    unsigned long long random_state; /**< State of the random number generator, never zero */
+};
+
+/**
+ * \brief Get a uniformly distributed random number, xorshift64*
+ *
+ * \param[in,out] particle_system The particle system
+ *
+ * \return Random number in range [-1, 1)
+ */
+static double get_random_number(
+    struct PART_ParticleSystem *const particle_system)
+{
+    unsigned long long state = particle_system->random_state;
+
+    state ^= state >> 12U;
+    state ^= state << 25U;
+    state ^= state >> 27U;
+    particle_system->random_state = state;
+
+    /* The 53 most significant bits of the output in range [0, 1) */
+    const double unit = (double)((state * 0x2545F4914F6CDD1DULL) >> 11U) / 9007199254740992.0;
+
+    return (2.0 * unit) - 1.0;
+}
+
+/**
+ * \brief Integrate the position and velocity along one axis with a constant acceleration
+ *
+ * \param[in,out] positions The positions along the axis
+ * \param[in,out] velocities The velocities along the axis
+ * \param[in] length The number of particles
+ * \param[in] acceleration The acceleration along the axis
+ * \param[in] time_step The time step [s]
+ */
+static void integrate(
+    double *restrict const positions,
+    double *restrict const velocities,
+    const int length,
+    const double acceleration,
+    const double time_step)
+{
+    const double velocity_change = acceleration * time_step;
+
+    for (int i = 0; i < length; ++i)
+    {
+        velocities[i] += velocity_change;
+        positions[i] += velocities[i] * time_step;
+    }
+}
+
+/**
+ * \brief Remove the particles without lifetime left, the order of the live particles is kept
+ *
+ * \param[in,out] particle_system The particle system
+ */
+static void remove_dead_particles(
+    struct PART_ParticleSystem *const particle_system)
+{
+    const double *const lifetimes = particle_system->components[LIFETIME];
+    int length = 0;
+
+    for (int i = 0; i < particle_system->length; ++i)
+    {
+        if (lifetimes[i] > 0.0)
+        {
+            if (length != i)
+            {
+                for (int j = 0; j < NUMBER_OF_COMPONENTS; ++j)
+                {
+                    particle_system->components[j][length] = particle_system->components[j][i];
+                }
+            }
+
+            ++length;
+        }
+    }
+
+    particle_system->length = length;
+}
+
+struct PART_ParticleSystem * PART_create(
+    const int capacity,
+    const unsigned int seed)
+{
+    assert(capacity > 0); // LCOV_EXCL_LINE
+
+    struct PART_ParticleSystem *const particle_system = calloc(1, sizeof(*particle_system));
+
+    for (int i = 0; i < NUMBER_OF_COMPONENTS; ++i)
+    {
+        particle_system->components[i] = calloc((size_t)capacity, sizeof(*particle_system->components[i]));
+    }
+
+    particle_system->capacity = capacity;
+    /* xorshift gets stuck at zero */
+    particle_system->random_state = ((unsigned long long)seed << 1U) | 1ULL;
+
+    return particle_system;
+}
+
+void PART_destroy(
+    struct PART_ParticleSystem *const particle_system)
+{
+    for (int i = 0; i < NUMBER_OF_COMPONENTS; ++i)
+    {
+        free(particle_system->components[i]);
+    }
+
+    free(particle_system);
+}
+
+int PART_emit(
+    struct PART_ParticleSystem *const particle_system,
+    const struct PART_Emitter *const emitter,
+    const int count)
+{
+    assert(count >= 0); // LCOV_EXCL_LINE
+
+    const int available = particle_system->capacity - particle_system->length;
+    const int number_of_particles = (count < available) ? count : available;
+    const double spread = emitter->velocity_spread;
+    double *const *const components = particle_system->components;
+
+    for (int i = particle_system->length; i < particle_system->length + number_of_particles; ++i)
+    {
+        components[POSITION_X][i] = emitter->position.x;
+        components[POSITION_Y][i] = emitter->position.y;
+        components[POSITION_Z][i] = emitter->position.z;
+        components[VELOCITY_X][i] = emitter->velocity.x + (spread * get_random_number(particle_system));
+        components[VELOCITY_Y][i] = emitter->velocity.y + (spread * get_random_number(particle_system));
+        components[VELOCITY_Z][i] = emitter->velocity.z + (spread * get_random_number(particle_system));
+        components[LIFETIME][i] = emitter->lifetime;
+        components[INTENSITY][i] = emitter->intensity;
+    }
+
+    particle_system->length += number_of_particles;
+
+    return number_of_particles;
+}
+
+void PART_update(
+    struct PART_ParticleSystem *const particle_system,
+    const struct COORD_Coordinate3D *const acceleration,
+    const double time_step)
+{
+    double *const *const components = particle_system->components;
+    const int length = particle_system->length;
+
+    integrate(components[POSITION_X], components[VELOCITY_X], length, acceleration->x, time_step);
+    integrate(components[POSITION_Y], components[VELOCITY_Y], length, acceleration->y, time_step);
+    integrate(components[POSITION_Z], components[VELOCITY_Z], length, acceleration->z, time_step);
+
+    double *const lifetimes = components[LIFETIME];
+
+    for (int i = 0; i < length; ++i)
+    {
+        lifetimes[i] -= time_step;
+    }
+
+    remove_dead_particles(particle_system);
+}
+
+void PART_get_particles(
+    const struct PART_ParticleSystem *const particle_system,
+    struct PART_Particles *const particles)
+{
+    particles->x = particle_system->components[POSITION_X];
+    particles->y = particle_system->components[POSITION_Y];
+    particles->z = particle_system->components[POSITION_Z];
+    particles->intensity = particle_system->components[INTENSITY];
+    particles->length = particle_system->length;
+}
@@ -0,0 +1,801 @@
+/**
+ * \file
+ * \brief Point cloud implementation
+ */
+#include <Base/coordinates.h>
+#include <Base/parallel.h>
+#include <Engine/object.h>
+#include <Engine/point_cloud.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAX_NUMBER_OF_THREADS (64)
+#define MIN_BYTES_PER_THREAD (1 << 20) /* Avoid creating threads for small files */
+#define MAX_HEADER_LINE_LENGTH (256)
+#define MAX_EXPONENT (400) /* Larger exponents overflows/underflows anyway */
+
+/**
+ * \brief Supported file formats
+ */
+enum Format
+{
+    FORMAT_PLY,
+    FORMAT_XYZ
+};
+
+/**
+ * \brief Supported PLY property types
+ */
+enum PropertyType
+{
+    PROPERTY_TYPE_INT8,
+    PROPERTY_TYPE_UINT8,
+    PROPERTY_TYPE_INT16,
+    PROPERTY_TYPE_UINT16,
+    PROPERTY_TYPE_INT32,
+    PROPERTY_TYPE_UINT32,
+    PROPERTY_TYPE_FLOAT32,
+    PROPERTY_TYPE_FLOAT64,
+    NUMBER_OF_PROPERTY_TYPES
+};
+
+/**
+ * \brief The fields of a point, in the same order as in a XYZ file
+ */
+enum Field
+{
+    FIELD_X,
+    FIELD_Y,
+    FIELD_Z,
+    FIELD_NX,
+    FIELD_NY,
+    FIELD_NZ,
+    NUMBER_OF_FIELDS
+};
+
+/**
+ * \brief A PLY vertex property
+ */
+struct Property
+{
+    enum PropertyType type; /**< The type of the property */
+    size_t offset; /**< Offset from the start of the vertex [bytes] */
+};
+
+/**
+ * \brief Point cloud
+ */
+struct PCL_PointCloud
+{
+    char *data; /**< The mapped file */
+    size_t size; /**< The size of the mapped file [bytes] */
+    enum Format format; /**< The format of the file */
+    const char *body; /**< The first point (after the header) */
+    const char *end; /**< One past the last point */
+    long long length; /**< Number of points (PLY only) */
+    size_t stride; /**< Size of one vertex (PLY only) [bytes] */
+    struct Property fields[NUMBER_OF_FIELDS]; /**< The property of each field (PLY only) */
+    struct OBJ_PointSource point_source; /**< Streams points from the mapped file */
+};
+
+/**
+ * \brief Context shared by all threads loading a point cloud
+ */
+struct LoadContext
+{
+    const struct PCL_PointCloud *point_cloud; /**< The point cloud */
+    struct OBJ_Object *object; /**< The object to fill */
+    int number_of_threads; /**< Number of threads */
+    const char **line_ranges; /**< Range of lines of each thread, number_of_threads + 1 entries (XYZ only) */
+    long long *offsets; /**< Index of the first point of each thread (XYZ only) */
+    int *errors; /**< Non-zero if a thread found a malformed point */
+};
+
+static const char *const property_type_names[NUMBER_OF_PROPERTY_TYPES][2] = {
+    [PROPERTY_TYPE_INT8] = {"char", "int8"},
+    [PROPERTY_TYPE_UINT8] = {"uchar", "uint8"},
+    [PROPERTY_TYPE_INT16] = {"short", "int16"},
+    [PROPERTY_TYPE_UINT16] = {"ushort", "uint16"},
+    [PROPERTY_TYPE_INT32] = {"int", "int32"},
+    [PROPERTY_TYPE_UINT32] = {"uint", "uint32"},
+    [PROPERTY_TYPE_FLOAT32] = {"float", "float32"},
+    [PROPERTY_TYPE_FLOAT64] = {"double", "float64"},
+};
+
+static const size_t property_type_sizes[NUMBER_OF_PROPERTY_TYPES] = {
+    [PROPERTY_TYPE_INT8] = 1,
+    [PROPERTY_TYPE_UINT8] = 1,
+    [PROPERTY_TYPE_INT16] = 2,
+    [PROPERTY_TYPE_UINT16] = 2,
+    [PROPERTY_TYPE_INT32] = 4,
+    [PROPERTY_TYPE_UINT32] = 4,
+    [PROPERTY_TYPE_FLOAT32] = 4,
+    [PROPERTY_TYPE_FLOAT64] = 8,
+};
+
+static const char *const field_names[NUMBER_OF_FIELDS] = {"x", "y", "z", "nx", "ny", "nz"};
+
+/**
+ * \brief Get the start of the next line
+ *
+ * \param[in] line Any position in the current line
+ * \param[in] end The end of the file
+ *
+ * \return The start of the next line, end if there is no next line
+ */
+static const char * get_next_line(
+    const char *const line,
+    const char *const end)
+{
+    const char *const newline = memchr(line, '\n', (size_t)(end - line));
+
+    return (newline == NULL) ? end : (newline + 1);
+}
+
+/**
+ * \brief Parse a decimal floating point number
+ *
+ * Unlike strtod() this function never reads past the end, which is needed since the mapped file
+ * is not null terminated.
+ *
+ * \param[in,out] cursor The position to parse from, advanced past the number
+ * \param[in] end The end of the text
+ * \param[out] value The number
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int parse_number(
+    const char **const cursor,
+    const char *const end,
+    double *const value)
+{
+    const char *c = *cursor;
+
+    while ((c < end) && ((*c == ' ') || (*c == '\t')))
+    {
+        ++c;
+    }
+
+    const double sign = ((c < end) && (*c == '-')) ? -1.0 : 1.0;
+
+    if ((c < end) && ((*c == '-') || (*c == '+')))
+    {
+        ++c;
+    }
+
+    double mantissa = 0.0;
+    int exponent = 0;
+    int digits = 0;
+
+    for (; (c < end) && isdigit((unsigned char)*c); ++c, ++digits)
+    {
+        mantissa = (mantissa * 10.0) + (*c - '0');
+    }
+
+    if ((c < end) && (*c == '.'))
+    {
+        for (++c; (c < end) && isdigit((unsigned char)*c); ++c, ++digits, --exponent)
+        {
+            mantissa = (mantissa * 10.0) + (*c - '0');
+        }
+    }
+
+    if (digits == 0)
+    {
+        return -1;
+    }
+
+    if ((c < end) && ((*c == 'e') || (*c == 'E')))
+    {
+        ++c;
+
+        const int exponent_sign = ((c < end) && (*c == '-')) ? -1 : 1;
+
+        if ((c < end) && ((*c == '-') || (*c == '+')))
+        {
+            ++c;
+        }
+
+        int explicit_exponent = 0;
+        int exponent_digits = 0;
+
+        for (; (c < end) && isdigit((unsigned char)*c); ++c, ++exponent_digits)
+        {
+            explicit_exponent = (explicit_exponent < MAX_EXPONENT) ? ((explicit_exponent * 10) + (*c - '0')) : MAX_EXPONENT;
+        }
+
+        if (exponent_digits == 0)
+        {
+            return -1;
+        }
+
+        exponent += exponent_sign * explicit_exponent;
+    }
+
+    /* Dividing by an exact power of ten gives correctly rounded results for most numbers. */
+    *value = sign * ((exponent < 0) ? (mantissa / pow(10.0, -exponent)) : (mantissa * pow(10.0, exponent)));
+    *cursor = c;
+
+    return 0;
+}
+
+/**
+ * \brief Check if a XYZ line contains a point
+ *
+ * \param[in] line The start of the line
+ * \param[in] end The end of the file
+ *
+ * \return Non-zero value if the line contains a point, 0 if it is empty or a comment
+ */
+static int is_point_line(
+    const char *line,
+    const char *const end)
+{
+    while ((line < end) && ((*line == ' ') || (*line == '\t') || (*line == '\r')))
+    {
+        ++line;
+    }
+
+    return (line < end) && (*line != '\n') && (*line != '#');
+}
+
+/**
+ * \brief Parse a point from a XYZ line
+ *
+ * \param[in] line The start of the line
+ * \param[in] end The end of the file
+ * \param[out] coordinate The coordinate of the point
+ * \param[out] surface_normal The surface normal of the point
+ *
+ * \return 0 on success a non-zero value if the line is malformed
+ */
+static int parse_point_line(
+    const char *line,
+    const char *const end,
+    struct COORD_Coordinate3D *const coordinate,
+    struct COORD_Coordinate3D *const surface_normal)
+{
+    double values[NUMBER_OF_FIELDS];
+
+    for (int i = 0; i < NUMBER_OF_FIELDS; ++i)
+    {
+        if (parse_number(&line, end, &values[i]) != 0)
+        {
+            return -1;
+        }
+    }
+
+    coordinate->x = values[FIELD_X];
+    coordinate->y = values[FIELD_Y];
+    coordinate->z = values[FIELD_Z];
+    surface_normal->x = values[FIELD_NX];
+    surface_normal->y = values[FIELD_NY];
+    surface_normal->z = values[FIELD_NZ];
+
+    return 0;
+}
+
+/**
+ * \brief Read a PLY property
+ *
+ * \param[in] vertex The start of the vertex
+ * \param[in] property The property
+ *
+ * \return The value of the property
+ */
+static double read_property(
+    const char *const vertex,
+    const struct Property *const property)
+{
+    const char *const data = &vertex[property->offset];
+
+    switch (property->type)
+    {
+        case PROPERTY_TYPE_INT8: {int8_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_UINT8: {uint8_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_INT16: {int16_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_UINT16: {uint16_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_INT32: {int32_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_UINT32: {uint32_t value; memcpy(&value, data, sizeof(value)); return value;}
+        case PROPERTY_TYPE_FLOAT32: {float value; memcpy(&value, data, sizeof(value)); return (double)value;}
+        case PROPERTY_TYPE_FLOAT64: {double value; memcpy(&value, data, sizeof(value)); return value;}
+        case NUMBER_OF_PROPERTY_TYPES: // LCOV_EXCL_LINE
+        default: // LCOV_EXCL_LINE
+            assert(0); // LCOV_EXCL_LINE
+            return 0.0; // LCOV_EXCL_LINE
+    }
+}
+
+/**
+ * \brief Convert a range of PLY vertices
+ *
+ * \param[in] point_cloud The point cloud
+ * \param[in] first The index of the first vertex
+ * \param[in] length The number of vertices
+ * \param[out] coordinates The coordinates
+ * \param[out] surface_normals The surface normals
+ */
+static void convert_vertices(
+    const struct PCL_PointCloud *const point_cloud,
+    const long long first,
+    const long long length,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals)
+{
+    const struct Property *const fields = point_cloud->fields;
+
+    for (long long i = 0; i < length; ++i)
+    {
+        const char *const vertex = &point_cloud->body[(size_t)(first + i) * point_cloud->stride];
+
+        coordinates[i].x = read_property(vertex, &fields[FIELD_X]);
+        coordinates[i].y = read_property(vertex, &fields[FIELD_Y]);
+        coordinates[i].z = read_property(vertex, &fields[FIELD_Z]);
+        surface_normals[i].x = read_property(vertex, &fields[FIELD_NX]);
+        surface_normals[i].y = read_property(vertex, &fields[FIELD_NY]);
+        surface_normals[i].z = read_property(vertex, &fields[FIELD_NZ]);
+    }
+}
+
+/**
+ * \brief Read the next chunk of points from a PLY file, see struct OBJ_PointSource
+ *
+ * The position is the index of the next vertex.
+ */
+static long long read_ply_points(
+    const void *const context,
+    long long *const position,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals,
+    const long long max_points)
+{
+    const struct PCL_PointCloud *const point_cloud = context;
+    const long long remaining = point_cloud->length - *position;
+    const long long length = (remaining < max_points) ? remaining : max_points;
+
+    if (length <= 0)
+    {
+        return 0;
+    }
+
+    convert_vertices(point_cloud, *position, length, coordinates, surface_normals);
+    *position += length;
+
+    return length;
+}
+
+/**
+ * \brief Read the next chunk of points from a XYZ file, see struct OBJ_PointSource
+ *
+ * The position is the offset of the next line from the start of the file.
+ */
+static long long read_xyz_points(
+    const void *const context,
+    long long *const position,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals,
+    const long long max_points)
+{
+    const struct PCL_PointCloud *const point_cloud = context;
+    const char *line = &point_cloud->body[*position];
+    long long length = 0;
+
+    while ((line < point_cloud->end) && (length < max_points))
+    {
+        if (is_point_line(line, point_cloud->end) &&
+            (parse_point_line(line, point_cloud->end, &coordinates[length], &surface_normals[length]) == 0))
+        {
+            ++length;
+        }
+
+        line = get_next_line(line, point_cloud->end);
+    }
+
+    *position = line - point_cloud->body;
+
+    return length;
+}
+
+/**
+ * \brief Get the type of a PLY property from its name
+ *
+ * \param[in] name The name of the type
+ * \param[out] type The type
+ *
+ * \return 0 on success a non-zero value if the type is not supported
+ */
+static int get_property_type(
+    const char *const name,
+    enum PropertyType *const type)
+{
+    for (int i = 0; i < NUMBER_OF_PROPERTY_TYPES; ++i)
+    {
+        if ((strcmp(name, property_type_names[i][0]) == 0) || (strcmp(name, property_type_names[i][1]) == 0))
+        {
+            *type = (enum PropertyType)i;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Parse the header of a PLY file
+ *
+ * \param[in,out] point_cloud The point cloud, the PLY specific members are set
+ *
+ * \return 0 on success a non-zero value if the header is malformed or not supported
+ */
+static int parse_ply_header(
+    struct PCL_PointCloud *const point_cloud)
+{
+    const char *const end = &point_cloud->data[point_cloud->size];
+    const char *line = get_next_line(point_cloud->data, end); /* Skip the magic line. */
+    int found_fields[NUMBER_OF_FIELDS] = {0};
+    int is_little_endian = 0;
+    int has_end_header = 0;
+    int number_of_elements = 0;
+
+    while (line < end)
+    {
+        const char *const newline = memchr(line, '\n', (size_t)(end - line));
+        char buffer[MAX_HEADER_LINE_LENGTH];
+
+        if ((newline == NULL) || ((size_t)(newline - line) >= sizeof(buffer)))
+        {
+            return -1;
+        }
+
+        const size_t line_length = (size_t)(newline - line);
+
+        memcpy(buffer, line, line_length);
+        buffer[line_length] = '\0';
+        line = newline + 1;
+
+        char keyword[32] = "";
+        char first[32] = "";
+        char second[32] = "";
+        const int tokens = sscanf(buffer, "%31s %31s %31s", keyword, first, second);
+
+        if ((tokens < 1) || (strcmp(keyword, "comment") == 0) || (strcmp(keyword, "obj_info") == 0))
+        {
+            continue;
+        }
+
+        if (strcmp(keyword, "end_header") == 0)
+        {
+            has_end_header = 1;
+            break;
+        }
+
+        if (strcmp(keyword, "format") == 0)
+        {
+            is_little_endian = (tokens >= 2) && (strcmp(first, "binary_little_endian") == 0);
+        }
+        else if (strcmp(keyword, "element") == 0)
+        {
+            ++number_of_elements;
+
+            if ((number_of_elements == 1) && ((tokens < 3) || (strcmp(first, "vertex") != 0)))
+            {
+                return -1; /* The vertices must be the first element. */
+            }
+
+            if (number_of_elements == 1)
+            {
+                char *number_end = NULL;
+                point_cloud->length = strtoll(second, &number_end, 10);
+
+                if ((*number_end != '\0') || (point_cloud->length < 0))
+                {
+                    return -1;
+                }
+            }
+        }
+        else if ((strcmp(keyword, "property") == 0) && (number_of_elements == 1))
+        {
+            enum PropertyType type;
+
+            if ((tokens < 3) || (get_property_type(first, &type) != 0))
+            {
+                return -1; /* List properties are not supported for vertices. */
+            }
+
+            for (int i = 0; i < NUMBER_OF_FIELDS; ++i)
+            {
+                if (strcmp(second, field_names[i]) == 0)
+                {
+                    point_cloud->fields[i].type = type;
+                    point_cloud->fields[i].offset = point_cloud->stride;
+                    found_fields[i] = 1;
+                }
+            }
+
+            point_cloud->stride += property_type_sizes[type];
+        }
+    }
+
+    for (int i = 0; i < NUMBER_OF_FIELDS; ++i)
+    {
+        if (!found_fields[i])
+        {
+            return -1;
+        }
+    }
+
+    point_cloud->body = line;
+
+    const size_t body_size = (size_t)(end - line);
+
+    return !has_end_header ||
+        !is_little_endian ||
+        (point_cloud->stride == 0U) ||
+        ((size_t)point_cloud->length > (body_size / point_cloud->stride));
+}
+
+/**
+ * \brief Check if this machine uses little endian byte order
+ *
+ * \return Non-zero value if little endian
+ */
+static int is_little_endian_machine(void)
+{
+    const uint16_t value = 1U;
+    uint8_t first_byte = 0U;
+    memcpy(&first_byte, &value, sizeof(first_byte));
+
+    return first_byte == 1U;
+}
+
+/**
+ * \brief Convert a range of PLY vertices in one thread, see PAR_Task
+ *
+ * \param[in,out] context The load context (struct LoadContext)
+ * \param[in] thread The index of the thread
+ */
+static void load_ply_vertices(
+    void *const context,
+    const int thread)
+{
+    const struct LoadContext *const load = context;
+    const long long length = load->point_cloud->length;
+    const long long first = (length * thread) / load->number_of_threads;
+    const long long last = (length * (thread + 1)) / load->number_of_threads;
+
+    convert_vertices(
+        load->point_cloud,
+        first,
+        last - first,
+        &load->object->coordinates[first],
+        &load->object->surface_normals[first]);
+}
+
+/**
+ * \brief Count the points in a range of XYZ lines in one thread, see PAR_Task
+ *
+ * \param[in,out] context The load context (struct LoadContext)
+ * \param[in] thread The index of the thread
+ */
+static void count_xyz_points(
+    void *const context,
+    const int thread)
+{
+    const struct LoadContext *const load = context;
+    const char *const end = load->line_ranges[thread + 1];
+    long long count = 0;
+
+    for (const char *line = load->line_ranges[thread]; line < end; line = get_next_line(line, end))
+    {
+        count += is_point_line(line, end);
+    }
+
+    load->offsets[thread + 1] = count;
+}
+
+/**
+ * \brief Parse the points in a range of XYZ lines in one thread, see PAR_Task
+ *
+ * \param[in,out] context The load context (struct LoadContext)
+ * \param[in] thread The index of the thread
+ */
+static void parse_xyz_points(
+    void *const context,
+    const int thread)
+{
+    const struct LoadContext *const load = context;
+    const char *const end = load->line_ranges[thread + 1];
+    long long index = load->offsets[thread];
+
+    for (const char *line = load->line_ranges[thread]; line < end; line = get_next_line(line, end))
+    {
+        if (is_point_line(line, end))
+        {
+            if (parse_point_line(line, end, &load->object->coordinates[index], &load->object->surface_normals[index]) != 0)
+            {
+                load->errors[thread] = 1;
+                return;
+            }
+
+            ++index;
+        }
+    }
+}
+
+/**
+ * \brief Allocate an object
+ *
+ * \param[in] length The number of points
+ *
+ * \return Object
+ */
+static struct OBJ_Object * allocate_object(
+    const long long length)
+{
+    struct OBJ_Object *const object = calloc(1, sizeof(*object));
+
+    object->length = length;
+    object->coordinates = calloc((size_t)length, sizeof(*object->coordinates));
+    object->surface_normals = calloc((size_t)length, sizeof(*object->surface_normals));
+
+    return object;
+}
+
+struct PCL_PointCloud * PCL_open(
+    const char *const path)
+{
+    if (!is_little_endian_machine())
+    {
+        return NULL; // LCOV_EXCL_LINE
+    }
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat file_status;
+
+    if ((fstat(fd, &file_status) != 0) || (file_status.st_size <= 0))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t size = (size_t)file_status.st_size;
+    char *const data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd); /* The mapping keeps a reference to the file. */
+
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    struct PCL_PointCloud *const point_cloud = calloc(1, sizeof(*point_cloud));
+    static const char ply_magic[] = "ply\n";
+
+    point_cloud->data = data;
+    point_cloud->size = size;
+    point_cloud->end = &data[size];
+    point_cloud->point_source.context = point_cloud;
+
+    if ((size >= (sizeof(ply_magic) - 1)) && (memcmp(data, ply_magic, sizeof(ply_magic) - 1) == 0))
+    {
+        point_cloud->format = FORMAT_PLY;
+        point_cloud->point_source.read = read_ply_points;
+
+        if (parse_ply_header(point_cloud) != 0)
+        {
+            PCL_close(point_cloud);
+            return NULL;
+        }
+    }
+    else
+    {
+        point_cloud->format = FORMAT_XYZ;
+        point_cloud->point_source.read = read_xyz_points;
+        point_cloud->body = data;
+    }
+
+    return point_cloud;
+}
+
+void PCL_close(
+    struct PCL_PointCloud *const point_cloud)
+{
+    munmap(point_cloud->data, point_cloud->size);
+    free(point_cloud);
+}
+
+struct OBJ_Object * PCL_load(
+    const struct PCL_PointCloud *const point_cloud)
+{
+    const long long body_size = point_cloud->end - point_cloud->body;
+    const long long needed_threads = (body_size / MIN_BYTES_PER_THREAD) + 1;
+    const int number_of_threads = PAR_get_number_of_threads(
+        (needed_threads < MAX_NUMBER_OF_THREADS) ? (int)needed_threads : MAX_NUMBER_OF_THREADS);
+    const char *line_ranges[MAX_NUMBER_OF_THREADS + 1];
+    long long offsets[MAX_NUMBER_OF_THREADS + 1] = {0};
+    int errors[MAX_NUMBER_OF_THREADS] = {0};
+    struct LoadContext context = {
+        .point_cloud = point_cloud,
+        .number_of_threads = number_of_threads,
+        .line_ranges = line_ranges,
+        .offsets = offsets,
+        .errors = errors
+    };
+
+    if (point_cloud->format == FORMAT_PLY)
+    {
+        context.object = allocate_object(point_cloud->length);
+        PAR_run(load_ply_vertices, &context, number_of_threads);
+    }
+    else
+    {
+        /* Split the file in ranges of whole lines. Each thread first counts its points, then the
+         * points are parsed directly to their final position in the object. */
+        line_ranges[0] = point_cloud->body;
+
+        for (int t = 1; t < number_of_threads; ++t)
+        {
+            const char *const split = &point_cloud->body[(body_size * t) / number_of_threads];
+            const char *const line = get_next_line((split > line_ranges[t - 1]) ? (split - 1) : split, point_cloud->end);
+
+            line_ranges[t] = (line > line_ranges[t - 1]) ? line : line_ranges[t - 1];
+        }
+
+        line_ranges[number_of_threads] = point_cloud->end;
+
+        PAR_run(count_xyz_points, &context, number_of_threads);
+
+        for (int t = 0; t < number_of_threads; ++t)
+        {
+            offsets[t + 1] += offsets[t];
+        }
+
+        context.object = allocate_object(offsets[number_of_threads]);
+        PAR_run(parse_xyz_points, &context, number_of_threads);
+    }
+
+    for (int t = 0; t < number_of_threads; ++t)
+    {
+        if (errors[t])
+        {
+            PCL_free_object(context.object);
+            return NULL;
+        }
+    }
+
+    OBJ_update_bounds(context.object);
+
+    return context.object;
+}
+
+void PCL_free_object(
+    struct OBJ_Object *const object)
+{
+    free(object->surface_normals);
+    free(object->coordinates);
+    free(object);
+}
+
+const struct OBJ_PointSource * PCL_get_point_source(
+    const struct PCL_PointCloud *const point_cloud)
+{
+    return &point_cloud->point_source;
+}
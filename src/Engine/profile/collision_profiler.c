@@ -0,0 +1,121 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/collision.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RADIUS (0.5)
+#define DENSITY (0.05) /* Number of bodies per cubic meter */
+#define REPETITIONS (5)
+/* Sweep and prune along one axis checks a slab of the bodies per body, i.e. quadratic time for
+ * uniformly spread bodies, it is only measured up to this number of bodies. */
+#define MAX_SWEEP_AND_PRUNE_LENGTH (100000)
+
+/**
+ * \brief Find pairs of bodies, see COLL_find_pairs_spatial_hash()
+ */
+typedef int (*FindPairs)(
+    struct COLL_BroadPhase *broad_phase,
+    const struct COLL_Body *bodies,
+    int length,
+    const struct COLL_Pair **pairs);
+
+/**
+ * \brief Get the time difference between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The difference [ms]
+ */
+static double get_elapsed_ms(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e3) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-6);
+}
+
+/**
+ * \brief Measure the time to find the pairs, the best of a few repetitions
+ *
+ * \param[in] find_pairs The broad phase method
+ * \param[in,out] broad_phase The broad phase
+ * \param[in] bodies The bodies
+ * \param[in] length The number of bodies
+ * \param[out] number_of_pairs The number of found pairs
+ *
+ * \return The time [ms]
+ */
+static double measure(
+    const FindPairs find_pairs,
+    struct COLL_BroadPhase *const broad_phase,
+    const struct COLL_Body *const bodies,
+    const int length,
+    int *const number_of_pairs)
+{
+    double best_ms = INFINITY;
+
+    for (int i = 0; i < REPETITIONS; ++i)
+    {
+        const struct COLL_Pair *pairs = NULL;
+        struct timespec start;
+        struct timespec end;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        *number_of_pairs = find_pairs(broad_phase, bodies, length, &pairs);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        best_ms = fmin(best_ms, get_elapsed_ms(&start, &end));
+    }
+
+    return best_ms;
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    static const int lengths[] = {10000, 100000, 1000000};
+
+    /* The bodies are spread uniformly with a constant density, i.e. the number of pairs grows
+     * linearly with the number of bodies. */
+    printf("%-10s %-10s %15s %15s %15s\n", "bodies", "pairs", "spatial hash", "sweep & prune", "Mbodies/s");
+
+    for (size_t i = 0; i < LENGTH(lengths); ++i)
+    {
+        const int length = lengths[i];
+        const double side = cbrt(length / DENSITY);
+        struct COLL_Body *const bodies = calloc((size_t)length, sizeof(*bodies));
+        struct COLL_BroadPhase *const broad_phase = COLL_create();
+
+        srand(1);
+
+        for (int j = 0; j < length; ++j)
+        {
+            bodies[j].position.x = side * rand() / RAND_MAX;
+            bodies[j].position.y = side * rand() / RAND_MAX;
+            bodies[j].position.z = side * rand() / RAND_MAX;
+            bodies[j].radius = RADIUS;
+        }
+
+        int number_of_pairs = 0;
+        const double spatial_hash_ms =
+            measure(COLL_find_pairs_spatial_hash, broad_phase, bodies, length, &number_of_pairs);
+        const double sweep_and_prune_ms = (length <= MAX_SWEEP_AND_PRUNE_LENGTH) ?
+            measure(COLL_find_pairs_sweep_and_prune, broad_phase, bodies, length, &number_of_pairs) : NAN;
+
+        printf("%-10d %-10d %12.2lf ms %12.2lf ms %15.1lf\n",
+            length,
+            number_of_pairs,
+            spatial_hash_ms,
+            sweep_and_prune_ms,
+            length / (spatial_hash_ms * 1e3));
+
+        COLL_destroy(broad_phase);
+        free(bodies);
+    }
+}
@@ -0,0 +1,163 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/camera.h>
+#include <Engine/object.h>
+#include <Engine/object_optimization.h>
+#include <Engine/renderer.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SCREEN_WIDTH (200)
+#define SCREEN_HEIGHT (60)
+#define FRAMES (5)
+#define SPHERE_POINTS (2000)
+#define MAX_INSTANCES (8000)
+
+/**
+ * \brief Create a sphere with evenly spread points (a Fibonacci lattice) in Morton order
+ *
+ * \param[in] radius The radius of the sphere
+ * \param[in] length The number of points
+ * \param[out] sphere The sphere, free the coordinates and surface normals when it is not used
+ */
+static void create_sphere(
+    const double radius,
+    const long long length,
+    struct OBJ_Object *const sphere)
+{
+    struct COORD_Coordinate3D *const coordinates = calloc((size_t)length, sizeof(*coordinates));
+    struct COORD_Coordinate3D *const surface_normals = calloc((size_t)length, sizeof(*surface_normals));
+    const double golden_angle = M_PI * (3.0 - sqrt(5.0));
+
+    for (long long i = 0; i < length; ++i)
+    {
+        const double latitude = acos(1.0 - (2.0 * ((double)i + 0.5) / (double)length));
+        const double longitude = golden_angle * (double)i;
+        struct COORD_Coordinate3D *const normal = &surface_normals[i];
+
+        normal->x = sin(latitude) * cos(longitude);
+        normal->y = cos(latitude);
+        normal->z = sin(latitude) * sin(longitude);
+        coordinates[i].x = radius * normal->x;
+        coordinates[i].y = radius * normal->y;
+        coordinates[i].z = radius * normal->z;
+    }
+
+    sphere->coordinates = coordinates;
+    sphere->surface_normals = surface_normals;
+    sphere->length = length;
+    sphere->sample_spacing = radius * sqrt(4.0 * M_PI / (double)length);
+    OBJ_update_bounds(sphere);
+    OBJOPT_sort_morton(sphere);
+}
+
+/**
+ * \brief Get the time difference between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The difference [ms]
+ */
+static double get_elapsed_ms(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e3) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-6);
+}
+
+/**
+ * \brief Measure the frame time of a scene, the instances are rotated a bit every frame
+ *
+ * \param[in] sphere The object of all instances
+ * \param[in,out] rotations The rotations of the instances
+ * \param[in] positions The positions of the instances
+ * \param[in] length The number of instances
+ * \param[in] is_instanced Non-zero to draw the spheres as instances, zero to draw one object per sphere
+ *
+ * \return The average frame time [ms]
+ */
+static double measure(
+    const struct OBJ_Object *const sphere,
+    struct CST_Rotation3D *const rotations,
+    const struct COORD_Coordinate3D *const positions,
+    const int length,
+    const int is_instanced)
+{
+    const struct COORD_Coordinate2D optical_center = {.x = SCREEN_WIDTH / 2.0, .y = SCREEN_HEIGHT / 2.0};
+    const struct COORD_Coordinate3D translation = {.x = 0.0, .y = 0.0, .z = 0.0};
+    const struct CST_Rotation3D rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0};
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    struct CAM_CameraParameters calibration;
+    CAM_get_camera_calibration(9.0, 20.0, 1.0, &optical_center, &translation, &rotation, &calibration);
+
+    struct REND_Renderer *const renderer = REND_create(&calibration, SCREEN_WIDTH, SCREEN_HEIGHT, 1.0);
+    struct REND_ObjectWithPosition *const objects = calloc((size_t)length, sizeof(*objects));
+    const struct REND_Instances instances = {
+        .object = sphere, .positions = positions, .rotations = rotations, .length = length};
+    const struct REND_Objects model = is_instanced ?
+        (struct REND_Objects){.instances = &instances, .number_of_instances = 1} :
+        (struct REND_Objects){.objects = objects, .length = length};
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < FRAMES; ++i)
+    {
+        for (int j = 0; j < length; ++j)
+        {
+            rotations[j].yaw = (0.1 * i) + (0.01 * j);
+            objects[j] = (struct REND_ObjectWithPosition){
+                .object = sphere, .position = positions[j], .rotation = rotations[j]};
+        }
+
+        REND_render_frame(renderer, &light_source, &model);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    free(objects);
+    REND_destroy(renderer);
+
+    return get_elapsed_ms(&start, &end) / FRAMES;
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    struct OBJ_Object sphere;
+    create_sphere(0.05, SPHERE_POINTS, &sphere);
+
+    /* A cloud of small spheres in front of the camera, e.g. debris or particles */
+    struct COORD_Coordinate3D *const positions = calloc(MAX_INSTANCES, sizeof(*positions));
+    struct CST_Rotation3D *const rotations = calloc(MAX_INSTANCES, sizeof(*rotations));
+    srand(1);
+
+    for (int i = 0; i < MAX_INSTANCES; ++i)
+    {
+        positions[i].x = 6.0 * (((double)rand() / RAND_MAX) - 0.5);
+        positions[i].y = 2.0 * (((double)rand() / RAND_MAX) - 0.5);
+        positions[i].z = 3.0 + (5.0 * (double)rand() / RAND_MAX);
+    }
+
+    printf("%-10s %15s %15s\n", "instances", "instanced", "objects");
+
+    for (int length = 1000; length <= MAX_INSTANCES; length *= 2)
+    {
+        const double instanced_ms = measure(&sphere, rotations, positions, length, 1);
+        const double objects_ms = measure(&sphere, rotations, positions, length, 0);
+
+        printf("%-10d %12.1lf ms %12.1lf ms\n", length, instanced_ms, objects_ms);
+    }
+
+    free(rotations);
+    free(positions);
+    free(sphere.surface_normals);
+    free(sphere.coordinates);
+}
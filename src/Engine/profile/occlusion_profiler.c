@@ -0,0 +1,170 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/camera.h>
+#include <Engine/object.h>
+#include <Engine/object_optimization.h>
+#include <Engine/renderer.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SCREEN_WIDTH (200)
+#define SCREEN_HEIGHT (60)
+#define FRAMES (10)
+#define GRID_SIDE (6) /* The small spheres are placed in a grid of this many spheres per side */
+#define NUMBER_OF_SMALL_SPHERES (GRID_SIDE * GRID_SIDE)
+#define SMALL_SPHERE_POINTS (50000)
+#define LARGE_SPHERE_POINTS (200000)
+
+/**
+ * \brief Create a sphere with evenly spread points (a Fibonacci lattice) in Morton order
+ *
+ * \param[in] radius The radius of the sphere
+ * \param[in] length The number of points
+ * \param[out] sphere The sphere, free the coordinates and surface normals when it is not used
+ */
+static void create_sphere(
+    const double radius,
+    const long long length,
+    struct OBJ_Object *const sphere)
+{
+    struct COORD_Coordinate3D *const coordinates = calloc((size_t)length, sizeof(*coordinates));
+    struct COORD_Coordinate3D *const surface_normals = calloc((size_t)length, sizeof(*surface_normals));
+    const double golden_angle = M_PI * (3.0 - sqrt(5.0));
+
+    for (long long i = 0; i < length; ++i)
+    {
+        const double latitude = acos(1.0 - (2.0 * ((double)i + 0.5) / (double)length));
+        const double longitude = golden_angle * (double)i;
+        struct COORD_Coordinate3D *const normal = &surface_normals[i];
+
+        normal->x = sin(latitude) * cos(longitude);
+        normal->y = cos(latitude);
+        normal->z = sin(latitude) * sin(longitude);
+        coordinates[i].x = radius * normal->x;
+        coordinates[i].y = radius * normal->y;
+        coordinates[i].z = radius * normal->z;
+    }
+
+    sphere->coordinates = coordinates;
+    sphere->surface_normals = surface_normals;
+    sphere->length = length;
+    sphere->sample_spacing = radius * sqrt(4.0 * M_PI / (double)length);
+    OBJ_update_bounds(sphere);
+    OBJOPT_sort_morton(sphere);
+}
+
+/**
+ * \brief Get the time difference between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The difference [ms]
+ */
+static double get_elapsed_ms(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e3) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-6);
+}
+
+/**
+ * \brief Measure the frame time of a scene, the objects are rotated a bit every frame
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in,out] objects The objects of the scene
+ * \param[in] length The number of objects
+ *
+ * \return The average frame time [ms]
+ */
+static double measure(
+    struct REND_Renderer *const renderer,
+    struct REND_ObjectWithPosition *const objects,
+    const int length)
+{
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_Objects model = {.objects = objects, .length = length};
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < FRAMES; ++i)
+    {
+        for (int j = 0; j < length; ++j)
+        {
+            objects[j].rotation.yaw = 0.1 * i;
+        }
+
+        REND_render_frame(renderer, &light_source, &model);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return get_elapsed_ms(&start, &end) / FRAMES;
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    const struct COORD_Coordinate2D optical_center = {.x = SCREEN_WIDTH / 2.0, .y = SCREEN_HEIGHT / 2.0};
+    const struct COORD_Coordinate3D translation = {.x = 0.0, .y = 0.0, .z = 0.0};
+    const struct CST_Rotation3D rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0};
+    struct CAM_CameraParameters calibration;
+    CAM_get_camera_calibration(9.0, 20.0, 1.0, &optical_center, &translation, &rotation, &calibration);
+
+    struct OBJ_Object small_sphere;
+    struct OBJ_Object large_sphere;
+    create_sphere(0.15, SMALL_SPHERE_POINTS, &small_sphere);
+    create_sphere(1.0, LARGE_SPHERE_POINTS, &large_sphere);
+
+    /* Hidden: the small spheres are behind the large sphere. Visible: only the small spheres,
+     * spread over the screen, i.e. only the back of each sphere is hidden. */
+    struct REND_ObjectWithPosition hidden[NUMBER_OF_SMALL_SPHERES + 1] = {
+        {.object = &large_sphere, .position = {.x = 0.0, .y = 0.0, .z = 3.0}},
+    };
+    struct REND_ObjectWithPosition visible[NUMBER_OF_SMALL_SPHERES];
+
+    for (int i = 0; i < NUMBER_OF_SMALL_SPHERES; ++i)
+    {
+        const double column = (i % GRID_SIDE) - ((GRID_SIDE - 1) / 2.0);
+        const double row = (i / GRID_SIDE) - ((GRID_SIDE - 1) / 2.0);
+
+        hidden[i + 1] = (struct REND_ObjectWithPosition){
+            .object = &small_sphere, .position = {.x = 0.25 * column, .y = 0.1 * row, .z = 8.0}};
+        visible[i] = (struct REND_ObjectWithPosition){
+            .object = &small_sphere, .position = {.x = 1.0 * column, .y = 0.35 * row, .z = 3.0}};
+    }
+
+    printf("%-10s %15s %15s\n", "scene", "culling", "no culling");
+
+    const char *const names[] = {"hidden", "visible"};
+    struct REND_ObjectWithPosition *const scenes[] = {hidden, visible};
+    const int lengths[] = {LENGTH(hidden), LENGTH(visible)};
+
+    for (size_t i = 0; i < LENGTH(scenes); ++i)
+    {
+        double frame_ms[2];
+
+        for (int is_enabled = 1; is_enabled >= 0; --is_enabled)
+        {
+            struct REND_Renderer *const renderer = REND_create(&calibration, SCREEN_WIDTH, SCREEN_HEIGHT, 1.0);
+
+            REND_set_occlusion_culling(renderer, is_enabled);
+            frame_ms[is_enabled] = measure(renderer, scenes[i], lengths[i]);
+            REND_destroy(renderer);
+        }
+
+        printf("%-10s %12.1lf ms %12.1lf ms\n", names[i], frame_ms[1], frame_ms[0]);
+    }
+
+    free(large_sphere.surface_normals);
+    free(large_sphere.coordinates);
+    free(small_sphere.surface_normals);
+    free(small_sphere.coordinates);
+}
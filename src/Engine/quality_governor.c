@@ -0,0 +1,71 @@
+/**
+ * \file
+ * \brief Quality governor implementation
+ */
+#include "quality_governor.h"
+
+#include <stdlib.h>
+
+#define SMOOTHING (0.25) /* Weight of the latest frame in the smoothed load */
+#define HIGH_LOAD (0.95) /* The quality is lowered above this smoothed load */
+/* The quality is raised below this smoothed load. Raising the quality one level roughly doubles
+ * the load, so this must be well below half of HIGH_LOAD to not oscillate. */
+#define LOW_LOAD (0.4)
+#define HOLD_FRAMES (10) /* Number of frames without changes after a change */
+
+/**
+ * \brief Quality governor
+ */
+struct QGOV_QualityGovernor
+{
+    int level; /**< The current quality level */
+    double smoothed_load; /**< Exponential moving average of the load */
+    int hold_frames; /**< Number of frames left until the level may change again */
+};
+
+struct QGOV_QualityGovernor * QGOV_create(void)
+{
+    struct QGOV_QualityGovernor *const governor = calloc(1, sizeof(*governor));
+
+    governor->level = 0;
+    governor->smoothed_load = 0.0;
+    governor->hold_frames = 0;
+
+    return governor;
+}
+
+void QGOV_destroy(
+    struct QGOV_QualityGovernor *const governor)
+{
+    free(governor);
+}
+
+int QGOV_update(
+    struct QGOV_QualityGovernor *const governor,
+    const double load)
+{
+    governor->smoothed_load = (SMOOTHING * load) + ((1.0 - SMOOTHING) * governor->smoothed_load);
+
+    if (governor->hold_frames > 0)
+    {
+        --governor->hold_frames;
+    }
+    else if ((governor->smoothed_load > HIGH_LOAD) && (governor->level < QGOV_MAX_LEVEL))
+    {
+        ++governor->level;
+        governor->hold_frames = HOLD_FRAMES;
+    }
+    else if ((governor->smoothed_load < LOW_LOAD) && (governor->level > 0))
+    {
+        --governor->level;
+        governor->hold_frames = HOLD_FRAMES;
+    }
+
+    return governor->level;
+}
+
+int QGOV_get_level(
+    const struct QGOV_QualityGovernor *const governor)
+{
+    return governor->level;
+}
@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Quality governor interface
+ *
+ * Adapts the render quality to the measured frame times. The quality is lowered one level at a
+ * time when the frames take longer than the frame time budget, and raised again when there is
+ * plenty of headroom. The thresholds for lowering and raising the quality are far apart
+ * (hysteresis) and each change is followed by a number of frames without changes, so that the
+ * quality does not oscillate between two levels.
+ */
+#ifndef ENGINE_QUALITYGOVERNOR_H
+#define ENGINE_QUALITYGOVERNOR_H
+
+#define QGOV_MAX_LEVEL (3) /**< The lowest quality level, level 0 is full quality */
+
+struct QGOV_QualityGovernor;
+
+/**
+ * \brief Create a quality governor, starts at full quality
+ *
+ * \return Quality governor
+ */
+struct QGOV_QualityGovernor * QGOV_create(void);
+
+/**
+ * \brief Destroy a quality governor
+ *
+ * \param[in] governor The quality governor to destroy, do not use it anymore
+ */
+void QGOV_destroy(
+    struct QGOV_QualityGovernor *governor);
+
+/**
+ * \brief Update the quality level with the load of a frame
+ *
+ * \param[in,out] governor The quality governor
+ * \param[in] load The time of the frame as a fraction of the frame time budget, e.g. 2 if the frame
+ *                 took twice as long as it should
+ *
+ * \return The quality level to use for the next frame, in range [0, QGOV_MAX_LEVEL]
+ */
+int QGOV_update(
+    struct QGOV_QualityGovernor *governor,
+    double load);
+
+/**
+ * \brief Get the current quality level
+ *
+ * \param[in] governor The quality governor
+ *
+ * \return The quality level, in range [0, QGOV_MAX_LEVEL]
+ */
+int QGOV_get_level(
+    const struct QGOV_QualityGovernor *governor);
+
+#endif /* ENGINE_QUALITYGOVERNOR_H */
@@ -0,0 +1,167 @@
+/**
+ * \file
+ * \brief Rasterizer implementation
+ */
+#include "rasterizer.h"
+
+#include <Base/coordinates.h>
+#include <Base/math_functions.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <math.h>
+
+#define MIN_TRIANGLE_AREA (1e-12) /* Triangles with a smaller area [pixels^2] are degenerate */
+#define PIXEL_RADIUS (0.5) /* Distance from the center of a pixel to its sides [pixels] */
+
+/**
+ * \brief Evaluate the edge function of the edge from a to b at a point
+ *
+ * The edge function is positive on one side of the edge, negative on the other side and zero on
+ * the edge. Its magnitude is twice the area of the triangle spanned by the edge and the point.
+ *
+ * \param[in] a The start of the edge
+ * \param[in] b The end of the edge
+ * \param[in] x The x coordinate of the point
+ * \param[in] y The y coordinate of the point
+ *
+ * \return The edge function
+ */
+static double edge_function(
+    const struct COORD_Coordinate2D *const a,
+    const struct COORD_Coordinate2D *const b,
+    const double x,
+    const double y)
+{
+    return ((b->x - a->x) * (y - a->y)) - ((b->y - a->y) * (x - a->x));
+}
+
+/**
+ * \brief Get the pixels touched by the extent of a triangle along one axis, clamped to the screen
+ *
+ * \param[in] a First vertex coordinate
+ * \param[in] b Second vertex coordinate
+ * \param[in] c Third vertex coordinate
+ * \param[in] size The number of pixels along the axis
+ * \param[out] begin The first pixel covered by the extent
+ * \param[out] end The last pixel covered by the extent, less than begin if no pixel is covered
+ */
+static void get_pixel_extent(
+    const double a,
+    const double b,
+    const double c,
+    const int size,
+    int *const begin,
+    int *const end)
+{
+    const double min = fmin(a, fmin(b, c));
+    const double max = fmax(a, fmax(b, c));
+
+    *begin = (int)fmax(ceil(min - PIXEL_RADIUS), 0.0);
+    *end = (int)fmin(floor(max + PIXEL_RADIUS), (double)(size - 1));
+}
+
+void RAST_draw_triangle(
+    const struct RAST_Vertex *const vertices[3],
+    const RAST_Shader shader,
+    struct MAT_Matrix *const frame_buffer,
+    struct MAT_Matrix *const z_buffer)
+{
+    assert(frame_buffer->rows == z_buffer->rows); // LCOV_EXCL_LINE
+    assert(frame_buffer->cols == z_buffer->cols); // LCOV_EXCL_LINE
+
+    const struct COORD_Coordinate2D *const p0 = &vertices[0]->image_coordinate;
+    const struct COORD_Coordinate2D *const p1 = &vertices[1]->image_coordinate;
+    const struct COORD_Coordinate2D *const p2 = &vertices[2]->image_coordinate;
+
+    if ((vertices[0]->depth <= 0.0) || (vertices[1]->depth <= 0.0) || (vertices[2]->depth <= 0.0))
+    {
+        return;
+    }
+
+    const double area = edge_function(p0, p1, p2->x, p2->y);
+
+    if (fabs(area) < MIN_TRIANGLE_AREA)
+    {
+        return;
+    }
+
+    int x_begin;
+    int x_end;
+    int y_begin;
+    int y_end;
+    get_pixel_extent(p0->x, p1->x, p2->x, frame_buffer->cols, &x_begin, &x_end);
+    get_pixel_extent(p0->y, p1->y, p2->y, frame_buffer->rows, &y_begin, &y_end);
+
+    /* Dividing the edge functions by the area gives the barycentric weights of the vertices, which
+     * are all non-negative inside the triangle regardless of the winding order. */
+    const double inverse_area = 1.0 / area;
+    const double inverse_depth[] = {1.0 / vertices[0]->depth, 1.0 / vertices[1]->depth, 1.0 / vertices[2]->depth};
+    const double step_x[] = {
+        (p1->y - p2->y) * inverse_area,
+        (p2->y - p0->y) * inverse_area,
+        (p0->y - p1->y) * inverse_area
+    };
+    const double step_y[] = {
+        (p2->x - p1->x) * inverse_area,
+        (p0->x - p2->x) * inverse_area,
+        (p1->x - p0->x) * inverse_area
+    };
+    /* A pixel is drawn if the triangle overlaps any part of it (conservative rasterization), not
+     * only its center. This matches points, which are drawn to the pixel they are closest to, so a
+     * mesh covers the same pixels as a densely sampled object. A weight is at most this much larger
+     * at the corner of a pixel than at its center. */
+    const double tolerance[] = {
+        -PIXEL_RADIUS * (fabs(step_x[0]) + fabs(step_y[0])),
+        -PIXEL_RADIUS * (fabs(step_x[1]) + fabs(step_y[1])),
+        -PIXEL_RADIUS * (fabs(step_x[2]) + fabs(step_y[2]))
+    };
+
+    const double min_depth = fmin(vertices[0]->depth, fmin(vertices[1]->depth, vertices[2]->depth));
+    const double max_depth = fmax(vertices[0]->depth, fmax(vertices[1]->depth, vertices[2]->depth));
+    const double min_illumination =
+        fmin(vertices[0]->illumination, fmin(vertices[1]->illumination, vertices[2]->illumination));
+    const double max_illumination =
+        fmax(vertices[0]->illumination, fmax(vertices[1]->illumination, vertices[2]->illumination));
+
+    for (int y = y_begin; y <= y_end; ++y)
+    {
+        double weight[] = {
+            edge_function(p1, p2, x_begin, y) * inverse_area,
+            edge_function(p2, p0, x_begin, y) * inverse_area,
+            edge_function(p0, p1, x_begin, y) * inverse_area
+        };
+
+        for (int x = x_begin; x <= x_end; ++x)
+        {
+            if ((weight[0] >= tolerance[0]) && (weight[1] >= tolerance[1]) && (weight[2] >= tolerance[2]))
+            {
+                /* The weights are extrapolated for pixels whose center is outside the triangle,
+                 * the result is clamped to the values of the vertices to not extrapolate too far
+                 * for triangles seen from the side. */
+                const double interpolated_depth = 1.0 / (
+                    (weight[0] * inverse_depth[0]) +
+                    (weight[1] * inverse_depth[1]) +
+                    (weight[2] * inverse_depth[2]));
+                const double depth = MATH_clamp(interpolated_depth, min_depth, max_depth);
+
+                if (depth < MAT_get_element(z_buffer, y, x))
+                {
+                    const double interpolated_illumination =
+                        (weight[0] * vertices[0]->illumination) +
+                        (weight[1] * vertices[1]->illumination) +
+                        (weight[2] * vertices[2]->illumination);
+                    const double illumination =
+                        MATH_clamp(interpolated_illumination, min_illumination, max_illumination);
+
+                    MAT_set_element(frame_buffer, y, x, (double)shader(illumination));
+                    MAT_set_element(z_buffer, y, x, depth);
+                }
+            }
+
+            weight[0] += step_x[0];
+            weight[1] += step_x[1];
+            weight[2] += step_x[2];
+        }
+    }
+}
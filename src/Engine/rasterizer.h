@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Rasterizer interface
+ *
+ * Draws triangles to a frame buffer and z buffer. Each pixel that is overlapped by a triangle is
+ * drawn, the depth and illumination are interpolated between the vertices of the triangle.
+ */
+#ifndef ENGINE_RASTERIZER_H
+#define ENGINE_RASTERIZER_H
+
+#include <Base/coordinates.h>
+
+struct MAT_Matrix;
+
+/**
+ * \brief A projected triangle vertex
+ */
+struct RAST_Vertex
+{
+    struct COORD_Coordinate2D image_coordinate; /**< The position of the vertex in the image [pixels] */
+    double depth; /**< The distance from the camera, the vertex is behind the camera if it is not positive */
+    double illumination; /**< The illumination of the vertex [0, 1], see ILL_get_illumination() */
+};
+
+/**
+ * \brief Converts an illumination level to a pixel "color"
+ *
+ * \param[in] illumination The illumination level [0, 1]
+ *
+ * \return Pixel color
+ */
+typedef char (*RAST_Shader)(
+    double illumination);
+
+/**
+ * \brief Draw a triangle
+ *
+ * The triangle is traversed one row (scanline) at a time within its bounding box, clipped to the
+ * screen, and the edge functions are stepped incrementally along each row. The inverse depth is
+ * interpolated linearly in the image, which gives the correct perspective depth, and the
+ * illumination is interpolated linearly (Gouraud shading). A pixel is only drawn if it is closer
+ * than what is already in the z buffer. Triangles with a vertex behind the camera, and degenerate
+ * triangles, are not drawn. The winding order of the vertices does not matter.
+ *
+ * \param[in] vertices The three vertices of the triangle
+ * \param[in] shader Converts the interpolated illumination to the pixel color
+ * \param[in,out] frame_buffer The frame buffer
+ * \param[in,out] z_buffer The z buffer, same size as the frame buffer
+ */
+void RAST_draw_triangle(
+    const struct RAST_Vertex *const vertices[3],
+    RAST_Shader shader,
+    struct MAT_Matrix *frame_buffer,
+    struct MAT_Matrix *z_buffer);
+
+#endif /* ENGINE_RASTERIZER_H */
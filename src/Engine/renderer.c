@@ -2,8 +2,11 @@
  * \file
  * \brief Renderer implementation
  */
+#include "depth_pyramid.h"
 #include "frame_synchronizer.h"
 #include "illumination.h"
+#include "quality_governor.h"
+#include "rasterizer.h"
 
 #include <Base/common.h>
 #include <Base/coordinates.h>
@@ -11,6 +14,7 @@
 #include <Engine/camera.h>
 #include <Engine/coordinate_system_transformations.h>
 #include <Engine/object.h>
+#include <Engine/particles.h>
 #include <Engine/renderer.h>
 #include <LinearAlgebra/Matrix.h>
 
@@ -18,6 +22,64 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define STREAM_CHUNK_LENGTH (4096) /* Number of points read from a point source at a time */
+/* Half the side of a splat relative to the sample spacing. Larger than 0.5 to also cover the gaps
+ * between points on a grid that is rotated in the image. */
+#define SPLAT_SCALE (0.75)
+#define PIXEL_RADIUS (0.5) /* Distance from the center of a pixel to its sides [pixels] */
+#define NUMBER_OF_BOX_CORNERS (8)
+#define CAMERA_MATRIX_ROWS (3)
+#define CAMERA_MATRIX_COLS (4)
+/* Reset the entire buffers instead of the drawn rectangle if it covers more of the screen than this */
+#define FULL_RESET_PERCENTAGE (75)
+#define ROTATION_MATRIX_SIZE (9) /* Number of elements in a 3x3 rotation matrix */
+/* Number of instances drawn together, the nearer batches are drawn first and may hide the farther ones */
+#define INSTANCE_BATCH_LENGTH (64)
+#define EMPTY_RECTANGLE ((struct DPYR_Rectangle){.x_begin = 0, .x_end = -1, .y_begin = 0, .y_end = -1})
+
+/**
+ * \brief The position of an object in the draw order
+ */
+struct DrawOrder
+{
+    double depth; /**< The estimated depth of the object */
+    int index; /**< The index of the object in struct REND_Objects */
+};
+
+/**
+ * \brief A placement of an object in the world
+ */
+struct Instance
+{
+    const struct MAT_Matrix *rotation_matrix; /**< The rotation of the instance in the world */
+    const struct COORD_Coordinate3D *position; /**< The world position of the instance */
+    struct DPYR_Rectangle rectangle; /**< The pixels the instance, or a chunk of it, may be drawn to */
+};
+
+/**
+ * \brief The points of an object, either plain or compressed
+ */
+struct Points
+{
+    const struct COORD_Coordinate3D *coordinates; /**< The coordinates, in the object internal coordinate system */
+    const struct COORD_Coordinate3D *surface_normals; /**< The surface normals */
+    /**
+     * Used instead of the coordinates and surface normals if not NULL, the points are then decoded
+     * where they are read
+     */
+    const struct OBJ_CompressedObject *compressed_object;
+};
+
+/**
+ * \brief A static object drawn in the static layer
+ */
+struct StaticObject
+{
+    struct REND_ObjectWithPosition object; /**< The object as it was when the static layer was drawn */
+    double rotation_matrix_data[ROTATION_MATRIX_SIZE]; /**< Copy of the rotation matrix of the object, if any */
+};
 
 /**
  * \brief Renderer
@@ -30,11 +92,62 @@ struct REND_Renderer
      * occlusion as it keeps track of which objects are in front of other objects.
      */
     struct MAT_Matrix *z_buffer;
+    /**
+     * Coarse maximum depths of the z buffer, used to skip objects and chunks of points that are
+     * hidden behind what is already drawn
+     */
+    struct DPYR_DepthPyramid *depth_pyramid;
+    /**
+     * Bounding rectangle of the z buffer cells that have changed since the pyramid was updated,
+     * empty if x_begin is larger than x_end
+     */
+    struct DPYR_Rectangle depth_pyramid_outdated_rectangle;
+    int is_occlusion_culling_enabled; /**< Non-zero if the depth pyramid is used to skip hidden points */
+    /**
+     * Bounding rectangle of the pixels drawn to since the buffers were reset, empty if x_begin is
+     * larger than x_end
+     */
+    struct DPYR_Rectangle drawn_rectangle;
+    struct MAT_Matrix *static_frame_buffer; /**< The static objects drawn on an empty frame */
+    struct MAT_Matrix *static_z_buffer; /**< The z buffer of static_frame_buffer */
+    int has_static_layer; /**< Non-zero if there are static objects, i.e. if the static layer is used */
+    int static_layer_outdated; /**< Non-zero if the static layer must be drawn again, e.g. the camera changed */
+    struct StaticObject *static_objects; /**< The static objects drawn in the static layer */
+    int static_objects_length; /**< Number of static objects in static_objects */
+    int static_objects_capacity; /**< Number of objects that fit in static_objects */
+    struct COORD_Coordinate3D static_light_source; /**< The light source the static layer was drawn with */
     struct MAT_Matrix *camera_matrix; /**< The camera matrix/calibration */
+    /**
+     * The elements of the camera matrix. Points are projected inline with the elements since the
+     * projection is the bulk of the work per point, and it is done for each view, see
+     * REND_render_views().
+     */
+    double camera[CAMERA_MATRIX_ROWS][CAMERA_MATRIX_COLS];
+    double focal_length_x; /**< The focal length in the x direction of the camera [pixels] */
+    double focal_length_y; /**< The focal length in the y direction of the camera [pixels] */
     /**
      * The frame synchronizer, makes sure a certain frame rate is achieved
      */
     struct SYNC_Frame_Synchronizer *frame_synchronizer;
+    /**
+     * Lowers the quality when the frame rate can not be achieved, the quality is lowered by only
+     * drawing every point_stride:th point of the objects with correspondingly larger splats
+     */
+    struct QGOV_QualityGovernor *quality_governor;
+    int point_stride; /**< Only every point_stride:th point of an object is drawn */
+    double spacing_scale; /**< Scale of the sample spacing, compensates for the skipped points */
+    struct COORD_Coordinate3D *chunk_coordinates; /**< Buffer for coordinates read from a point source */
+    struct COORD_Coordinate3D *chunk_surface_normals; /**< Buffer for surface normals read from a point source */
+    struct RAST_Vertex *mesh_vertices; /**< Buffer for the projected vertices of a mesh */
+    long long mesh_vertices_capacity; /**< Number of vertices that fit in mesh_vertices */
+    struct Instance *instances; /**< Buffer for the visible instances of an object */
+    struct Instance *chunk_instances; /**< Buffer for the instances a chunk of points is visible in */
+    struct MAT_Matrix *rotation_matrices; /**< Buffer for the rotation matrices of the instances */
+    double *rotation_matrix_data; /**< The elements of rotation_matrices */
+    struct DrawOrder *instance_order; /**< Buffer for the order the instances are drawn in */
+    int instances_capacity; /**< Number of instances that fit in the instance buffers */
+    struct DrawOrder *draw_order; /**< Buffer for the order the objects are drawn in */
+    int draw_order_capacity; /**< Number of objects that fit in draw_order */
 };
 
 /**
@@ -60,25 +173,176 @@ static void reset_z_buffer(
 }
 
 /**
- * \brief Draw the frame to the screen
+ * \brief Grow a rectangle to also cover another rectangle
  *
- * \param[in] frame_buffer The frame buffer
+ * \param[in,out] bounding_rectangle The rectangle to grow, may be empty
+ * \param[in] rectangle The rectangle to cover
  */
-static void draw_frame(
-    const struct MAT_Matrix *const frame_buffer)
+static void add_rectangle(
+    struct DPYR_Rectangle *const bounding_rectangle,
+    const struct DPYR_Rectangle *const rectangle)
 {
-    printf("\x1b[H");
+    if (bounding_rectangle->x_begin > bounding_rectangle->x_end)
+    {
+        *bounding_rectangle = *rectangle;
+    }
+    else
+    {
+        bounding_rectangle->x_begin =
+            (rectangle->x_begin < bounding_rectangle->x_begin) ? rectangle->x_begin : bounding_rectangle->x_begin;
+        bounding_rectangle->x_end =
+            (rectangle->x_end > bounding_rectangle->x_end) ? rectangle->x_end : bounding_rectangle->x_end;
+        bounding_rectangle->y_begin =
+            (rectangle->y_begin < bounding_rectangle->y_begin) ? rectangle->y_begin : bounding_rectangle->y_begin;
+        bounding_rectangle->y_end =
+            (rectangle->y_end > bounding_rectangle->y_end) ? rectangle->y_end : bounding_rectangle->y_end;
+    }
+}
 
-    for (int y = 0; y < frame_buffer->rows; ++y)
+/**
+ * \brief Mark the entire depth pyramid as outdated, e.g. after the entire z buffer is reset
+ *
+ * \param[in,out] renderer The renderer
+ */
+static void mark_depth_pyramid_outdated(
+    struct REND_Renderer *const renderer)
+{
+    renderer->depth_pyramid_outdated_rectangle = (struct DPYR_Rectangle){
+        .x_begin = 0,
+        .x_end = renderer->z_buffer->cols - 1,
+        .y_begin = 0,
+        .y_end = renderer->z_buffer->rows - 1
+    };
+}
+
+/**
+ * \brief Reset the pixels that were drawn to in the previous frame
+ *
+ * Only the bounding rectangle of the drawn pixels is reset, which saves a lot of work for small
+ * objects on a large screen. The entire buffers are reset if most of the screen was drawn to. The
+ * pixels are reset to the static layer if there is one, otherwise they are cleared.
+ *
+ * \param[in,out] renderer The renderer
+ */
+static void reset_drawn_rectangle(
+    struct REND_Renderer *const renderer)
+{
+    const struct DPYR_Rectangle *const drawn = &renderer->drawn_rectangle;
+
+    if ((drawn->x_begin <= drawn->x_end) && renderer->has_static_layer)
     {
-        for (int x = 0; x < frame_buffer->cols; ++x)
+        const int width = drawn->x_end - drawn->x_begin + 1;
+        const int height = drawn->y_end - drawn->y_begin + 1;
+
+        MAT_copy_block(
+            renderer->static_frame_buffer, drawn->y_begin, drawn->x_begin, height, width, renderer->frame_buffer);
+        MAT_copy_block(renderer->static_z_buffer, drawn->y_begin, drawn->x_begin, height, width, renderer->z_buffer);
+    }
+    else if (drawn->x_begin <= drawn->x_end)
+    {
+        const int width = drawn->x_end - drawn->x_begin + 1;
+        const int height = drawn->y_end - drawn->y_begin + 1;
+        const long long area = (long long)width * height;
+        const long long screen_area = (long long)renderer->frame_buffer->cols * renderer->frame_buffer->rows;
+
+        if (area > (screen_area * FULL_RESET_PERCENTAGE) / 100)
         {
-            putchar((char)MAT_get_element(frame_buffer, y, x));
+            reset_frame_buffer(renderer->frame_buffer);
+            reset_z_buffer(renderer->z_buffer);
+        }
+        else
+        {
+            MAT_set_block_elements(
+                renderer->frame_buffer, drawn->y_begin, drawn->x_begin, height, width, (double)' ');
+            MAT_set_block_elements(renderer->z_buffer, drawn->y_begin, drawn->x_begin, height, width, INFINITY);
+        }
+    }
+
+    /* Only the drawn pixels of the z buffer are changed, the rest is already reset */
+    if (drawn->x_begin <= drawn->x_end)
+    {
+        add_rectangle(&renderer->depth_pyramid_outdated_rectangle, drawn);
+    }
+
+    renderer->drawn_rectangle = EMPTY_RECTANGLE;
+}
+
+/**
+ * \brief Set the camera of a renderer
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] calibration The camera parameters/calibration
+ */
+static void set_camera(
+    struct REND_Renderer *const renderer,
+    const struct CAM_CameraParameters *const calibration)
+{
+    renderer->camera_matrix = CAM_get_camera_matrix(calibration);
+    renderer->focal_length_x = calibration->intrinsic.focal_length_x;
+    renderer->focal_length_y = calibration->intrinsic.focal_length_y;
+
+    for (int row = 0; row < CAMERA_MATRIX_ROWS; ++row)
+    {
+        for (int col = 0; col < CAMERA_MATRIX_COLS; ++col)
+        {
+            renderer->camera[row][col] = MAT_get_element(renderer->camera_matrix, row, col);
         }
-        putchar('\n');
     }
 }
 
+/**
+ * \brief Get the depth of a world coordinate, i.e. its distance to the camera along the optical axis
+ *
+ * The depth is the z coordinate in the camera coordinate system, it is what the z buffer holds and
+ * what the splats are scaled with. Coordinates with a depth of 0 or less are behind the camera.
+ *
+ * \param[in] renderer The renderer
+ * \param[in] world_coordinate The world coordinate
+ *
+ * \return The depth [m]
+ */
+static double get_depth(
+    const struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const world_coordinate)
+{
+    const double *const row = renderer->camera[2];
+
+    return (row[0] * world_coordinate->x) + (row[1] * world_coordinate->y) + (row[2] * world_coordinate->z) + row[3];
+}
+
+/**
+ * \brief Project a world coordinate to the image, see CST_world_coordinate_to_image_coordinate()
+ *
+ * Gives the same image coordinate as CST_world_coordinate_to_image_coordinate() without allocating
+ * the homogeneous vectors.
+ *
+ * \param[in] renderer The renderer
+ * \param[in] world_coordinate The world coordinate
+ * \param[in] depth The depth of the world coordinate, see get_depth(), must be in front of the camera
+ * \param[out] image_coordinate The image coordinate
+ */
+static void project(
+    const struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const world_coordinate,
+    const double depth,
+    struct COORD_Coordinate2D *const image_coordinate)
+{
+    assert(depth > 0.0); // LCOV_EXCL_LINE
+
+    const double (*const camera)[CAMERA_MATRIX_COLS] = renderer->camera;
+    const double x = world_coordinate->x;
+    const double y = world_coordinate->y;
+    const double z = world_coordinate->z;
+    const double u = (camera[0][0] * x) + (camera[0][1] * y) + (camera[0][2] * z) + camera[0][3];
+    const double v = (camera[1][0] * x) + (camera[1][1] * y) + (camera[1][2] * z) + camera[1][3];
+
+    image_coordinate->x = u / depth;
+    image_coordinate->y = v / depth;
+}
+
+/** The pixel colors of the illumination levels, from dark to bright */
+static const char illumination_levels[] = {'.', ',', '-', '~', ':', ';', '=', '!', '*', '#', '$', '@'};
+
 /**
  * \brief Converts an illumination level to a certain pixel "color"
  *
@@ -89,7 +353,6 @@ static void draw_frame(
 static char convert_illumination_to_pixel_color(
     const double illumination)
 {
-    static const char illumination_levels[] = {'.', ',', '-', '~', ':', ';', '=', '!', '*', '#', '$', '@'};
     const int lenght = LENGTH(illumination_levels);
     const double luminance_index = (illumination * lenght);
     const int clamped_luminance_index = (int)MATH_clamp(luminance_index, 0, lenght - 1);
@@ -99,120 +362,1377 @@ static char convert_illumination_to_pixel_color(
 }
 
 /**
- * \brief Render a single pixel given a world coordinate.
+ * \brief Render a single point given a world coordinate.
+ *
+ * The point is drawn as a square splat covering the gap to its neighbors, the size of the splat in
+ * the image shrinks with the distance. All covered pixels get the depth of the point. A point
+ * without sample spacing covers only the pixel closest to it.
  *
  * \param[in,out] renderer The renderer
  * \param[in] world_coordinate The world coordinate
  * \param[in] color The color of the pixel
+ * \param[in] sample_spacing The distance to the neighboring points [m], see struct OBJ_Object
  */
-static void render_pixel(
+static void render_point(
     struct REND_Renderer *const renderer,
     const struct COORD_Coordinate3D *const world_coordinate,
-    const char color)
+    const char color,
+    const double sample_spacing)
 {
     assert(renderer->frame_buffer->rows == renderer->z_buffer->rows); // LCOV_EXCL_LINE
     assert(renderer->frame_buffer->cols == renderer->z_buffer->cols); // LCOV_EXCL_LINE
 
-    const double distance = world_coordinate->z;
+    const double distance = get_depth(renderer, world_coordinate);
 
     if (distance > 0.0)
     {
         struct COORD_Coordinate2D image_coordinate;
-        CST_world_coordinate_to_image_coordinate(world_coordinate, renderer->camera_matrix, &image_coordinate);
+        project(renderer, world_coordinate, distance, &image_coordinate);
 
-        const int x = (int)round(image_coordinate.x);
-        const int y = (int)round(image_coordinate.y);
+        /* Rounding to the closest pixel already covers half a pixel in each direction. */
+        const double splat_size = SPLAT_SCALE * sample_spacing / distance;
+        const double half_width = fmax((splat_size * renderer->focal_length_x) - PIXEL_RADIUS, 0.0);
+        const double half_height = fmax((splat_size * renderer->focal_length_y) - PIXEL_RADIUS, 0.0);
+        const int x_begin = (int)fmax(round(image_coordinate.x - half_width), 0.0);
+        const int x_end = (int)fmin(round(image_coordinate.x + half_width), renderer->frame_buffer->cols - 1.0);
+        const int y_begin = (int)fmax(round(image_coordinate.y - half_height), 0.0);
+        const int y_end = (int)fmin(round(image_coordinate.y + half_height), renderer->frame_buffer->rows - 1.0);
 
-        if ((y >= 0) && (y < renderer->frame_buffer->rows) && (x >= 0) && (x < renderer->frame_buffer->cols))
+        for (int y = y_begin; y <= y_end; ++y)
         {
-            if (distance < MAT_get_element(renderer->z_buffer, y, x))
+            for (int x = x_begin; x <= x_end; ++x)
             {
-                MAT_set_element(renderer->frame_buffer, y, x, (double)color);
-                MAT_set_element(renderer->z_buffer, y, x, distance);
+                if (distance < MAT_get_element(renderer->z_buffer, y, x))
+                {
+                    MAT_set_element(renderer->frame_buffer, y, x, (double)color);
+                    MAT_set_element(renderer->z_buffer, y, x, distance);
+                }
             }
         }
     }
 }
 
 /**
- * \brief Render an entire object
+ * \brief Get a point
+ *
+ * \param[in] points The points
+ * \param[in] index The index of the point
+ * \param[out] coordinate The coordinate, in the object internal coordinate system
+ * \param[out] surface_normal The surface normal
+ */
+static void get_point(
+    const struct Points *const points,
+    const long long index,
+    struct COORD_Coordinate3D *const coordinate,
+    struct COORD_Coordinate3D *const surface_normal)
+{
+    if (points->compressed_object != NULL)
+    {
+        OBJ_get_compressed_point(points->compressed_object, index, coordinate, surface_normal);
+    }
+    else
+    {
+        *coordinate = points->coordinates[index];
+        *surface_normal = points->surface_normals[index];
+    }
+}
+
+/**
+ * \brief Get the bounding box of a range of points
+ *
+ * \param[in] points The points
+ * \param[in] begin The index of the first point
+ * \param[in] length The number of points
+ * \param[out] bounds The bounding box, in the object internal coordinate system
+ */
+static void get_bounds(
+    const struct Points *const points,
+    const long long begin,
+    const long long length,
+    struct OBJ_BoundingBox *const bounds)
+{
+    if (points->compressed_object != NULL)
+    {
+        OBJ_get_compressed_bounds(points->compressed_object, begin, length, bounds);
+    }
+    else
+    {
+        OBJ_get_bounds(&points->coordinates[begin], length, bounds);
+    }
+}
+
+/**
+ * \brief Render a set of points for one or more instances of an object
+ *
+ * The points are iterated in the outer loop and the instances in the inner loop, so each point is
+ * read from memory once regardless of the number of instances.
  *
  * \param[in,out] renderer The renderer
- * \param[in] object The object to render
- * \param[in] position The world position of the object
+ * \param[in] light_source The position of the light source
+ * \param[in] points The points of the object
+ * \param[in] begin The index of the first point
+ * \param[in] length The number of points
+ * \param[in] sample_spacing The distance between neighboring points [m], see struct OBJ_Object
+ * \param[in] instances The rotations and positions of the object in the world
+ * \param[in] number_of_instances The number of instances
  */
-static void render_object(
+static void render_points(
     struct REND_Renderer *const renderer,
     const struct COORD_Coordinate3D *const light_source,
-    const struct OBJ_Object *const object,
+    const struct Points *const points,
+    const long long begin,
+    const long long length,
+    const double sample_spacing,
+    const struct Instance *const instances,
+    const int number_of_instances)
+{
+    for (long long i = 0; i < length; i += renderer->point_stride)
+    {
+        struct COORD_Coordinate3D coordinate;
+        struct COORD_Coordinate3D object_surface_normal;
+        get_point(points, begin + i, &coordinate, &object_surface_normal);
+
+        for (int j = 0; j < number_of_instances; ++j)
+        {
+            const struct Instance *const instance = &instances[j];
+
+            struct COORD_Coordinate3D world_position;
+            CST_affine_transformation(&coordinate, instance->rotation_matrix, instance->position, &world_position);
+
+            struct COORD_Coordinate3D surface_normal;
+            CST_linear_transformation(&object_surface_normal, instance->rotation_matrix, &surface_normal);
+
+            const double illumination = ILL_get_illumination(light_source, &world_position, &surface_normal);
+            const char color = convert_illumination_to_pixel_color(illumination);
+
+            render_point(renderer, &world_position, color, sample_spacing);
+        }
+    }
+}
+
+/**
+ * \brief Set a rectangle to the entire screen
+ *
+ * \param[in] renderer The renderer
+ * \param[out] rectangle The rectangle
+ */
+static void get_screen_rectangle(
+    const struct REND_Renderer *const renderer,
+    struct DPYR_Rectangle *const rectangle)
+{
+    rectangle->x_begin = 0;
+    rectangle->x_end = renderer->z_buffer->cols - 1;
+    rectangle->y_begin = 0;
+    rectangle->y_end = renderer->z_buffer->rows - 1;
+}
+
+/**
+ * \brief Get the pixels a bounding box may be drawn to, unless it is hidden
+ *
+ * The corners of the box are projected to the image. The box is hidden if the bounding rectangle
+ * of the projected corners is outside the screen or behind what is drawn, which is checked against
+ * the depth pyramid using the depth of the nearest corner, unless occlusion culling is disabled.
+ *
+ * \param[in,out] renderer The renderer, the depth pyramid is updated if it is outdated
+ * \param[in] bounds The bounding box, in the object internal coordinate system
+ * \param[in] sample_spacing The sample spacing of the points in the box, see struct OBJ_Object
+ * \param[in] rotation_matrix The rotation of the object in the world
+ * \param[in] position The world position of the object
+ * \param[out] rectangle The pixels that may be drawn to, the entire screen if the box can not be
+ *                       projected. Only set if the box is visible.
+ *
+ * \return Non-zero if something in the box may be visible
+ */
+static int get_visible_rectangle(
+    struct REND_Renderer *const renderer,
+    const struct OBJ_BoundingBox *const bounds,
+    const double sample_spacing,
+    const struct MAT_Matrix *const rotation_matrix,
     const struct COORD_Coordinate3D *const position,
-    const struct CST_Rotation3D *const rotation)
+    struct DPYR_Rectangle *const rectangle)
 {
-    struct MAT_Matrix *const rotation_matrix = CST_get_extrinsic_rotation_matrix(rotation);
+    if ((bounds->min.x > bounds->max.x) || (bounds->min.y > bounds->max.y) || (bounds->min.z > bounds->max.z))
+    {
+        return 0;
+    }
+
+    double min_depth = INFINITY;
+    struct COORD_Coordinate2D min_image_coordinate = {.x = INFINITY, .y = INFINITY};
+    struct COORD_Coordinate2D max_image_coordinate = {.x = -INFINITY, .y = -INFINITY};
 
-    for (int i = 0; i < object->length; ++i)
+    for (int i = 0; i < NUMBER_OF_BOX_CORNERS; ++i)
     {
-        struct COORD_Coordinate3D world_position;
-        CST_affine_transformation(&object->coordinates[i], rotation_matrix, position, &world_position);
+        const struct COORD_Coordinate3D corner = {
+            .x = ((i & 1) != 0) ? bounds->max.x : bounds->min.x,
+            .y = ((i & 2) != 0) ? bounds->max.y : bounds->min.y,
+            .z = ((i & 4) != 0) ? bounds->max.z : bounds->min.z
+        };
 
-        struct COORD_Coordinate3D surface_normal;
-        CST_linear_transformation(&object->surface_normals[i], rotation_matrix, &surface_normal);
+        struct COORD_Coordinate3D world_corner;
+        CST_affine_transformation(&corner, rotation_matrix, position, &world_corner);
+
+        const double depth = get_depth(renderer, &world_corner);
+
+        if (depth <= 0.0)
+        {
+            /* The box can not be projected if it is (partly) behind the camera. */
+            get_screen_rectangle(renderer, rectangle);
+            return 1;
+        }
+
+        struct COORD_Coordinate2D image_coordinate;
+        project(renderer, &world_corner, depth, &image_coordinate);
+
+        min_depth = fmin(min_depth, depth);
+        min_image_coordinate.x = fmin(min_image_coordinate.x, image_coordinate.x);
+        min_image_coordinate.y = fmin(min_image_coordinate.y, image_coordinate.y);
+        max_image_coordinate.x = fmax(max_image_coordinate.x, image_coordinate.x);
+        max_image_coordinate.y = fmax(max_image_coordinate.y, image_coordinate.y);
+    }
+
+    /* Splats and rounding to the closest pixel draw pixels outside the projected box. */
+    const double splat_size = SPLAT_SCALE * sample_spacing / min_depth;
+    const double margin_x = (splat_size * renderer->focal_length_x) + PIXEL_RADIUS;
+    const double margin_y = (splat_size * renderer->focal_length_y) + PIXEL_RADIUS;
+    const double width = renderer->z_buffer->cols;
+    const double height = renderer->z_buffer->rows;
+
+    rectangle->x_begin = (int)fmin(fmax(floor(min_image_coordinate.x - margin_x), 0.0), width);
+    rectangle->x_end = (int)fmax(fmin(ceil(max_image_coordinate.x + margin_x), width - 1.0), -1.0);
+    rectangle->y_begin = (int)fmin(fmax(floor(min_image_coordinate.y - margin_y), 0.0), height);
+    rectangle->y_end = (int)fmax(fmin(ceil(max_image_coordinate.y + margin_y), height - 1.0), -1.0);
+
+    if ((rectangle->x_begin > rectangle->x_end) || (rectangle->y_begin > rectangle->y_end))
+    {
+        /* Outside the screen */
+        return 0;
+    }
+
+    if (!renderer->is_occlusion_culling_enabled)
+    {
+        return 1;
+    }
 
-        const double illumination = ILL_get_illumination(light_source, &world_position, &surface_normal);
-        const char color = convert_illumination_to_pixel_color(illumination);
+    /* Only the part of the pyramid that covers what has been drawn since the last query is updated,
+     * i.e. typically the pixels of the previous chunk. */
+    struct DPYR_Rectangle *const outdated = &renderer->depth_pyramid_outdated_rectangle;
 
-        render_pixel(renderer, &world_position, color);
+    if (outdated->x_begin <= outdated->x_end)
+    {
+        DPYR_update_rectangle(renderer->depth_pyramid, renderer->z_buffer, outdated);
+        *outdated = EMPTY_RECTANGLE;
     }
 
-    MAT_free(rotation_matrix);
+    return !DPYR_is_hidden(renderer->depth_pyramid, rectangle, min_depth);
 }
 
-struct REND_Renderer * REND_create(
-    const struct CAM_CameraParameters *const calibration,
-    const int screen_width,
-    const int screen_height,
-    const double fps)
+/**
+ * \brief Keep track of pixels that have been drawn to
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] rectangle The pixels that have (possibly) been drawn to
+ */
+static void mark_as_drawn(
+    struct REND_Renderer *const renderer,
+    const struct DPYR_Rectangle *const rectangle)
 {
-    struct REND_Renderer *const renderer = calloc(1, sizeof(*renderer));
+    add_rectangle(&renderer->drawn_rectangle, rectangle);
+    add_rectangle(&renderer->depth_pyramid_outdated_rectangle, rectangle);
+}
 
-    renderer->frame_buffer = MAT_alloc(screen_height, screen_width);
-    renderer->z_buffer = MAT_alloc(screen_height, screen_width);
-    renderer->camera_matrix = CAM_get_camera_matrix(calibration);
-    renderer->frame_synchronizer = SYNC_create(fps);
+/**
+ * \brief Compare the depths of two objects in the draw order, see qsort()
+ *
+ * \param[in] a First object (struct DrawOrder)
+ * \param[in] b Second object (struct DrawOrder)
+ *
+ * \return Negative if a is closer than b, positive if a is farther away than b
+ */
+static int compare_draw_order(
+    const void *const a,
+    const void *const b)
+{
+    const struct DrawOrder *const draw_order_a = a;
+    const struct DrawOrder *const draw_order_b = b;
 
-    return renderer;
+    if (draw_order_a->depth < draw_order_b->depth)
+    {
+        return -1;
+    }
+
+    if (draw_order_a->depth > draw_order_b->depth)
+    {
+        return 1;
+    }
+
+    /* Keep the order of objects at the same depth deterministic. */
+    return draw_order_a->index - draw_order_b->index;
 }
 
-void REND_render(
+/**
+ * \brief Make sure the instance buffers can hold a certain number of instances
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] number_of_instances The number of instances
+ */
+static void reserve_instances(
+    struct REND_Renderer *const renderer,
+    const int number_of_instances)
+{
+    if (number_of_instances > renderer->instances_capacity)
+    {
+        free(renderer->instance_order);
+        free(renderer->rotation_matrix_data);
+        free(renderer->rotation_matrices);
+        free(renderer->chunk_instances);
+        free(renderer->instances);
+        renderer->instances = calloc((size_t)number_of_instances, sizeof(*renderer->instances));
+        renderer->chunk_instances = calloc((size_t)number_of_instances, sizeof(*renderer->chunk_instances));
+        renderer->rotation_matrices = calloc((size_t)number_of_instances, sizeof(*renderer->rotation_matrices));
+        renderer->instance_order = calloc((size_t)number_of_instances, sizeof(*renderer->instance_order));
+        renderer->rotation_matrix_data =
+            calloc((size_t)number_of_instances * ROTATION_MATRIX_SIZE, sizeof(*renderer->rotation_matrix_data));
+
+        for (int i = 0; i < number_of_instances; ++i)
+        {
+            renderer->rotation_matrices[i] = (struct MAT_Matrix){
+                .rows = 3,
+                .cols = 3,
+                .data = &renderer->rotation_matrix_data[i * ROTATION_MATRIX_SIZE]
+            };
+        }
+        renderer->instances_capacity = number_of_instances;
+    }
+}
+
+/**
+ * \brief Render a set of points in chunks, skipping chunks that are hidden
+ *
+ * Works best if points that are close in the array are also close in space, e.g. sorted in Morton
+ * order (see OBJOPT_sort_morton()), since the chunks then have small bounding boxes. Each chunk is
+ * checked against each instance, and drawn for the instances where it may be visible.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] points The points of the object
+ * \param[in] length The number of points
+ * \param[in] sample_spacing The distance between neighboring points [m], see struct OBJ_Object
+ * \param[in] instances The rotations and positions of the object in the world, must not be the
+ *                      chunk_instances buffer of the renderer
+ * \param[in] number_of_instances The number of instances
+ */
+static void render_point_chunks(
     struct REND_Renderer *const renderer,
     const struct COORD_Coordinate3D *const light_source,
-    const struct REND_Objects *const objects)
+    const struct Points *const points,
+    const long long length,
+    const double sample_spacing,
+    const struct Instance *const instances,
+    const int number_of_instances)
 {
-    reset_frame_buffer(renderer->frame_buffer);
-    reset_z_buffer(renderer->z_buffer);
+    assert(instances != renderer->chunk_instances); // LCOV_EXCL_LINE
+    assert(number_of_instances <= renderer->instances_capacity); // LCOV_EXCL_LINE
 
-    for (int i = 0; i < objects->length; ++i)
+    for (long long begin = 0; begin < length; begin += STREAM_CHUNK_LENGTH)
     {
-        const struct REND_ObjectWithPosition *const object_with_position = &objects->objects[i];
+        const long long remaining = length - begin;
+        const long long chunk_length = (remaining < STREAM_CHUNK_LENGTH) ? remaining : STREAM_CHUNK_LENGTH;
+
+        struct OBJ_BoundingBox bounds;
+        get_bounds(points, begin, chunk_length, &bounds);
+
+        int number_of_visible_instances = 0;
 
-        render_object(
+        for (int i = 0; i < number_of_instances; ++i)
+        {
+            struct Instance *const chunk_instance = &renderer->chunk_instances[number_of_visible_instances];
+            *chunk_instance = instances[i];
+
+            if (get_visible_rectangle(
+                renderer,
+                &bounds,
+                sample_spacing,
+                chunk_instance->rotation_matrix,
+                chunk_instance->position,
+                &chunk_instance->rectangle))
+            {
+                ++number_of_visible_instances;
+            }
+        }
+
+        render_points(
             renderer,
             light_source,
-            object_with_position->object,
-            &object_with_position->position,
-            &object_with_position->rotation);
+            points,
+            begin,
+            chunk_length,
+            sample_spacing,
+            renderer->chunk_instances,
+            number_of_visible_instances);
+
+        for (int i = 0; i < number_of_visible_instances; ++i)
+        {
+            mark_as_drawn(renderer, &renderer->chunk_instances[i].rectangle);
+        }
+    }
+}
+
+/**
+ * \brief Render a triangle mesh
+ *
+ * All vertices are transformed, illuminated and projected once, then each triangle is rasterized.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] mesh The mesh
+ * \param[in] rotation_matrix The rotation of the mesh in the world
+ * \param[in] position The world position of the mesh
+ */
+static void render_mesh(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct OBJ_Mesh *const mesh,
+    const struct MAT_Matrix *const rotation_matrix,
+    const struct COORD_Coordinate3D *const position)
+{
+    if (mesh->length > renderer->mesh_vertices_capacity)
+    {
+        free(renderer->mesh_vertices);
+        renderer->mesh_vertices = calloc((size_t)mesh->length, sizeof(*renderer->mesh_vertices));
+        renderer->mesh_vertices_capacity = mesh->length;
     }
 
-    SYNC_sync(renderer->frame_synchronizer);
+    struct RAST_Vertex *const vertices = renderer->mesh_vertices;
 
-    draw_frame(renderer->frame_buffer);
+    for (long long i = 0; i < mesh->length; ++i)
+    {
+        struct COORD_Coordinate3D world_position;
+        CST_affine_transformation(&mesh->coordinates[i], rotation_matrix, position, &world_position);
+
+        struct COORD_Coordinate3D surface_normal;
+        CST_linear_transformation(&mesh->surface_normals[i], rotation_matrix, &surface_normal);
+
+        vertices[i].depth = get_depth(renderer, &world_position);
+        vertices[i].illumination = ILL_get_illumination(light_source, &world_position, &surface_normal);
+
+        if (vertices[i].depth > 0.0)
+        {
+            project(renderer, &world_position, vertices[i].depth, &vertices[i].image_coordinate);
+        }
+    }
+
+    for (long long i = 0; i < mesh->number_of_triangles; ++i)
+    {
+        const long long *const indices = &mesh->indices[3 * i];
+
+        assert((indices[0] < mesh->length) && (indices[1] < mesh->length)); // LCOV_EXCL_LINE
+        assert(indices[2] < mesh->length); // LCOV_EXCL_LINE
+
+        const struct RAST_Vertex *const triangle[] = {
+            &vertices[indices[0]],
+            &vertices[indices[1]],
+            &vertices[indices[2]]
+        };
+
+        RAST_draw_triangle(
+            triangle, convert_illumination_to_pixel_color, renderer->frame_buffer, renderer->z_buffer);
+    }
+}
+
+/**
+ * \brief Get the points of an object that has all its points in memory
+ *
+ * \param[in] object_with_position The object
+ * \param[out] points The points of the object
+ * \param[out] length The number of points
+ * \param[out] sample_spacing The distance between neighboring points [m], see struct OBJ_Object
+ * \param[out] bounds The bounding box of the points, in the object internal coordinate system
+ *
+ * \return Non-zero if the object is an object or a compressed object, i.e. not a point source or a
+ *         mesh. The outputs are only set if it is.
+ */
+static int get_points(
+    const struct REND_ObjectWithPosition *const object_with_position,
+    struct Points *const points,
+    long long *const length,
+    double *const sample_spacing,
+    const struct OBJ_BoundingBox **const bounds)
+{
+    const struct OBJ_Object *const object = object_with_position->object;
+    const struct OBJ_CompressedObject *const compressed_object = object_with_position->compressed_object;
+
+    if (object != NULL)
+    {
+        points->coordinates = object->coordinates;
+        points->surface_normals = object->surface_normals;
+        points->compressed_object = NULL;
+        *length = object->length;
+        *sample_spacing = object->sample_spacing;
+        *bounds = &object->bounds;
+        return 1;
+    }
+
+    if ((object_with_position->point_source == NULL) && (object_with_position->mesh == NULL) &&
+        (compressed_object != NULL))
+    {
+        points->coordinates = NULL;
+        points->surface_normals = NULL;
+        points->compressed_object = compressed_object;
+        *length = compressed_object->length;
+        *sample_spacing = compressed_object->sample_spacing;
+        *bounds = &compressed_object->bounds;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Render an entire object
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] object_with_position The object to render, either an object, a point source, a mesh or a
+ *                                 compressed object
+ */
+static void render_object(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_ObjectWithPosition *const object_with_position)
+{
+    struct MAT_Matrix *const computed_rotation_matrix = (object_with_position->rotation_matrix == NULL) ?
+        CST_get_extrinsic_rotation_matrix(&object_with_position->rotation) : NULL;
+    const struct MAT_Matrix *const rotation_matrix =
+        (computed_rotation_matrix != NULL) ? computed_rotation_matrix : object_with_position->rotation_matrix;
+    struct Instance instance = {.rotation_matrix = rotation_matrix, .position = &object_with_position->position};
+    const struct OBJ_PointSource *const point_source = object_with_position->point_source;
+    const struct OBJ_Mesh *const mesh = object_with_position->mesh;
+    struct Points points;
+    long long length = 0;
+    double sample_spacing = 0.0;
+    const struct OBJ_BoundingBox *bounds = NULL;
+
+    reserve_instances(renderer, 1);
+
+    if (get_points(object_with_position, &points, &length, &sample_spacing, &bounds))
+    {
+        sample_spacing *= renderer->spacing_scale;
+
+        if (get_visible_rectangle(
+            renderer,
+            bounds,
+            sample_spacing,
+            rotation_matrix,
+            &object_with_position->position,
+            &instance.rectangle))
+        {
+            render_point_chunks(renderer, light_source, &points, length, sample_spacing, &instance, 1);
+        }
+    }
+    else if (point_source != NULL)
+    {
+        long long position = 0;
+
+        sample_spacing = point_source->sample_spacing * renderer->spacing_scale;
+
+        const struct Points chunk = {
+            .coordinates = renderer->chunk_coordinates,
+            .surface_normals = renderer->chunk_surface_normals,
+            .compressed_object = NULL
+        };
+
+        while ((length = point_source->read(
+            point_source->context,
+            &position,
+            renderer->chunk_coordinates,
+            renderer->chunk_surface_normals,
+            STREAM_CHUNK_LENGTH)) > 0)
+        {
+            render_point_chunks(renderer, light_source, &chunk, length, sample_spacing, &instance, 1);
+        }
+    }
+    else if (mesh != NULL)
+    {
+        struct DPYR_Rectangle rectangle;
+
+        if (get_visible_rectangle(
+            renderer, &mesh->bounds, 0.0, rotation_matrix, &object_with_position->position, &rectangle))
+        {
+            render_mesh(renderer, light_source, mesh, rotation_matrix, &object_with_position->position);
+
+            mark_as_drawn(renderer, &rectangle);
+        }
+    }
+
+    if (computed_rotation_matrix != NULL)
+    {
+        MAT_free(computed_rotation_matrix);
+    }
+}
+
+/**
+ * \brief Check if a rectangle is empty
+ *
+ * \param[in] rectangle The rectangle
+ *
+ * \return Non-zero if the rectangle is empty
+ */
+static int is_empty(
+    const struct DPYR_Rectangle *const rectangle)
+{
+    return (rectangle->x_begin > rectangle->x_end) || (rectangle->y_begin > rectangle->y_end);
+}
+
+/**
+ * \brief Render a set of points in chunks to several views
+ *
+ * Each point is transformed and illuminated once, and then projected and drawn in each view where
+ * its chunk may be visible.
+ *
+ * \param[in,out] renderers The renderers of the views, the first renderer sets the quality
+ * \param[in] number_of_views The number of views
+ * \param[in] light_source The position of the light source
+ * \param[in] points The points of the object
+ * \param[in] length The number of points
+ * \param[in] sample_spacing The distance between neighboring points [m], see struct OBJ_Object
+ * \param[in] rotation_matrix The rotation of the object in the world
+ * \param[in] position The world position of the object
+ * \param[in] is_object_culled Non-zero if the instance buffer of each view holds the pixels the object
+ *                             may be drawn to in the view, empty if the object is not visible in the
+ *                             view. Zero if the object has no bounds, e.g. a point source.
+ */
+static void render_point_chunks_to_views(
+    struct REND_Renderer *const *const renderers,
+    const int number_of_views,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct Points *const points,
+    const long long length,
+    const double sample_spacing,
+    const struct MAT_Matrix *const rotation_matrix,
+    const struct COORD_Coordinate3D *const position,
+    const int is_object_culled)
+{
+    const int point_stride = renderers[0]->point_stride;
+
+    for (long long begin = 0; begin < length; begin += STREAM_CHUNK_LENGTH)
+    {
+        const long long remaining = length - begin;
+        const long long chunk_length = (remaining < STREAM_CHUNK_LENGTH) ? remaining : STREAM_CHUNK_LENGTH;
+
+        struct OBJ_BoundingBox bounds;
+        get_bounds(points, begin, chunk_length, &bounds);
+
+        int is_visible = 0;
+
+        for (int i = 0; i < number_of_views; ++i)
+        {
+            struct REND_Renderer *const renderer = renderers[i];
+            struct DPYR_Rectangle *const rectangle = &renderer->chunk_instances[0].rectangle;
+
+            if ((is_object_culled && is_empty(&renderer->instances[0].rectangle)) ||
+                !get_visible_rectangle(renderer, &bounds, sample_spacing, rotation_matrix, position, rectangle))
+            {
+                *rectangle = EMPTY_RECTANGLE;
+            }
+
+            is_visible = is_visible || !is_empty(rectangle);
+        }
+
+        if (!is_visible)
+        {
+            continue;
+        }
+
+        for (long long i = 0; i < chunk_length; i += point_stride)
+        {
+            struct COORD_Coordinate3D coordinate;
+            struct COORD_Coordinate3D object_surface_normal;
+            get_point(points, begin + i, &coordinate, &object_surface_normal);
+
+            struct COORD_Coordinate3D world_position;
+            CST_affine_transformation(&coordinate, rotation_matrix, position, &world_position);
+
+            struct COORD_Coordinate3D surface_normal;
+            CST_linear_transformation(&object_surface_normal, rotation_matrix, &surface_normal);
+
+            const double illumination = ILL_get_illumination(light_source, &world_position, &surface_normal);
+            const char color = convert_illumination_to_pixel_color(illumination);
+
+            for (int j = 0; j < number_of_views; ++j)
+            {
+                if (!is_empty(&renderers[j]->chunk_instances[0].rectangle))
+                {
+                    render_point(renderers[j], &world_position, color, sample_spacing);
+                }
+            }
+        }
+
+        for (int i = 0; i < number_of_views; ++i)
+        {
+            if (!is_empty(&renderers[i]->chunk_instances[0].rectangle))
+            {
+                mark_as_drawn(renderers[i], &renderers[i]->chunk_instances[0].rectangle);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Render an entire object to several views
+ *
+ * Objects, compressed objects and point sources are transformed and illuminated once for all
+ * views, see render_point_chunks_to_views(). Meshes are rendered to each view separately.
+ *
+ * \param[in,out] renderers The renderers of the views
+ * \param[in] number_of_views The number of views
+ * \param[in] light_source The position of the light source
+ * \param[in] object_with_position The object to render, either an object, a point source, a mesh or a
+ *                                 compressed object
+ */
+static void render_object_to_views(
+    struct REND_Renderer *const *const renderers,
+    const int number_of_views,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_ObjectWithPosition *const object_with_position)
+{
+    const struct OBJ_PointSource *const point_source = object_with_position->point_source;
+    struct Points points = {.coordinates = NULL, .surface_normals = NULL, .compressed_object = NULL};
+    long long length = 0;
+    double sample_spacing = 0.0;
+    const struct OBJ_BoundingBox *bounds = NULL;
+    const int has_points = get_points(object_with_position, &points, &length, &sample_spacing, &bounds);
+
+    if (!has_points && (point_source == NULL))
+    {
+        for (int i = 0; i < number_of_views; ++i)
+        {
+            render_object(renderers[i], light_source, object_with_position);
+        }
+
+        return;
+    }
+
+    struct MAT_Matrix *const computed_rotation_matrix = (object_with_position->rotation_matrix == NULL) ?
+        CST_get_extrinsic_rotation_matrix(&object_with_position->rotation) : NULL;
+    const struct MAT_Matrix *const rotation_matrix =
+        (computed_rotation_matrix != NULL) ? computed_rotation_matrix : object_with_position->rotation_matrix;
+    int is_visible = 0;
+
+    if (!has_points)
+    {
+        sample_spacing = point_source->sample_spacing;
+    }
+
+    sample_spacing *= renderers[0]->spacing_scale;
+
+    for (int i = 0; i < number_of_views; ++i)
+    {
+        struct REND_Renderer *const renderer = renderers[i];
+
+        reserve_instances(renderer, 1);
+
+        struct DPYR_Rectangle *const rectangle = &renderer->instances[0].rectangle;
+
+        /* A point source is read in chunks, only the chunks are checked */
+        if (has_points &&
+            !get_visible_rectangle(
+                renderer, bounds, sample_spacing, rotation_matrix, &object_with_position->position, rectangle))
+        {
+            *rectangle = EMPTY_RECTANGLE;
+        }
+
+        is_visible = is_visible || (has_points && !is_empty(rectangle));
+    }
+
+    if (has_points)
+    {
+        if (is_visible)
+        {
+            render_point_chunks_to_views(
+                renderers,
+                number_of_views,
+                light_source,
+                &points,
+                length,
+                sample_spacing,
+                rotation_matrix,
+                &object_with_position->position,
+                1);
+        }
+    }
+    else
+    {
+        struct REND_Renderer *const renderer = renderers[0];
+        long long position = 0;
+        const struct Points chunk = {
+            .coordinates = renderer->chunk_coordinates,
+            .surface_normals = renderer->chunk_surface_normals,
+            .compressed_object = NULL
+        };
+
+        while ((length = point_source->read(
+            point_source->context,
+            &position,
+            renderer->chunk_coordinates,
+            renderer->chunk_surface_normals,
+            STREAM_CHUNK_LENGTH)) > 0)
+        {
+            render_point_chunks_to_views(
+                renderers,
+                number_of_views,
+                light_source,
+                &chunk,
+                length,
+                sample_spacing,
+                rotation_matrix,
+                &object_with_position->position,
+                0);
+        }
+    }
+
+    if (computed_rotation_matrix != NULL)
+    {
+        MAT_free(computed_rotation_matrix);
+    }
+}
+
+/**
+ * \brief Render many instances of an object
+ *
+ * The instances are drawn front-to-back in batches. Instances of a batch that are hidden are
+ * skipped, the rest are drawn together so that the points of the object are only read once per
+ * batch, see render_points(). The nearer batches fill the depth pyramid before the farther batches
+ * are checked, like separate objects.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] instances The instances to render
+ */
+static void render_instances(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Instances *const instances)
+{
+    static const struct CST_Rotation3D no_rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0};
+    const struct OBJ_Object *const object = instances->object;
+    const double sample_spacing = object->sample_spacing * renderer->spacing_scale;
+    const struct Points points = {
+        .coordinates = object->coordinates,
+        .surface_normals = object->surface_normals,
+        .compressed_object = NULL
+    };
+
+    reserve_instances(renderer, instances->length);
+
+    for (int i = 0; i < instances->length; ++i)
+    {
+        renderer->instance_order[i].depth = get_depth(renderer, &instances->positions[i]);
+        renderer->instance_order[i].index = i;
+    }
+
+    qsort(renderer->instance_order, (size_t)instances->length, sizeof(*renderer->instance_order), compare_draw_order);
+
+    for (int begin = 0; begin < instances->length; begin += INSTANCE_BATCH_LENGTH)
+    {
+        const int remaining = instances->length - begin;
+        const int end = begin + ((remaining < INSTANCE_BATCH_LENGTH) ? remaining : INSTANCE_BATCH_LENGTH);
+        int number_of_visible_instances = 0;
+
+        for (int i = begin; i < end; ++i)
+        {
+            const int index = renderer->instance_order[i].index;
+            struct Instance *const instance = &renderer->instances[number_of_visible_instances];
+            const struct CST_Rotation3D *const rotation =
+                (instances->rotations != NULL) ? &instances->rotations[index] : &no_rotation;
+
+            CST_set_extrinsic_rotation_matrix(rotation, &renderer->rotation_matrices[i]);
+            instance->rotation_matrix = &renderer->rotation_matrices[i];
+            instance->position = &instances->positions[index];
+
+            if (get_visible_rectangle(
+                renderer,
+                &object->bounds,
+                sample_spacing,
+                instance->rotation_matrix,
+                instance->position,
+                &instance->rectangle))
+            {
+                ++number_of_visible_instances;
+            }
+        }
+
+        render_point_chunks(
+            renderer,
+            light_source,
+            &points,
+            object->length,
+            sample_spacing,
+            renderer->instances,
+            number_of_visible_instances);
+    }
+}
+
+/**
+ * \brief Render the particles of a particle system
+ *
+ * Each particle covers the pixel closest to it and is drawn with its own intensity, i.e. without
+ * illumination, see struct PART_Particles.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] particle_system The particle system
+ */
+static void render_particles(
+    struct REND_Renderer *const renderer,
+    const struct PART_ParticleSystem *const particle_system)
+{
+    struct PART_Particles particles;
+    PART_get_particles(particle_system, &particles);
+
+    const double cols = renderer->frame_buffer->cols;
+    const double rows = renderer->frame_buffer->rows;
+
+    for (int i = 0; i < particles.length; ++i)
+    {
+        const struct COORD_Coordinate3D position = {.x = particles.x[i], .y = particles.y[i], .z = particles.z[i]};
+
+        const double depth = get_depth(renderer, &position);
+
+        if (depth <= 0.0)
+        {
+            continue;
+        }
+
+        struct COORD_Coordinate2D image_coordinate;
+        project(renderer, &position, depth, &image_coordinate);
+
+        const double image_x = round(image_coordinate.x);
+        const double image_y = round(image_coordinate.y);
+
+        if ((image_x < 0.0) || (image_x >= cols) || (image_y < 0.0) || (image_y >= rows))
+        {
+            continue;
+        }
+
+        const int col = (int)image_x;
+        const int row = (int)image_y;
+
+        if (depth < MAT_get_element(renderer->z_buffer, row, col))
+        {
+            const char color = convert_illumination_to_pixel_color(particles.intensity[i]);
+
+            MAT_set_element(renderer->frame_buffer, row, col, (double)color);
+            MAT_set_element(renderer->z_buffer, row, col, depth);
+
+            const struct DPYR_Rectangle pixel = {.x_begin = col, .x_end = col, .y_begin = row, .y_end = row};
+            mark_as_drawn(renderer, &pixel);
+        }
+    }
+}
+
+/**
+ * \brief Set the quality of the objects drawn, see struct QGOV_QualityGovernor
+ *
+ * Each level halves the number of points drawn. The splats are scaled with the increase of the
+ * distance between the drawn points, i.e. the square root of the stride as the points are on a
+ * surface.
+ *
+ * \param[in,out] renderer The renderer
+ * \param[in] level The quality level, 0 is full quality
+ */
+static void set_quality_level(
+    struct REND_Renderer *const renderer,
+    const int level)
+{
+    renderer->point_stride = 1 << level;
+    renderer->spacing_scale = sqrt((double)renderer->point_stride);
+}
+
+/**
+ * \brief Check if an object is the same as a static object, at the same position
+ *
+ * \param[in] object The object
+ * \param[in] static_object The static object
+ *
+ * \return Non-zero if the objects are the same
+ */
+static int is_same_object(
+    const struct REND_ObjectWithPosition *const object,
+    const struct StaticObject *const static_object)
+{
+    const struct REND_ObjectWithPosition *const cached = &static_object->object;
+
+    /* The coordinates are compared bitwise, a spurious difference (e.g. 0.0 and -0.0) only causes the
+     * static layer to be drawn again. The rotation matrix is compared by value since it may have
+     * been modified in place. */
+    return (object->object == cached->object) &&
+        (object->point_source == cached->point_source) &&
+        (object->mesh == cached->mesh) &&
+        (object->compressed_object == cached->compressed_object) &&
+        (object->rotation_matrix == cached->rotation_matrix) &&
+        (memcmp(&object->position, &cached->position, sizeof(object->position)) == 0) &&
+        (memcmp(&object->rotation, &cached->rotation, sizeof(object->rotation)) == 0) &&
+        ((object->rotation_matrix == NULL) ||
+         (memcmp(object->rotation_matrix->data,
+                 static_object->rotation_matrix_data,
+                 sizeof(static_object->rotation_matrix_data)) == 0));
+}
+
+/**
+ * \brief Check if the static layer must be drawn again
+ *
+ * \param[in] renderer The renderer
+ * \param[in] light_source The position of the light source
+ * \param[in] objects The objects to render
+ *
+ * \return Non-zero if the static objects, the light source or the camera have changed
+ */
+static int is_static_layer_outdated(
+    const struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Objects *const objects)
+{
+    if (renderer->static_layer_outdated ||
+        (memcmp(&renderer->static_light_source, light_source, sizeof(*light_source)) != 0))
+    {
+        return 1;
+    }
+
+    int number_of_static_objects = 0;
+
+    for (int i = 0; i < objects->length; ++i)
+    {
+        if (objects->objects[i].is_static)
+        {
+            if ((number_of_static_objects == renderer->static_objects_length) ||
+                !is_same_object(&objects->objects[i], &renderer->static_objects[number_of_static_objects]))
+            {
+                return 1;
+            }
+
+            ++number_of_static_objects;
+        }
+    }
+
+    return number_of_static_objects != renderer->static_objects_length;
+}
+
+/**
+ * \brief Draw the static objects to the static layer
+ *
+ * The static objects are drawn to the (entirely reset) frame buffer and z buffer, which are then
+ * copied to the static layer. The frame buffer and z buffer thus contain the static layer when done.
+ *
+ * \param[in,out] renderer The renderer, the objects must be sorted, see sort_front_to_back()
+ * \param[in] light_source The position of the light source
+ * \param[in] objects The objects to render, only the static objects are drawn
+ */
+static void render_static_layer(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Objects *const objects)
+{
+    if (objects->length > renderer->static_objects_capacity)
+    {
+        free(renderer->static_objects);
+        renderer->static_objects = calloc((size_t)objects->length, sizeof(*renderer->static_objects));
+        renderer->static_objects_capacity = objects->length;
+    }
+
+    renderer->static_objects_length = 0;
+
+    for (int i = 0; i < objects->length; ++i)
+    {
+        const struct REND_ObjectWithPosition *const object = &objects->objects[i];
+        const struct MAT_Matrix *const rotation_matrix = object->rotation_matrix;
+
+        if (object->is_static)
+        {
+            struct StaticObject *const static_object = &renderer->static_objects[renderer->static_objects_length++];
+
+            static_object->object = *object;
+
+            if (rotation_matrix != NULL)
+            {
+                assert((rotation_matrix->rows * rotation_matrix->cols) == ROTATION_MATRIX_SIZE); // LCOV_EXCL_LINE
+                memcpy(
+                    static_object->rotation_matrix_data,
+                    rotation_matrix->data,
+                    sizeof(static_object->rotation_matrix_data));
+            }
+        }
+    }
+
+    reset_frame_buffer(renderer->frame_buffer);
+    reset_z_buffer(renderer->z_buffer);
+    mark_depth_pyramid_outdated(renderer);
+
+    /* The static layer is drawn rarely, so it is always drawn in full quality. */
+    const int point_stride = renderer->point_stride;
+    const double spacing_scale = renderer->spacing_scale;
+    set_quality_level(renderer, 0);
+
+    for (int i = 0; i < objects->length; ++i)
+    {
+        const struct REND_ObjectWithPosition *const object = &objects->objects[renderer->draw_order[i].index];
+
+        if (object->is_static)
+        {
+            render_object(renderer, light_source, object);
+        }
+    }
+
+    const int rows = renderer->frame_buffer->rows;
+    const int cols = renderer->frame_buffer->cols;
+    MAT_copy_block(renderer->frame_buffer, 0, 0, rows, cols, renderer->static_frame_buffer);
+    MAT_copy_block(renderer->z_buffer, 0, 0, rows, cols, renderer->static_z_buffer);
+
+    renderer->point_stride = point_stride;
+    renderer->spacing_scale = spacing_scale;
+
+    renderer->has_static_layer = renderer->static_objects_length > 0;
+    renderer->static_layer_outdated = 0;
+    renderer->static_light_source = *light_source;
+    /* The buffers are identical to the static layer, there is nothing to reset in the next frame. */
+    renderer->drawn_rectangle = EMPTY_RECTANGLE;
+}
+
+/**
+ * \brief Sort the objects front-to-back, so that near objects fill the depth pyramid early
+ *
+ * The depth of an object is estimated by the depth of its position.
+ *
+ * \param[in,out] renderer The renderer, the order is stored in draw_order
+ * \param[in] objects The objects
+ */
+static void sort_front_to_back(
+    struct REND_Renderer *const renderer,
+    const struct REND_Objects *const objects)
+{
+    if (objects->length > renderer->draw_order_capacity)
+    {
+        free(renderer->draw_order);
+        renderer->draw_order = calloc((size_t)objects->length, sizeof(*renderer->draw_order));
+        renderer->draw_order_capacity = objects->length;
+    }
+
+    for (int i = 0; i < objects->length; ++i)
+    {
+        renderer->draw_order[i].depth = get_depth(renderer, &objects->objects[i].position);
+        renderer->draw_order[i].index = i;
+    }
+
+    qsort(renderer->draw_order, (size_t)objects->length, sizeof(*renderer->draw_order), compare_draw_order);
+}
+
+struct REND_Renderer * REND_create(
+    const struct CAM_CameraParameters *const calibration,
+    const int screen_width,
+    const int screen_height,
+    const double fps)
+{
+    struct REND_Renderer *const renderer = calloc(1, sizeof(*renderer));
+
+    renderer->frame_buffer = MAT_alloc(screen_height, screen_width);
+    renderer->z_buffer = MAT_alloc(screen_height, screen_width);
+    reset_frame_buffer(renderer->frame_buffer);
+    reset_z_buffer(renderer->z_buffer);
+    renderer->depth_pyramid = DPYR_create(screen_width, screen_height);
+    renderer->drawn_rectangle = EMPTY_RECTANGLE;
+    mark_depth_pyramid_outdated(renderer);
+    renderer->is_occlusion_culling_enabled = 1;
+    renderer->static_frame_buffer = MAT_alloc(screen_height, screen_width);
+    renderer->static_z_buffer = MAT_alloc(screen_height, screen_width);
+    renderer->static_layer_outdated = 1;
+    set_camera(renderer, calibration);
+    renderer->frame_synchronizer = SYNC_create(fps);
+    renderer->quality_governor = QGOV_create();
+    set_quality_level(renderer, 0);
+    renderer->chunk_coordinates = calloc(STREAM_CHUNK_LENGTH, sizeof(*renderer->chunk_coordinates));
+    renderer->chunk_surface_normals = calloc(STREAM_CHUNK_LENGTH, sizeof(*renderer->chunk_surface_normals));
+
+    return renderer;
+}
+
+void REND_set_occlusion_culling(
+    struct REND_Renderer *const renderer,
+    const int is_enabled)
+{
+    renderer->is_occlusion_culling_enabled = is_enabled;
+}
+
+void REND_set_camera(
+    struct REND_Renderer *const renderer,
+    const struct CAM_CameraParameters *const calibration)
+{
+    MAT_free(renderer->camera_matrix);
+    set_camera(renderer, calibration);
+    renderer->static_layer_outdated = 1;
+}
+
+void REND_render_frame(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Objects *const objects)
+{
+    sort_front_to_back(renderer, objects);
+
+    if (is_static_layer_outdated(renderer, light_source, objects))
+    {
+        render_static_layer(renderer, light_source, objects);
+    }
+    else
+    {
+        reset_drawn_rectangle(renderer);
+    }
+
+    for (int i = 0; i < objects->length; ++i)
+    {
+        const struct REND_ObjectWithPosition *const object = &objects->objects[renderer->draw_order[i].index];
+
+        if (!object->is_static)
+        {
+            render_object(renderer, light_source, object);
+        }
+    }
+
+    for (int i = 0; i < objects->number_of_instances; ++i)
+    {
+        render_instances(renderer, light_source, &objects->instances[i]);
+    }
+
+    for (int i = 0; i < objects->number_of_particle_systems; ++i)
+    {
+        render_particles(renderer, objects->particle_systems[i]);
+    }
+}
+
+void REND_render_views(
+    struct REND_Renderer *const *const renderers,
+    const int number_of_views,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Objects *const objects)
+{
+    assert(number_of_views > 0); // LCOV_EXCL_LINE
+
+    for (int i = 0; i < number_of_views; ++i)
+    {
+        struct REND_Renderer *const renderer = renderers[i];
+
+        sort_front_to_back(renderer, objects);
+
+        if (is_static_layer_outdated(renderer, light_source, objects))
+        {
+            render_static_layer(renderer, light_source, objects);
+        }
+        else
+        {
+            reset_drawn_rectangle(renderer);
+        }
+    }
+
+    /* The draw order only depends on the objects, it is the same in all views */
+    for (int i = 0; i < objects->length; ++i)
+    {
+        const struct REND_ObjectWithPosition *const object = &objects->objects[renderers[0]->draw_order[i].index];
+
+        if (!object->is_static)
+        {
+            render_object_to_views(renderers, number_of_views, light_source, object);
+        }
+    }
+
+    for (int i = 0; i < number_of_views; ++i)
+    {
+        for (int j = 0; j < objects->number_of_instances; ++j)
+        {
+            render_instances(renderers[i], light_source, &objects->instances[j]);
+        }
+
+        for (int j = 0; j < objects->number_of_particle_systems; ++j)
+        {
+            render_particles(renderers[i], objects->particle_systems[j]);
+        }
+    }
+}
+
+void REND_render(
+    struct REND_Renderer *const renderer,
+    const struct COORD_Coordinate3D *const light_source,
+    const struct REND_Objects *const objects)
+{
+    REND_render_frame(renderer, light_source, objects);
+
+    const double load = SYNC_sync(renderer->frame_synchronizer);
+    set_quality_level(renderer, QGOV_update(renderer->quality_governor, load));
+
+    REND_show_frame(renderer->frame_buffer);
+}
+
+const struct MAT_Matrix * REND_get_frame_buffer(
+    const struct REND_Renderer *const renderer)
+{
+    return renderer->frame_buffer;
+}
+
+const struct MAT_Matrix * REND_get_z_buffer(
+    const struct REND_Renderer *const renderer)
+{
+    return renderer->z_buffer;
+}
+
+double REND_get_illumination(
+    const char color)
+{
+    const char *const level = memchr(illumination_levels, color, sizeof(illumination_levels));
+
+    if (level == NULL)
+    {
+        return -1.0;
+    }
+
+    return ((double)(level - illumination_levels) + 0.5) / (double)LENGTH(illumination_levels);
+}
+
+void REND_show_frame(
+    const struct MAT_Matrix *const frame_buffer)
+{
+    printf("\x1b[H");
+
+    for (int y = 0; y < frame_buffer->rows; ++y)
+    {
+        for (int x = 0; x < frame_buffer->cols; ++x)
+        {
+            putchar((char)MAT_get_element(frame_buffer, y, x));
+        }
+        putchar('\n');
+    }
+}
+
+int REND_get_quality_level(
+    const struct REND_Renderer *const renderer)
+{
+    return QGOV_get_level(renderer->quality_governor);
 }
 
 void REND_destroy(
     struct REND_Renderer *const renderer)
 {
+    free(renderer->instance_order);
+    free(renderer->rotation_matrix_data);
+    free(renderer->rotation_matrices);
+    free(renderer->chunk_instances);
+    free(renderer->instances);
+    free(renderer->static_objects);
+    free(renderer->draw_order);
+    free(renderer->mesh_vertices);
+    free(renderer->chunk_surface_normals);
+    free(renderer->chunk_coordinates);
+    QGOV_destroy(renderer->quality_governor);
     SYNC_destroy(renderer->frame_synchronizer);
     MAT_free(renderer->camera_matrix);
+    MAT_free(renderer->static_z_buffer);
+    MAT_free(renderer->static_frame_buffer);
+    DPYR_destroy(renderer->depth_pyramid);
     MAT_free(renderer->z_buffer);
     MAT_free(renderer->frame_buffer);
     free(renderer);
@@ -0,0 +1,201 @@
+/**
+ * \file
+ * \brief Scene graph implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/coordinate_system_transformations.h>
+#include <Engine/renderer.h>
+#include <Engine/scene_graph.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define INITIAL_CAPACITY (16)
+#define NOT_DRAWN (-1) /* The draw index of nodes that have nothing to draw */
+
+/**
+ * \brief Scene graph node
+ */
+struct Node
+{
+    int parent; /**< The parent node, SG_ROOT if the node has no parent */
+    int draw_index; /**< The index of the node in the draw list, NOT_DRAWN if it has nothing to draw */
+    int dirty; /**< Non-zero if the local transform has changed since the world transform was computed */
+    /**
+     * The update (see struct SG_SceneGraph) the world transform was last computed in. The children
+     * of a node that was recomputed in the current update must also be recomputed.
+     */
+    unsigned int update_stamp;
+    struct COORD_Coordinate3D local_position; /**< The position relative to the parent */
+    struct MAT_Matrix *local_rotation; /**< The rotation relative to the parent */
+    struct COORD_Coordinate3D world_position; /**< The cached world position */
+    struct MAT_Matrix *world_rotation; /**< The cached world rotation */
+};
+
+/**
+ * \brief Scene graph
+ */
+struct SG_SceneGraph
+{
+    struct Node *nodes; /**< The nodes, parents are stored before their children */
+    int length; /**< Number of nodes */
+    int capacity; /**< Number of nodes that fit in nodes */
+    struct REND_ObjectWithPosition *draw_list; /**< The nodes that have something to draw */
+    int draw_list_length; /**< Number of objects in the draw list */
+    int draw_list_capacity; /**< Number of objects that fit in the draw list */
+    unsigned int update_stamp; /**< Incremented by each update */
+};
+
+struct SG_SceneGraph * SG_create(void)
+{
+    struct SG_SceneGraph *const graph = calloc(1, sizeof(*graph));
+
+    graph->nodes = calloc(INITIAL_CAPACITY, sizeof(*graph->nodes));
+    graph->capacity = INITIAL_CAPACITY;
+    graph->draw_list = calloc(INITIAL_CAPACITY, sizeof(*graph->draw_list));
+    graph->draw_list_capacity = INITIAL_CAPACITY;
+
+    return graph;
+}
+
+void SG_destroy(
+    struct SG_SceneGraph *const graph)
+{
+    for (int i = 0; i < graph->length; ++i)
+    {
+        MAT_free(graph->nodes[i].world_rotation);
+        MAT_free(graph->nodes[i].local_rotation);
+    }
+
+    free(graph->draw_list);
+    free(graph->nodes);
+    free(graph);
+}
+
+int SG_add_node(
+    struct SG_SceneGraph *const graph,
+    const int parent,
+    const struct REND_ObjectWithPosition *const node)
+{
+    assert((parent >= SG_ROOT) && (parent < graph->length)); // LCOV_EXCL_LINE
+
+    if (graph->length == graph->capacity)
+    {
+        graph->capacity *= 2;
+        graph->nodes = realloc(graph->nodes, (size_t)graph->capacity * sizeof(*graph->nodes));
+    }
+
+    const int index = graph->length++;
+    struct Node *const new_node = &graph->nodes[index];
+
+    new_node->parent = parent;
+    new_node->draw_index = NOT_DRAWN;
+    new_node->dirty = 1;
+    new_node->update_stamp = graph->update_stamp;
+    new_node->local_position = node->position;
+    new_node->local_rotation = CST_get_extrinsic_rotation_matrix(&node->rotation);
+    new_node->world_position = node->position;
+    new_node->world_rotation = MAT_alloc(3, 3);
+
+    if ((node->object != NULL) || (node->point_source != NULL) || (node->mesh != NULL) ||
+        (node->compressed_object != NULL))
+    {
+        if (graph->draw_list_length == graph->draw_list_capacity)
+        {
+            graph->draw_list_capacity *= 2;
+            graph->draw_list =
+                realloc(graph->draw_list, (size_t)graph->draw_list_capacity * sizeof(*graph->draw_list));
+        }
+
+        new_node->draw_index = graph->draw_list_length++;
+
+        struct REND_ObjectWithPosition *const object = &graph->draw_list[new_node->draw_index];
+        *object = *node;
+        object->rotation_matrix = new_node->world_rotation;
+    }
+
+    return index;
+}
+
+void SG_set_local_transform(
+    struct SG_SceneGraph *const graph,
+    const int node,
+    const struct COORD_Coordinate3D *const position,
+    const struct CST_Rotation3D *const rotation)
+{
+    assert((node >= 0) && (node < graph->length)); // LCOV_EXCL_LINE
+
+    struct Node *const changed_node = &graph->nodes[node];
+
+    MAT_free(changed_node->local_rotation);
+    changed_node->local_rotation = CST_get_extrinsic_rotation_matrix(rotation);
+    changed_node->local_position = *position;
+    changed_node->dirty = 1;
+}
+
+int SG_update(
+    struct SG_SceneGraph *const graph)
+{
+    int number_of_updated_nodes = 0;
+
+    ++graph->update_stamp;
+
+    /* Parents are stored before their children, so a single pass visits each parent before its
+     * children and a child knows if its parent was recomputed in this update. */
+    for (int i = 0; i < graph->length; ++i)
+    {
+        struct Node *const node = &graph->nodes[i];
+        const struct Node *const parent = (node->parent == SG_ROOT) ? NULL : &graph->nodes[node->parent];
+
+        if (!node->dirty && ((parent == NULL) || (parent->update_stamp != graph->update_stamp)))
+        {
+            continue;
+        }
+
+        if (parent == NULL)
+        {
+            MAT_copy_block(node->local_rotation, 0, 0, 3, 3, node->world_rotation);
+            node->world_position = node->local_position;
+        }
+        else
+        {
+            MAT_matrix_matrix_multiplication(parent->world_rotation, node->local_rotation, node->world_rotation);
+            CST_affine_transformation(
+                &node->local_position, parent->world_rotation, &parent->world_position, &node->world_position);
+        }
+
+        if (node->draw_index != NOT_DRAWN)
+        {
+            graph->draw_list[node->draw_index].position = node->world_position;
+        }
+
+        node->dirty = 0;
+        node->update_stamp = graph->update_stamp;
+        ++number_of_updated_nodes;
+    }
+
+    return number_of_updated_nodes;
+}
+
+void SG_get_world_position(
+    const struct SG_SceneGraph *const graph,
+    const int node,
+    struct COORD_Coordinate3D *const position)
+{
+    assert((node >= 0) && (node < graph->length)); // LCOV_EXCL_LINE
+
+    *position = graph->nodes[node].world_position;
+}
+
+void SG_get_objects(
+    const struct SG_SceneGraph *const graph,
+    struct REND_Objects *const objects)
+{
+    objects->objects = graph->draw_list;
+    objects->length = graph->draw_list_length;
+    objects->instances = NULL;
+    objects->number_of_instances = 0;
+    objects->particle_systems = NULL;
+    objects->number_of_particle_systems = 0;
+}
@@ -0,0 +1,144 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/collision.h>
+#include <Engine/object.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_OF_RANDOM_BODIES (2000)
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+/**
+ * \brief Compare two pairs, see qsort()
+ */
+static int compare_pairs(
+    const void *const a,
+    const void *const b)
+{
+    const struct COLL_Pair *const pair_a = a;
+    const struct COLL_Pair *const pair_b = b;
+
+    return (pair_a->first != pair_b->first) ? (pair_a->first - pair_b->first) : (pair_a->second - pair_b->second);
+}
+
+/**
+ * \brief Check that the pairs are the pairs of overlapping bodies found by checking all pairs
+ */
+static int is_all_overlapping_pairs(
+    const struct COLL_Body *const bodies,
+    const int length,
+    const struct COLL_Pair *const found_pairs,
+    const int number_of_pairs)
+{
+    struct COLL_Pair *const pairs = calloc((size_t)number_of_pairs + 1U, sizeof(*pairs));
+    memcpy(pairs, found_pairs, (size_t)number_of_pairs * sizeof(*pairs));
+    qsort(pairs, (size_t)number_of_pairs, sizeof(*pairs), compare_pairs);
+
+    int index = 0;
+    int is_equal = 1;
+
+    for (int i = 0; i < length; ++i)
+    {
+        for (int j = i + 1; j < length; ++j)
+        {
+            const double radii = bodies[i].radius + bodies[j].radius;
+            const int is_overlapping = (fabs(bodies[i].position.x - bodies[j].position.x) <= radii) &&
+                (fabs(bodies[i].position.y - bodies[j].position.y) <= radii) &&
+                (fabs(bodies[i].position.z - bodies[j].position.z) <= radii);
+
+            if (is_overlapping)
+            {
+                is_equal &= (index < number_of_pairs) && (pairs[index].first == i) && (pairs[index].second == j);
+                ++index;
+            }
+        }
+    }
+
+    free(pairs);
+
+    return is_equal && (index == number_of_pairs);
+}
+
+static void test_COLL_get_bounding_radius(void)
+{
+    const struct OBJ_BoundingBox bounds = {
+        .min = {.x = -1.0, .y = -4.0, .z = 0.0},
+        .max = {.x = 2.0, .y = 1.0, .z = 2.0}
+    };
+
+    TF_assert_double_eq(COLL_get_bounding_radius(&bounds), sqrt(4.0 + 16.0 + 4.0), granularity);
+}
+
+static void test_COLL_find_pairs(void)
+{
+    const struct COLL_Body bodies[] = {
+        {.position = {.x = 0.0, .y = 0.0, .z = 0.0}, .radius = 1.0},
+        {.position = {.x = 1.5, .y = 0.0, .z = 0.0}, .radius = 1.0},
+        {.position = {.x = 10.0, .y = 0.0, .z = 0.0}, .radius = 1.0},
+        {.position = {.x = 0.5, .y = 1.5, .z = -1.0}, .radius = 0.5},
+        {.position = {.x = -3.0, .y = 0.0, .z = 0.0}, .radius = 0.5},
+    };
+    struct COLL_BroadPhase *const broad_phase = COLL_create();
+    const struct COLL_Pair *pairs = NULL;
+
+    int number_of_pairs = COLL_find_pairs_spatial_hash(broad_phase, bodies, LENGTH(bodies), &pairs);
+    TF_assert(number_of_pairs == 3);
+    TF_assert(is_all_overlapping_pairs(bodies, LENGTH(bodies), pairs, number_of_pairs));
+
+    number_of_pairs = COLL_find_pairs_sweep_and_prune(broad_phase, bodies, LENGTH(bodies), &pairs);
+    TF_assert(number_of_pairs == 3);
+    TF_assert(is_all_overlapping_pairs(bodies, LENGTH(bodies), pairs, number_of_pairs));
+
+    TF_assert(COLL_find_pairs_spatial_hash(broad_phase, bodies, 0, &pairs) == 0);
+    TF_assert(COLL_find_pairs_sweep_and_prune(broad_phase, bodies, 0, &pairs) == 0);
+
+    COLL_destroy(broad_phase);
+}
+
+static void test_COLL_find_pairs_random(void)
+{
+    struct COLL_Body *const bodies = calloc(NUMBER_OF_RANDOM_BODIES, sizeof(*bodies));
+    struct COLL_BroadPhase *const broad_phase = COLL_create();
+    const struct COLL_Pair *pairs = NULL;
+
+    srand(1);
+
+    /* Varying sizes and negative coordinates, enough pairs to grow the pair buffer */
+    for (int i = 0; i < NUMBER_OF_RANDOM_BODIES; ++i)
+    {
+        bodies[i].position.x = (20.0 * rand() / RAND_MAX) - 10.0;
+        bodies[i].position.y = (20.0 * rand() / RAND_MAX) - 10.0;
+        bodies[i].position.z = (20.0 * rand() / RAND_MAX) - 10.0;
+        bodies[i].radius = 1.0 * rand() / RAND_MAX;
+    }
+
+    int number_of_pairs = COLL_find_pairs_spatial_hash(broad_phase, bodies, NUMBER_OF_RANDOM_BODIES, &pairs);
+    TF_assert(number_of_pairs > 1024);
+    TF_assert(is_all_overlapping_pairs(bodies, NUMBER_OF_RANDOM_BODIES, pairs, number_of_pairs));
+
+    number_of_pairs = COLL_find_pairs_sweep_and_prune(broad_phase, bodies, NUMBER_OF_RANDOM_BODIES, &pairs);
+    TF_assert(is_all_overlapping_pairs(bodies, NUMBER_OF_RANDOM_BODIES, pairs, number_of_pairs));
+
+    COLL_destroy(broad_phase);
+    free(bodies);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_COLL_get_bounding_radius,
+        test_COLL_find_pairs,
+        test_COLL_find_pairs_random,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,148 @@
+#include <Base/common.h>
+#include <Engine/compositor.h>
+#include <Engine/renderer.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+#define WIDTH (3)
+#define HEIGHT (2)
+
+static void test_COMP_get_partition(void)
+{
+    const struct REND_ObjectWithPosition objects[5] = {{.object = NULL}};
+    const struct PART_ParticleSystem *const particle_systems[3] = {NULL};
+    const struct REND_Objects model = {
+        .objects = objects,
+        .length = LENGTH(objects),
+        .particle_systems = particle_systems,
+        .number_of_particle_systems = LENGTH(particle_systems)
+    };
+
+    struct REND_Objects first;
+    struct REND_Objects second;
+    COMP_get_partition(&model, 0, 2, &first);
+    COMP_get_partition(&model, 1, 2, &second);
+
+    TF_assert(first.objects == &objects[0]);
+    TF_assert(first.length == 2);
+    TF_assert(second.objects == &objects[2]);
+    TF_assert(second.length == 3);
+    TF_assert(first.number_of_instances == 0);
+    TF_assert(second.number_of_instances == 0);
+    TF_assert(first.particle_systems == &particle_systems[0]);
+    TF_assert(first.number_of_particle_systems == 1);
+    TF_assert(second.particle_systems == &particle_systems[1]);
+    TF_assert(second.number_of_particle_systems == 2);
+}
+
+static void send_frame(
+    const int socket,
+    const char color,
+    const double depths[HEIGHT][WIDTH])
+{
+    struct COMP_Compositor *const worker = COMP_create(WIDTH, HEIGHT);
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(HEIGHT, WIDTH);
+
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            MAT_set_element(frame_buffer, y, x, isinf(depths[y][x]) ? ' ' : color);
+            MAT_set_element(z_buffer, y, x, depths[y][x]);
+        }
+    }
+
+    TF_assert(COMP_send_frame(worker, socket, frame_buffer, z_buffer) == 0);
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+    COMP_destroy(worker);
+}
+
+static void test_COMP_composite(void)
+{
+    int first[2];
+    int second[2];
+    TF_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, first) == 0);
+    TF_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, second) == 0);
+
+    /* The frames are small enough to fit in the socket buffers, no other thread is needed */
+    const double first_depths[HEIGHT][WIDTH] = {{1.0, INFINITY, 3.0}, {2.0, INFINITY, INFINITY}};
+    const double second_depths[HEIGHT][WIDTH] = {{0.5, INFINITY, 3.0}, {4.0, INFINITY, 2.5}};
+    send_frame(first[1], 'a', first_depths);
+    send_frame(second[1], 'b', second_depths);
+
+    struct COMP_Compositor *const compositor = COMP_create(WIDTH, HEIGHT);
+    const int sockets[] = {first[0], second[0]};
+    TF_assert(COMP_composite(compositor, sockets, LENGTH(sockets)) == 0);
+
+    const struct MAT_Matrix *const frame_buffer = COMP_get_frame_buffer(compositor);
+    const struct MAT_Matrix *const z_buffer = COMP_get_z_buffer(compositor);
+
+    /* The closest worker wins, the first worker wins ties */
+    TF_assert((char)MAT_get_element(frame_buffer, 0, 0) == 'b');
+    TF_assert((char)MAT_get_element(frame_buffer, 0, 1) == ' ');
+    TF_assert((char)MAT_get_element(frame_buffer, 0, 2) == 'a');
+    TF_assert((char)MAT_get_element(frame_buffer, 1, 0) == 'a');
+    TF_assert((char)MAT_get_element(frame_buffer, 1, 1) == ' ');
+    TF_assert((char)MAT_get_element(frame_buffer, 1, 2) == 'b');
+    TF_assert_double_eq(MAT_get_element(z_buffer, 0, 0), 0.5, granularity);
+    TF_assert_double_eq(MAT_get_element(z_buffer, 1, 2), 2.5, granularity);
+    TF_assert(isinf(MAT_get_element(z_buffer, 1, 1)));
+
+    COMP_destroy(compositor);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        close(first[i]);
+        close(second[i]);
+    }
+}
+
+static void test_COMP_composite_failures(void)
+{
+    int wrong_size[2];
+    int closed[2];
+    TF_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, wrong_size) == 0);
+    TF_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, closed) == 0);
+
+    struct COMP_Compositor *const compositor = COMP_create(WIDTH + 1, HEIGHT);
+
+    /* A frame of another size */
+    const double depths[HEIGHT][WIDTH] = {{1.0}};
+    send_frame(wrong_size[1], 'a', depths);
+    TF_assert(COMP_composite(compositor, &wrong_size[0], 1) != 0);
+
+    /* The worker has closed its socket */
+    close(closed[1]);
+    TF_assert(COMP_composite(compositor, &closed[0], 1) != 0);
+
+    COMP_destroy(compositor);
+    close(closed[0]);
+    close(wrong_size[1]);
+    close(wrong_size[0]);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_COMP_get_partition,
+        test_COMP_composite,
+        test_COMP_composite_failures,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
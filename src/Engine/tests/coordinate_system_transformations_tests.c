@@ -5,6 +5,8 @@
 #include <LinearAlgebra/matrix.h>
 #include <TestFramework/test_framework.h>
 
+#include <math.h>
+
 int TF_test_case_status;
 
 static const double granularity = 1e-5;
@@ -103,6 +105,51 @@ static void test_CST_world_coordinate_to_image_coordinate(void)
     MAT_free(camera_matrix);
 }
 
+static void test_CST_set_extrinsic_rotation_matrix(void)
+{
+    const struct CST_Rotation3D rotation = {
+        .pitch = 0.3,
+        .yaw = -1.2,
+        .roll = 2.5
+    };
+    double rotation_matrix_data[9];
+    struct MAT_Matrix rotation_matrix = {
+        .rows = 3,
+        .cols = 3,
+        .data = &rotation_matrix_data[0]
+    };
+    struct MAT_Matrix *const expected_rotation_matrix = CST_get_extrinsic_rotation_matrix(&rotation);
+
+    CST_set_extrinsic_rotation_matrix(&rotation, &rotation_matrix);
+
+    for (int i = 0; i < 9; ++i)
+    {
+        TF_assert_double_eq(rotation_matrix_data[i], expected_rotation_matrix->data[i], granularity);
+    }
+
+    /* A pitch of 90 degrees rotates the y-axis to the z-axis */
+    const struct COORD_Coordinate3D y_axis = {
+        .x = 0.0,
+        .y = 1.0,
+        .z = 0.0
+    };
+    const struct CST_Rotation3D pitch = {
+        .pitch = M_PI / 2.0,
+        .yaw = 0.0,
+        .roll = 0.0
+    };
+    struct COORD_Coordinate3D rotated_y_axis;
+
+    CST_set_extrinsic_rotation_matrix(&pitch, &rotation_matrix);
+    CST_linear_transformation(&y_axis, &rotation_matrix, &rotated_y_axis);
+
+    TF_assert_double_eq(rotated_y_axis.x, 0.0, granularity);
+    TF_assert_double_eq(rotated_y_axis.y, 0.0, granularity);
+    TF_assert_double_eq(rotated_y_axis.z, 1.0, granularity);
+
+    MAT_free(expected_rotation_matrix);
+}
+
 int main(int argc, char *argv[])
 {
     UNUSED(argc);
@@ -111,6 +158,7 @@ int main(int argc, char *argv[])
     TF_test_case test_cases[] = {
         test_CST_linear_transformation,
         test_CST_world_coordinate_to_image_coordinate,
+        test_CST_set_extrinsic_rotation_matrix,
     };
 
     return TF_run_suite(test_cases, LENGTH(test_cases));
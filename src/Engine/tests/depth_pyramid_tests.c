@@ -0,0 +1,168 @@
+#include "../depth_pyramid.h"
+
+#include <Base/common.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+
+int TF_test_case_status;
+
+static void set_rectangle(
+    struct MAT_Matrix *const z_buffer,
+    const struct DPYR_Rectangle *const rectangle,
+    const double depth)
+{
+    for (int y = rectangle->y_begin; y <= rectangle->y_end; ++y)
+    {
+        for (int x = rectangle->x_begin; x <= rectangle->x_end; ++x)
+        {
+            MAT_set_element(z_buffer, y, x, depth);
+        }
+    }
+}
+
+static void test_DPYR_is_hidden_empty(void)
+{
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 20);
+    struct DPYR_DepthPyramid *const pyramid = DPYR_create(20, 10);
+    const struct DPYR_Rectangle rectangle = {.x_begin = 2, .x_end = 5, .y_begin = 3, .y_end = 4};
+
+    MAT_set_all_elements(z_buffer, INFINITY);
+    DPYR_update(pyramid, z_buffer);
+
+    TF_assert(!DPYR_is_hidden(pyramid, &rectangle, 1.0));
+
+    DPYR_destroy(pyramid);
+    MAT_free(z_buffer);
+}
+
+static void test_DPYR_is_hidden(void)
+{
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 20);
+    struct DPYR_DepthPyramid *const pyramid = DPYR_create(20, 10);
+    const struct DPYR_Rectangle occluder = {.x_begin = 0, .x_end = 11, .y_begin = 0, .y_end = 7};
+    const struct DPYR_Rectangle inside = {.x_begin = 1, .x_end = 6, .y_begin = 2, .y_end = 5};
+    const struct DPYR_Rectangle partly_outside = {.x_begin = 8, .x_end = 13, .y_begin = 2, .y_end = 5};
+
+    MAT_set_all_elements(z_buffer, INFINITY);
+    set_rectangle(z_buffer, &occluder, 2.0);
+    DPYR_update(pyramid, z_buffer);
+
+    TF_assert(DPYR_is_hidden(pyramid, &inside, 3.0));
+    TF_assert(!DPYR_is_hidden(pyramid, &inside, 1.0));
+    TF_assert(!DPYR_is_hidden(pyramid, &partly_outside, 3.0));
+
+    DPYR_destroy(pyramid);
+    MAT_free(z_buffer);
+}
+
+static void test_DPYR_is_hidden_large_rectangle(void)
+{
+    struct MAT_Matrix *const z_buffer = MAT_alloc(50, 100);
+    struct DPYR_DepthPyramid *const pyramid = DPYR_create(100, 50);
+    const struct DPYR_Rectangle screen = {.x_begin = 0, .x_end = 99, .y_begin = 0, .y_end = 49};
+    const struct DPYR_Rectangle corner = {.x_begin = 99, .x_end = 99, .y_begin = 49, .y_end = 49};
+
+    MAT_set_all_elements(z_buffer, 2.0);
+    DPYR_update(pyramid, z_buffer);
+
+    TF_assert(DPYR_is_hidden(pyramid, &screen, 3.0));
+
+    /* A single cell that is not drawn makes the entire screen visible */
+    MAT_set_element(z_buffer, 49, 99, INFINITY);
+    DPYR_update(pyramid, z_buffer);
+
+    TF_assert(!DPYR_is_hidden(pyramid, &screen, 3.0));
+    TF_assert(!DPYR_is_hidden(pyramid, &corner, 3.0));
+
+    DPYR_destroy(pyramid);
+    MAT_free(z_buffer);
+}
+
+/* Checks that two pyramids give the same answers for single cells, blocks of cells and the screen */
+static int is_equal(
+    const struct DPYR_DepthPyramid *const a,
+    const struct DPYR_DepthPyramid *const b,
+    const int width,
+    const int height)
+{
+    const double depths[] = {0.5, 1.5, 2.5, 3.5};
+
+    for (size_t i = 0; i < LENGTH(depths); ++i)
+    {
+        for (int size = 1; size <= width; size *= 3)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const struct DPYR_Rectangle rectangle = {
+                        .x_begin = x,
+                        .x_end = (x + size < width) ? x + size - 1 : width - 1,
+                        .y_begin = y,
+                        .y_end = (y + size < height) ? y + size - 1 : height - 1
+                    };
+
+                    if (DPYR_is_hidden(a, &rectangle, depths[i]) != DPYR_is_hidden(b, &rectangle, depths[i]))
+                    {
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void test_DPYR_update_rectangle(void)
+{
+    /* Not a multiple of the cell sizes */
+    const int width = 37;
+    const int height = 23;
+    struct MAT_Matrix *const z_buffer = MAT_alloc(height, width);
+    struct DPYR_DepthPyramid *const pyramid = DPYR_create(width, height);
+    struct DPYR_DepthPyramid *const expected = DPYR_create(width, height);
+    const struct DPYR_Rectangle changes[] = {
+        {.x_begin = 0, .x_end = 36, .y_begin = 0, .y_end = 22},
+        {.x_begin = 3, .x_end = 9, .y_begin = 5, .y_end = 6},
+        {.x_begin = 36, .x_end = 36, .y_begin = 22, .y_end = 22},
+        {.x_begin = 12, .x_end = 30, .y_begin = 0, .y_end = 17},
+        {.x_begin = 20, .x_end = 21, .y_begin = 10, .y_end = 22},
+    };
+    /* Both nearer and farther than before, e.g. when the z buffer is reset */
+    const double depths[] = {3.0, 1.0, 2.0, 1.0, INFINITY};
+
+    MAT_set_all_elements(z_buffer, INFINITY);
+    DPYR_update(pyramid, z_buffer);
+
+    for (size_t i = 0; i < LENGTH(changes); ++i)
+    {
+        set_rectangle(z_buffer, &changes[i], depths[i]);
+        DPYR_update_rectangle(pyramid, z_buffer, &changes[i]);
+        DPYR_update(expected, z_buffer);
+
+        TF_assert(is_equal(pyramid, expected, width, height));
+    }
+
+    DPYR_destroy(expected);
+    DPYR_destroy(pyramid);
+    MAT_free(z_buffer);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_DPYR_is_hidden_empty,
+        test_DPYR_is_hidden,
+        test_DPYR_is_hidden_large_rectangle,
+        test_DPYR_update_rectangle,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
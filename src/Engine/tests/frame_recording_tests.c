@@ -0,0 +1,192 @@
+#include <Base/common.h>
+#include <Engine/frame_recording.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+#define WIDTH (8)
+#define HEIGHT (4)
+
+static void get_path(
+    char *const path,
+    const size_t size)
+{
+    snprintf(path, size, "/tmp/frame_recording_tests_%ld.rec", (long)getpid());
+}
+
+static long get_file_size(
+    const char *const path)
+{
+    FILE *const file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fclose(file);
+
+    return size;
+}
+
+static int is_equal(
+    const struct MAT_Matrix *const frame_buffer,
+    const char *const characters)
+{
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            if ((char)MAT_get_element(frame_buffer, y, x) != characters[y * WIDTH + x])
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void set_frame(
+    struct MAT_Matrix *const frame_buffer,
+    const char *const characters)
+{
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            MAT_set_element(frame_buffer, y, x, characters[y * WIDTH + x]);
+        }
+    }
+}
+
+static void test_FREC_record_and_replay(void)
+{
+    /* Unchanged, runs, literals and a changed last character */
+    const char *const frames[] = {
+        "                                ",
+        "  ####    ab    ........       x",
+        "  ####    ac    ..--....        ",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+        "abcdefghijklmnopqrstuvwxyz012345",
+    };
+
+    char path[64];
+    get_path(path, sizeof(path));
+
+    struct FREC_Recorder *const recorder = FREC_create(path, WIDTH, HEIGHT);
+    TF_assert(recorder != NULL);
+
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+
+    for (size_t i = 0; i < LENGTH(frames); ++i)
+    {
+        set_frame(frame_buffer, frames[i]);
+        TF_assert(FREC_record_frame(recorder, frame_buffer) == 0);
+    }
+
+    TF_assert(FREC_destroy(recorder) == 0);
+    MAT_free(frame_buffer);
+
+    struct FREC_Player *const player = FREC_open(path);
+    TF_assert(player != NULL);
+
+    const struct MAT_Matrix *frame;
+    double time;
+    double previous_time = 0.0;
+
+    for (size_t i = 0; i < LENGTH(frames); ++i)
+    {
+        TF_assert(FREC_read_frame(player, &frame, &time) == 1);
+        TF_assert(is_equal(frame, frames[i]));
+        TF_assert(time >= previous_time);
+        previous_time = time;
+    }
+
+    TF_assert(FREC_read_frame(player, &frame, &time) == 0);
+
+    FREC_close(player);
+    remove(path);
+}
+
+static void test_FREC_compression(void)
+{
+    char path[64];
+    get_path(path, sizeof(path));
+
+    /* An empty recording */
+    FREC_destroy(FREC_create(path, WIDTH, HEIGHT));
+    const long header_size = get_file_size(path);
+
+    struct FREC_Player *const player = FREC_open(path);
+    const struct MAT_Matrix *frame;
+    double time;
+    TF_assert(FREC_read_frame(player, &frame, &time) == 0);
+    FREC_close(player);
+
+    struct FREC_Recorder *const recorder = FREC_create(path, WIDTH, HEIGHT);
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+
+    /* An unchanged frame is only its time and size */
+    MAT_set_all_elements(frame_buffer, ' ');
+
+    for (int i = 0; i < 100; ++i)
+    {
+        FREC_record_frame(recorder, frame_buffer);
+    }
+
+    FREC_destroy(recorder);
+    MAT_free(frame_buffer);
+
+    TF_assert(get_file_size(path) - header_size <= 100 * 2);
+
+    remove(path);
+}
+
+static void test_FREC_invalid_recordings(void)
+{
+    char path[64];
+    get_path(path, sizeof(path));
+
+    /* Not a recording */
+    FILE *file = fopen(path, "wb");
+    fputs("not a recording, but long enough to hold a header", file);
+    fclose(file);
+    TF_assert(FREC_open(path) == NULL);
+    TF_assert(FREC_open("/nonexistent/frame_recording") == NULL);
+
+    /* A truncated frame */
+    struct FREC_Recorder *const recorder = FREC_create(path, WIDTH, HEIGHT);
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+    MAT_set_all_elements(frame_buffer, 'a');
+    FREC_record_frame(recorder, frame_buffer);
+    FREC_destroy(recorder);
+    MAT_free(frame_buffer);
+
+    TF_assert(truncate(path, get_file_size(path) - 1) == 0);
+
+    struct FREC_Player *const player = FREC_open(path);
+    const struct MAT_Matrix *frame;
+    double time;
+
+    TF_assert(player != NULL);
+    TF_assert(FREC_read_frame(player, &frame, &time) < 0);
+
+    FREC_close(player);
+    remove(path);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_FREC_record_and_replay,
+        test_FREC_compression,
+        test_FREC_invalid_recordings,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
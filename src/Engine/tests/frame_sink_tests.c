@@ -0,0 +1,136 @@
+#include <Base/common.h>
+#include <Engine/frame_sink.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+#define WIDTH (4)
+#define HEIGHT (3)
+#define NUMBER_OF_SLOTS (3)
+
+static void get_name(
+    char *const name,
+    const size_t size)
+{
+    snprintf(name, size, "/frame_sink_tests_%ld", (long)getpid());
+}
+
+static void write_frame(
+    struct FSINK_FrameSink *const sink,
+    const char color,
+    const double depth)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(HEIGHT, WIDTH);
+
+    MAT_set_all_elements(frame_buffer, color);
+    MAT_set_all_elements(z_buffer, depth);
+    MAT_set_element(frame_buffer, 0, 0, ' ');
+    MAT_set_element(z_buffer, 0, 0, INFINITY);
+
+    FSINK_write_frame(sink, frame_buffer, z_buffer);
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+static void test_FSINK_read(void)
+{
+    char name[64];
+    get_name(name, sizeof(name));
+
+    struct FSINK_FrameSink *const sink = FSINK_create(name, WIDTH, HEIGHT, NUMBER_OF_SLOTS, 1);
+    TF_assert(sink != NULL);
+
+    /* The name is taken */
+    TF_assert(FSINK_create(name, WIDTH, HEIGHT, NUMBER_OF_SLOTS, 1) == NULL);
+
+    struct FSINK_Reader *const reader = FSINK_open(name);
+    TF_assert(reader != NULL);
+    TF_assert(FSINK_get_latest_sequence(reader) == 0);
+    TF_assert(!FSINK_is_closed(reader));
+
+    struct FSINK_Frame frame;
+    TF_assert(!FSINK_get_frame(reader, 0, &frame));
+    TF_assert(!FSINK_get_frame(reader, 1, &frame));
+
+    write_frame(sink, 'a', 1.0);
+    write_frame(sink, 'b', 2.0);
+    TF_assert(FSINK_get_latest_sequence(reader) == 2);
+
+    TF_assert(FSINK_get_frame(reader, 1, &frame));
+    TF_assert(frame.sequence == 1);
+    TF_assert(frame.width == WIDTH);
+    TF_assert(frame.height == HEIGHT);
+    TF_assert(frame.characters[0] == ' ');
+    TF_assert(frame.characters[WIDTH * HEIGHT - 1] == 'a');
+    TF_assert(isinf(frame.depths[0]));
+    TF_assert_double_eq(frame.depths[1], 1.0, granularity);
+    TF_assert(FSINK_is_valid(reader, &frame));
+
+    TF_assert(FSINK_get_frame(reader, 2, &frame));
+    TF_assert(frame.characters[1] == 'b');
+    TF_assert_double_eq(frame.depths[1], 2.0, granularity);
+
+    FSINK_close(reader);
+    FSINK_destroy(sink);
+
+    /* The shared memory object is removed */
+    TF_assert(FSINK_open(name) == NULL);
+}
+
+static void test_FSINK_dropped_frames(void)
+{
+    char name[64];
+    get_name(name, sizeof(name));
+
+    struct FSINK_FrameSink *const sink = FSINK_create(name, WIDTH, HEIGHT, NUMBER_OF_SLOTS, 0);
+    struct FSINK_Reader *const reader = FSINK_open(name);
+    struct FSINK_Frame first_frame;
+    struct FSINK_Frame frame;
+
+    write_frame(sink, 'a', 1.0);
+    TF_assert(FSINK_get_frame(reader, 1, &first_frame));
+    TF_assert(first_frame.depths == NULL);
+
+    /* The first frame is overwritten while it is read */
+    for (int i = 0; i < NUMBER_OF_SLOTS; ++i)
+    {
+        write_frame(sink, 'b', 1.0);
+    }
+
+    TF_assert(!FSINK_is_valid(reader, &first_frame));
+    TF_assert(!FSINK_get_frame(reader, 1, &frame));
+    TF_assert(FSINK_get_frame(reader, 2, &frame));
+    TF_assert(FSINK_get_frame(reader, NUMBER_OF_SLOTS + 1, &frame));
+    TF_assert(!FSINK_get_frame(reader, NUMBER_OF_SLOTS + 2, &frame));
+
+    /* The reader can still read the frames after the sink is destroyed */
+    FSINK_destroy(sink);
+    TF_assert(FSINK_is_closed(reader));
+    TF_assert(FSINK_get_frame(reader, 2, &frame));
+    TF_assert(frame.characters[1] == 'b');
+
+    FSINK_close(reader);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_FSINK_read,
+        test_FSINK_dropped_frames,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
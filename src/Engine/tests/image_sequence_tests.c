@@ -0,0 +1,151 @@
+#include <Base/common.h>
+#include <Engine/image_sequence.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+#define WIDTH (3)
+#define HEIGHT (2)
+#define MAX_DEPTH (4.0)
+
+static char directory[64];
+
+static size_t read_file(
+    const char *const name,
+    unsigned char *const data,
+    const size_t size)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+
+    FILE *const file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    const size_t length = fread(data, 1, size, file);
+    fclose(file);
+    remove(path);
+
+    return length;
+}
+
+static void write_frame(
+    const enum IMGS_Format format,
+    const int index)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(HEIGHT, WIDTH);
+
+    /* Background, the darkest and brightest illumination and depths in front of, at and behind the max depth */
+    const char colors[] = " .@#xa";
+    const double depths[] = {INFINITY, 0.0, MAX_DEPTH / 2.0, MAX_DEPTH, 2.0 * MAX_DEPTH, 1.0};
+
+    for (int i = 0; i < WIDTH * HEIGHT; ++i)
+    {
+        MAT_set_element(frame_buffer, i / WIDTH, i % WIDTH, colors[i]);
+        MAT_set_element(z_buffer, i / WIDTH, i % WIDTH, depths[i]);
+    }
+
+    struct IMGS_Writer *const writer = IMGS_create(directory, format, WIDTH, HEIGHT, MAX_DEPTH);
+    TF_assert(IMGS_write_frame(writer, index, frame_buffer, z_buffer) == 0);
+    IMGS_destroy(writer);
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+static void test_IMGS_depth(void)
+{
+    unsigned char data[64];
+
+    write_frame(IMGS_DEPTH, 7);
+
+    const char header[] = "P5\n3 2\n255\n";
+    const size_t header_length = strlen(header);
+    TF_assert(read_file("frame_000007.pgm", data, sizeof(data)) == header_length + WIDTH * HEIGHT);
+    TF_assert(memcmp(data, header, header_length) == 0);
+
+    const unsigned char *const pixels = &data[header_length];
+    TF_assert(pixels[0] == 0U);
+    TF_assert(pixels[1] == 255U);
+    TF_assert(pixels[2] == 128U);
+    TF_assert(pixels[3] == 1U);
+    TF_assert(pixels[4] == 0U);
+}
+
+static void test_IMGS_illumination(void)
+{
+    unsigned char data[64];
+
+    write_frame(IMGS_ILLUMINATION, 0);
+
+    const size_t header_length = strlen("P5\n3 2\n255\n");
+    TF_assert(read_file("frame_000000.pgm", data, sizeof(data)) == header_length + WIDTH * HEIGHT);
+
+    const unsigned char *const pixels = &data[header_length];
+    TF_assert(pixels[0] == 0U);
+    TF_assert((pixels[1] > 0U) && (pixels[1] < pixels[3]) && (pixels[3] < pixels[2]));
+    TF_assert(pixels[4] == 0U); /* Not an illumination level */
+}
+
+static void test_IMGS_text(void)
+{
+    unsigned char data[64];
+
+    write_frame(IMGS_TEXT, 123456);
+
+    TF_assert(read_file("frame_123456.txt", data, sizeof(data)) == (WIDTH + 1) * HEIGHT);
+    TF_assert(memcmp(data, " .@\n#xa\n", (WIDTH + 1) * HEIGHT) == 0);
+}
+
+static void test_IMGS_missing_directory(void)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(HEIGHT, WIDTH);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(HEIGHT, WIDTH);
+    struct IMGS_Writer *const writer = IMGS_create("/nonexistent/images", IMGS_TEXT, WIDTH, HEIGHT, MAX_DEPTH);
+
+    MAT_set_all_elements(frame_buffer, ' ');
+    MAT_set_all_elements(z_buffer, INFINITY);
+    TF_assert(IMGS_write_frame(writer, 0, frame_buffer, z_buffer) != 0);
+
+    IMGS_destroy(writer);
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    snprintf(directory, sizeof(directory), "/tmp/image_sequence_tests_XXXXXX");
+
+    if (mkdtemp(directory) == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    TF_test_case test_cases[] = {
+        test_IMGS_depth,
+        test_IMGS_illumination,
+        test_IMGS_text,
+        test_IMGS_missing_directory,
+    };
+
+    const int status = TF_run_suite(test_cases, LENGTH(test_cases));
+
+    rmdir(directory);
+
+    return status;
+}
@@ -0,0 +1,117 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/object_cache.h>
+#include <TestFramework/test_framework.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static int number_of_generated_objects;
+
+static struct OBJ_Object * generate_object(
+    const double parameters[])
+{
+    struct OBJ_Object *const object = calloc(1, sizeof(*object));
+
+    object->length = 1;
+    object->coordinates = calloc(1, sizeof(*object->coordinates));
+    object->surface_normals = calloc(1, sizeof(*object->surface_normals));
+    object->coordinates[0].x = parameters[0];
+    object->surface_normals[0].z = 1.0;
+    OBJ_update_bounds(object);
+
+    ++number_of_generated_objects;
+
+    return object;
+}
+
+static void free_object(
+    struct OBJ_Object *const object)
+{
+    free(object->surface_normals);
+    free(object->coordinates);
+    free(object);
+}
+
+static void test_OBJC_get_cached(void)
+{
+    char directory[] = "/tmp/object_cache_tests_XXXXXX";
+    TF_assert(mkdtemp(directory) != NULL);
+
+    const double parameters[] = {4.0};
+    number_of_generated_objects = 0;
+
+    struct OBJC_CachedObject *const first = OBJC_get(directory, "test", parameters, 1, generate_object, free_object);
+    struct OBJC_CachedObject *const second = OBJC_get(directory, "test", parameters, 1, generate_object, free_object);
+
+    TF_assert(number_of_generated_objects == 1);
+    TF_assert(OBJC_get_object(second)->length == 1);
+    TF_assert_double_eq(OBJC_get_object(second)->coordinates[0].x, parameters[0], granularity);
+
+    const double other_parameters[] = {5.0};
+    struct OBJC_CachedObject *const third =
+        OBJC_get(directory, "test", other_parameters, 1, generate_object, free_object);
+
+    TF_assert(number_of_generated_objects == 2);
+    TF_assert_double_eq(OBJC_get_object(third)->coordinates[0].x, other_parameters[0], granularity);
+
+    OBJC_release(third);
+    OBJC_release(second);
+    OBJC_release(first);
+
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/test-v2-%016llx.obj", directory, 0x4010000000000000ULL);
+    TF_assert(remove(path) == 0);
+    snprintf(path, sizeof(path), "%s/test-v2-%016llx.obj", directory, 0x4014000000000000ULL);
+    TF_assert(remove(path) == 0);
+    TF_assert(rmdir(directory) == 0);
+}
+
+static void test_OBJC_get_disabled(void)
+{
+    const double parameters[] = {3.0};
+    number_of_generated_objects = 0;
+
+    struct OBJC_CachedObject *const first = OBJC_get(NULL, "test", parameters, 1, generate_object, free_object);
+    struct OBJC_CachedObject *const second = OBJC_get(NULL, "test", parameters, 1, generate_object, free_object);
+
+    TF_assert(number_of_generated_objects == 2);
+    TF_assert_double_eq(OBJC_get_object(first)->coordinates[0].x, parameters[0], granularity);
+
+    OBJC_release(second);
+    OBJC_release(first);
+}
+
+static void test_OBJC_get_unwritable_directory(void)
+{
+    const double parameters[] = {2.0};
+    number_of_generated_objects = 0;
+
+    struct OBJC_CachedObject *const object =
+        OBJC_get("/tmp/object_cache_tests_missing_directory", "test", parameters, 1, generate_object, free_object);
+
+    TF_assert(number_of_generated_objects == 1);
+    TF_assert_double_eq(OBJC_get_object(object)->coordinates[0].x, parameters[0], granularity);
+
+    OBJC_release(object);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_OBJC_get_cached,
+        test_OBJC_get_disabled,
+        test_OBJC_get_unwritable_directory,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
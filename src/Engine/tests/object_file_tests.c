@@ -0,0 +1,215 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/object_file.h>
+#include <TestFramework/test_framework.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+/* Offsets of the fields in the file header [bytes] */
+#define LENGTH_OFFSET (16)
+#define COORDINATES_OFFSET_OFFSET (24)
+#define SURFACE_NORMALS_OFFSET_OFFSET (32)
+
+static const double granularity = 1e-5;
+
+/* Writes an object file with two points to a new temporary file */
+static void write_object_file(
+    char *const path)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = 2.0, .z = 3.0},
+        {.x = -1.0, .y = -2.0, .z = -3.0},
+    };
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = coordinates,
+        .length = LENGTH(coordinates)
+    };
+    OBJ_update_bounds(&object);
+
+    const int fd = mkstemp(path);
+    TF_assert(fd >= 0);
+    close(fd);
+
+    TF_assert(OBJF_write(path, &object) == 0);
+}
+
+/* Overwrites a 64 bit field of the file header */
+static void write_header_field(
+    const char *const path,
+    const long offset,
+    const uint64_t value)
+{
+    FILE *const file = fopen(path, "r+b");
+    TF_assert(file != NULL);
+
+    if (file != NULL)
+    {
+        TF_assert(fseek(file, offset, SEEK_SET) == 0);
+        TF_assert(fwrite(&value, sizeof(value), 1, file) == 1);
+        fclose(file);
+    }
+}
+
+/* Reads a 64 bit field of the file header */
+static uint64_t read_header_field(
+    const char *const path,
+    const long offset)
+{
+    uint64_t value = 0U;
+    FILE *const file = fopen(path, "rb");
+    TF_assert(file != NULL);
+
+    if (file != NULL)
+    {
+        TF_assert(fseek(file, offset, SEEK_SET) == 0);
+        TF_assert(fread(&value, sizeof(value), 1, file) == 1);
+        fclose(file);
+    }
+
+    return value;
+}
+
+static void test_OBJF_write_and_map(void)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = 2.0, .z = 3.0},
+        {.x = -1.0, .y = -2.0, .z = -3.0},
+    };
+    struct COORD_Coordinate3D surface_normals[] = {
+        {.x = 0.0, .y = 0.0, .z = 1.0},
+        {.x = 0.0, .y = 1.0, .z = 0.0},
+    };
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates),
+        .sample_spacing = 0.25
+    };
+    OBJ_update_bounds(&object);
+
+    char path[] = "/tmp/object_file_tests_XXXXXX";
+    const int fd = mkstemp(path);
+    TF_assert(fd >= 0);
+    close(fd);
+
+    TF_assert(OBJF_write(path, &object) == 0);
+
+    struct OBJF_MappedObject *const mapped_object = OBJF_map(path);
+    TF_assert(mapped_object != NULL);
+
+    if (mapped_object != NULL)
+    {
+        const struct OBJ_Object *const mapped = OBJF_get_object(mapped_object);
+
+        TF_assert(mapped->length == object.length);
+
+        for (long long i = 0; i < mapped->length; ++i)
+        {
+            TF_assert_double_eq(mapped->coordinates[i].x, coordinates[i].x, granularity);
+            TF_assert_double_eq(mapped->coordinates[i].y, coordinates[i].y, granularity);
+            TF_assert_double_eq(mapped->coordinates[i].z, coordinates[i].z, granularity);
+            TF_assert_double_eq(mapped->surface_normals[i].x, surface_normals[i].x, granularity);
+            TF_assert_double_eq(mapped->surface_normals[i].y, surface_normals[i].y, granularity);
+            TF_assert_double_eq(mapped->surface_normals[i].z, surface_normals[i].z, granularity);
+        }
+
+        TF_assert_double_eq(mapped->bounds.min.x, -1.0, granularity);
+        TF_assert_double_eq(mapped->bounds.max.z, 3.0, granularity);
+        TF_assert_double_eq(mapped->sample_spacing, 0.25, granularity);
+
+        OBJF_unmap(mapped_object);
+    }
+
+    remove(path);
+}
+
+static void test_OBJF_map_invalid_file(void)
+{
+    char path[] = "/tmp/object_file_tests_XXXXXX";
+    const int fd = mkstemp(path);
+    TF_assert(fd >= 0);
+
+    static const char content[128] = "This is not an object file";
+    TF_assert(write(fd, content, sizeof(content)) == (ssize_t)sizeof(content));
+    close(fd);
+
+    TF_assert(OBJF_map(path) == NULL);
+
+    remove(path);
+}
+
+static void test_OBJF_map_huge_length(void)
+{
+    char path[] = "/tmp/object_file_tests_XXXXXX";
+    write_object_file(path);
+
+    /* The size of the arrays overflows */
+    write_header_field(path, LENGTH_OFFSET, UINT64_MAX / 8U);
+    TF_assert(OBJF_map(path) == NULL);
+
+    /* The size of the arrays does not overflow, but they are larger than the file */
+    write_header_field(path, LENGTH_OFFSET, 1000000U);
+    TF_assert(OBJF_map(path) == NULL);
+
+    remove(path);
+}
+
+static void test_OBJF_map_huge_offset(void)
+{
+    char path[] = "/tmp/object_file_tests_XXXXXX";
+    write_object_file(path);
+
+    const uint64_t coordinates_offset = read_header_field(path, COORDINATES_OFFSET_OFFSET);
+
+    /* The end of the coordinates wraps around to a small offset inside the file */
+    write_header_field(path, LENGTH_OFFSET, 3U);
+    write_header_field(path, COORDINATES_OFFSET_OFFSET, UINT64_MAX - 63U);
+    write_header_field(path, SURFACE_NORMALS_OFFSET_OFFSET, coordinates_offset);
+    TF_assert(OBJF_map(path) == NULL);
+
+    /* The same for the surface normals */
+    write_header_field(path, COORDINATES_OFFSET_OFFSET, coordinates_offset);
+    write_header_field(path, SURFACE_NORMALS_OFFSET_OFFSET, UINT64_MAX - 63U);
+    TF_assert(OBJF_map(path) == NULL);
+
+    /* The original header is valid */
+    write_header_field(path, LENGTH_OFFSET, 2U);
+    write_header_field(path, SURFACE_NORMALS_OFFSET_OFFSET, coordinates_offset + 64U);
+    struct OBJF_MappedObject *const mapped_object = OBJF_map(path);
+    TF_assert(mapped_object != NULL);
+
+    if (mapped_object != NULL)
+    {
+        OBJF_unmap(mapped_object);
+    }
+
+    remove(path);
+}
+
+static void test_OBJF_map_missing_file(void)
+{
+    TF_assert(OBJF_map("/tmp/object_file_tests_this_file_does_not_exist") == NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_OBJF_write_and_map,
+        test_OBJF_map_invalid_file,
+        test_OBJF_map_huge_length,
+        test_OBJF_map_huge_offset,
+        test_OBJF_map_missing_file,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
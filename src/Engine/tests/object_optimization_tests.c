@@ -0,0 +1,155 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/object_optimization.h>
+#include <TestFramework/test_framework.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void test_OBJOPT_sort_morton(void)
+{
+    /* The corners of a cube, the Morton order visits x first, then y and last z. */
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = 1.0, .z = 1.0},
+        {.x = 0.0, .y = 1.0, .z = 0.0},
+        {.x = 1.0, .y = 0.0, .z = 1.0},
+        {.x = 0.0, .y = 0.0, .z = 0.0},
+        {.x = 1.0, .y = 1.0, .z = 0.0},
+        {.x = 0.0, .y = 0.0, .z = 1.0},
+        {.x = 1.0, .y = 0.0, .z = 0.0},
+        {.x = 0.0, .y = 1.0, .z = 1.0},
+    };
+    struct COORD_Coordinate3D surface_normals[LENGTH(coordinates)];
+
+    for (size_t i = 0; i < LENGTH(coordinates); ++i)
+    {
+        surface_normals[i] = coordinates[i];
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates)
+    };
+    OBJ_update_bounds(&object);
+
+    OBJOPT_sort_morton(&object);
+
+    for (long long i = 0; i < object.length; ++i)
+    {
+        TF_assert_double_eq(coordinates[i].x, (double)(i & 1), granularity);
+        TF_assert_double_eq(coordinates[i].y, (double)((i >> 1) & 1), granularity);
+        TF_assert_double_eq(coordinates[i].z, (double)((i >> 2) & 1), granularity);
+        TF_assert_double_eq(surface_normals[i].x, coordinates[i].x, granularity);
+        TF_assert_double_eq(surface_normals[i].y, coordinates[i].y, granularity);
+        TF_assert_double_eq(surface_normals[i].z, coordinates[i].z, granularity);
+    }
+}
+
+static void test_OBJOPT_sort_morton_locality(void)
+{
+    /* Points on a line (increasing in all axes) are sorted along the line. */
+    struct COORD_Coordinate3D coordinates[100];
+    struct COORD_Coordinate3D surface_normals[LENGTH(coordinates)];
+
+    for (size_t i = 0; i < LENGTH(coordinates); ++i)
+    {
+        coordinates[i].x = (double)((i * 37U) % LENGTH(coordinates));
+        coordinates[i].y = 2.0 * coordinates[i].x;
+        coordinates[i].z = 3.0 * coordinates[i].x;
+        surface_normals[i] = coordinates[i];
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates)
+    };
+    OBJ_update_bounds(&object);
+
+    OBJOPT_sort_morton(&object);
+
+    for (long long i = 0; i < object.length; ++i)
+    {
+        TF_assert_double_eq(coordinates[i].x, (double)i, granularity);
+        TF_assert_double_eq(surface_normals[i].y, 2.0 * (double)i, granularity);
+    }
+}
+
+static void test_OBJOPT_weld(void)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 0.0, .y = 0.0, .z = 0.0},
+        {.x = 1.0, .y = 0.0, .z = 0.0},
+        {.x = 0.0, .y = 0.0, .z = 0.05}, /* Welded with the first point */
+        {.x = 1.09, .y = 0.0, .z = 0.0}, /* Welded with the second point, in a neighboring cell */
+        {.x = 0.0, .y = 0.2, .z = 0.0},
+        {.x = 1.0, .y = 0.0, .z = 0.0}, /* Welded with the second point */
+        {.x = -0.01, .y = -0.01, .z = -0.01}, /* Welded with the first point, in a neighboring cell */
+    };
+    struct COORD_Coordinate3D surface_normals[LENGTH(coordinates)];
+
+    for (size_t i = 0; i < LENGTH(coordinates); ++i)
+    {
+        surface_normals[i].x = (double)i;
+        surface_normals[i].y = 0.0;
+        surface_normals[i].z = 0.0;
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates)
+    };
+
+    const long long removed = OBJOPT_weld(&object, 0.1);
+
+    TF_assert(removed == 4);
+    TF_assert(object.length == 3);
+    TF_assert_double_eq(coordinates[0].x, 0.0, granularity);
+    TF_assert_double_eq(coordinates[1].x, 1.0, granularity);
+    TF_assert_double_eq(coordinates[2].y, 0.2, granularity);
+    TF_assert_double_eq(surface_normals[0].x, 0.0, granularity);
+    TF_assert_double_eq(surface_normals[1].x, 1.0, granularity);
+    TF_assert_double_eq(surface_normals[2].x, 4.0, granularity);
+    TF_assert_double_eq(object.bounds.max.x, 1.0, granularity);
+    TF_assert_double_eq(object.bounds.max.y, 0.2, granularity);
+}
+
+static void test_OBJOPT_weld_distinct_points(void)
+{
+    struct COORD_Coordinate3D coordinates[27];
+
+    for (size_t i = 0; i < LENGTH(coordinates); ++i)
+    {
+        coordinates[i].x = (double)(i % 3U) * 0.11;
+        coordinates[i].y = (double)((i / 3U) % 3U) * 0.11;
+        coordinates[i].z = (double)(i / 9U) * 0.11;
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = coordinates,
+        .length = LENGTH(coordinates)
+    };
+
+    TF_assert(OBJOPT_weld(&object, 0.1) == 0);
+    TF_assert(object.length == LENGTH(coordinates));
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_OBJOPT_sort_morton,
+        test_OBJOPT_sort_morton_locality,
+        test_OBJOPT_weld,
+        test_OBJOPT_weld_distinct_points,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,164 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void test_OBJ_update_bounds(void)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = -2.0, .z = 3.0},
+        {.x = -4.0, .y = 5.0, .z = 0.5},
+        {.x = 0.0, .y = 0.0, .z = -6.0},
+    };
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = coordinates,
+        .length = LENGTH(coordinates)
+    };
+
+    OBJ_update_bounds(&object);
+
+    TF_assert_double_eq(object.bounds.min.x, -4.0, granularity);
+    TF_assert_double_eq(object.bounds.min.y, -2.0, granularity);
+    TF_assert_double_eq(object.bounds.min.z, -6.0, granularity);
+    TF_assert_double_eq(object.bounds.max.x, 1.0, granularity);
+    TF_assert_double_eq(object.bounds.max.y, 5.0, granularity);
+    TF_assert_double_eq(object.bounds.max.z, 3.0, granularity);
+}
+
+static void test_OBJ_get_bounds(void)
+{
+    const struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = -2.0, .z = 3.0},
+        {.x = -4.0, .y = 5.0, .z = 0.5},
+        {.x = 0.0, .y = 0.0, .z = -6.0},
+    };
+    struct OBJ_BoundingBox bounds;
+
+    /* Only the first two coordinates */
+    OBJ_get_bounds(coordinates, 2, &bounds);
+
+    TF_assert_double_eq(bounds.min.x, -4.0, granularity);
+    TF_assert_double_eq(bounds.min.z, 0.5, granularity);
+    TF_assert_double_eq(bounds.max.y, 5.0, granularity);
+    TF_assert_double_eq(bounds.max.z, 3.0, granularity);
+
+    OBJ_get_bounds(coordinates, 0, &bounds);
+
+    TF_assert(bounds.min.x > bounds.max.x);
+}
+
+static void test_OBJ_compress(void)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = -2.0, .z = 3.0},
+        {.x = -4.0, .y = 5.0, .z = 0.5},
+        {.x = 0.1234, .y = 0.0, .z = -6.0},
+        {.x = 0.0, .y = 1.0, .z = 3.0},
+    };
+    struct COORD_Coordinate3D surface_normals[] = {
+        {.x = 0.0, .y = 0.0, .z = 1.0},
+        {.x = 0.0, .y = 0.0, .z = -2.0},
+        {.x = 1.0, .y = -2.0, .z = -3.0},
+        {.x = -0.6, .y = 0.0, .z = 0.8},
+    };
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates),
+        .sample_spacing = 0.01
+    };
+
+    OBJ_update_bounds(&object);
+
+    struct OBJ_CompressedObject *const compressed = OBJ_compress(&object);
+
+    TF_assert(compressed->length == object.length);
+    TF_assert_double_eq(compressed->sample_spacing, object.sample_spacing, granularity);
+    TF_assert(sizeof(*compressed->points) == 10U);
+
+    for (long long i = 0; i < object.length; ++i)
+    {
+        struct COORD_Coordinate3D coordinate;
+        struct COORD_Coordinate3D surface_normal;
+        OBJ_get_compressed_point(compressed, i, &coordinate, &surface_normal);
+
+        /* Half a quantization step of the largest extent (7 m) */
+        TF_assert_double_eq(coordinate.x, coordinates[i].x, 6e-5);
+        TF_assert_double_eq(coordinate.y, coordinates[i].y, 6e-5);
+        TF_assert_double_eq(coordinate.z, coordinates[i].z, 6e-5);
+
+        const struct COORD_Coordinate3D *const normal = &surface_normals[i];
+        const double norm = sqrt(normal->x * normal->x + normal->y * normal->y + normal->z * normal->z);
+        TF_assert_double_eq(surface_normal.x, normal->x / norm, 1e-4);
+        TF_assert_double_eq(surface_normal.y, normal->y / norm, 1e-4);
+        TF_assert_double_eq(surface_normal.z, normal->z / norm, 1e-4);
+    }
+
+    OBJ_free_compressed(compressed);
+}
+
+static void test_OBJ_get_compressed_bounds(void)
+{
+    struct COORD_Coordinate3D coordinates[] = {
+        {.x = 1.0, .y = -2.0, .z = 3.0},
+        {.x = -4.0, .y = 5.0, .z = 0.5},
+        {.x = 0.0, .y = 0.0, .z = -6.0},
+    };
+    /* A zero surface normal is encoded as the z axis */
+    struct COORD_Coordinate3D surface_normals[LENGTH(coordinates)] = {{.x = 0.0}};
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = LENGTH(coordinates)
+    };
+
+    OBJ_update_bounds(&object);
+
+    struct OBJ_CompressedObject *const compressed = OBJ_compress(&object);
+    const double quantization_step = 7.0 / 65535.0;
+    struct OBJ_BoundingBox bounds;
+
+    /* Only the last two coordinates, the range is quantized in steps of 7 m / 65535 */
+    OBJ_get_compressed_bounds(compressed, 1, 2, &bounds);
+
+    TF_assert_double_eq(bounds.min.x, -4.0, quantization_step);
+    TF_assert_double_eq(bounds.min.y, 0.0, quantization_step);
+    TF_assert_double_eq(bounds.min.z, -6.0, quantization_step);
+    TF_assert_double_eq(bounds.max.x, 0.0, quantization_step);
+    TF_assert_double_eq(bounds.max.y, 5.0, quantization_step);
+    TF_assert_double_eq(bounds.max.z, 0.5, quantization_step);
+
+    OBJ_get_compressed_bounds(compressed, 3, 0, &bounds);
+
+    TF_assert(bounds.min.x > bounds.max.x);
+
+    struct COORD_Coordinate3D coordinate;
+    struct COORD_Coordinate3D surface_normal;
+    OBJ_get_compressed_point(compressed, 0, &coordinate, &surface_normal);
+
+    TF_assert_double_eq(surface_normal.z, 1.0, granularity);
+
+    OBJ_free_compressed(compressed);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_OBJ_update_bounds,
+        test_OBJ_get_bounds,
+        test_OBJ_compress,
+        test_OBJ_get_compressed_bounds,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,107 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/particles.h>
+#include <TestFramework/test_framework.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void test_PART_emit(void)
+{
+    struct PART_ParticleSystem *const particle_system = PART_create(10, 1);
+    const struct PART_Emitter emitter = {
+        .position = {.x = 1.0, .y = 2.0, .z = 3.0},
+        .velocity = {.x = 0.0, .y = 1.0, .z = 0.0},
+        .velocity_spread = 0.5,
+        .lifetime = 1.0,
+        .intensity = 0.25
+    };
+
+    TF_assert(PART_emit(particle_system, &emitter, 6) == 6);
+    TF_assert(PART_emit(particle_system, &emitter, 6) == 4);
+    TF_assert(PART_emit(particle_system, &emitter, 1) == 0);
+
+    struct PART_Particles particles;
+    PART_get_particles(particle_system, &particles);
+    TF_assert(particles.length == 10);
+
+    for (int i = 0; i < particles.length; ++i)
+    {
+        TF_assert_double_eq(particles.x[i], 1.0, granularity);
+        TF_assert_double_eq(particles.z[i], 3.0, granularity);
+        TF_assert_double_eq(particles.intensity[i], 0.25, granularity);
+    }
+
+    /* The initial velocities are within the spread */
+    const struct COORD_Coordinate3D no_acceleration = {.x = 0.0, .y = 0.0, .z = 0.0};
+    PART_update(particle_system, &no_acceleration, 0.5);
+    PART_get_particles(particle_system, &particles);
+
+    for (int i = 0; i < particles.length; ++i)
+    {
+        TF_assert((particles.x[i] >= 0.75) && (particles.x[i] <= 1.25));
+        TF_assert((particles.y[i] >= 2.25) && (particles.y[i] <= 2.75));
+    }
+
+    PART_destroy(particle_system);
+}
+
+static void test_PART_update(void)
+{
+    struct PART_ParticleSystem *const particle_system = PART_create(10, 1);
+    const struct PART_Emitter short_lived = {
+        .position = {.x = 0.0, .y = 0.0, .z = 0.0},
+        .velocity = {.x = 1.0, .y = 0.0, .z = 0.0},
+        .lifetime = 0.15,
+        .intensity = 0.0
+    };
+    const struct PART_Emitter long_lived = {
+        .position = {.x = 0.0, .y = 0.0, .z = 5.0},
+        .velocity = {.x = 1.0, .y = 0.0, .z = 0.0},
+        .lifetime = 1.0,
+        .intensity = 1.0
+    };
+    const struct COORD_Coordinate3D gravity = {.x = 0.0, .y = -10.0, .z = 0.0};
+
+    PART_emit(particle_system, &short_lived, 2);
+    PART_emit(particle_system, &long_lived, 1);
+    PART_emit(particle_system, &short_lived, 2);
+    PART_emit(particle_system, &long_lived, 1);
+
+    PART_update(particle_system, &gravity, 0.1);
+
+    struct PART_Particles particles;
+    PART_get_particles(particle_system, &particles);
+    TF_assert(particles.length == 6);
+    TF_assert_double_eq(particles.x[0], 0.1, granularity);
+    TF_assert_double_eq(particles.y[0], -0.1, granularity);
+
+    /* The short-lived particles die, the rest are moved to the beginning */
+    PART_update(particle_system, &gravity, 0.1);
+    PART_get_particles(particle_system, &particles);
+    TF_assert(particles.length == 2);
+
+    for (int i = 0; i < particles.length; ++i)
+    {
+        TF_assert_double_eq(particles.x[i], 0.2, granularity);
+        TF_assert_double_eq(particles.y[i], -0.3, granularity);
+        TF_assert_double_eq(particles.z[i], 5.0, granularity);
+        TF_assert_double_eq(particles.intensity[i], 1.0, granularity);
+    }
+
+    PART_destroy(particle_system);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_PART_emit,
+        test_PART_update,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,246 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/point_cloud.h>
+#include <TestFramework/test_framework.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static const struct COORD_Coordinate3D expected_coordinates[] = {
+    {.x = 1.0, .y = 2.0, .z = 3.0},
+    {.x = -1.5, .y = 0.25, .z = 1e-3},
+    {.x = 4.0, .y = -5.0, .z = 600.0},
+};
+
+static const struct COORD_Coordinate3D expected_surface_normals[] = {
+    {.x = 0.0, .y = 0.0, .z = 1.0},
+    {.x = 0.0, .y = -1.0, .z = 0.0},
+    {.x = 1.0, .y = 0.0, .z = 0.0},
+};
+
+static void write_file(
+    char *const path,
+    const void *const content,
+    const size_t size)
+{
+    const int fd = mkstemp(path);
+    TF_assert(fd >= 0);
+    TF_assert(write(fd, content, size) == (ssize_t)size);
+    close(fd);
+}
+
+static void write_ply_file(
+    char *const path)
+{
+    static const char header[] =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "comment Written by point_cloud_tests\n"
+        "element vertex 3\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "property uchar red\n"
+        "property double nx\n"
+        "property double ny\n"
+        "property double nz\n"
+        "element face 0\n"
+        "property list uchar int vertex_indices\n"
+        "end_header\n";
+    const size_t stride = (3 * sizeof(float)) + 1 + (3 * sizeof(double));
+    unsigned char content[sizeof(header) + (3 * stride)];
+
+    memcpy(content, header, sizeof(header) - 1);
+
+    for (size_t i = 0; i < LENGTH(expected_coordinates); ++i)
+    {
+        unsigned char *const vertex = &content[sizeof(header) - 1 + (i * stride)];
+        const float coordinate[] = {
+            (float)expected_coordinates[i].x,
+            (float)expected_coordinates[i].y,
+            (float)expected_coordinates[i].z
+        };
+        const double surface_normal[] = {
+            expected_surface_normals[i].x,
+            expected_surface_normals[i].y,
+            expected_surface_normals[i].z
+        };
+
+        memcpy(vertex, coordinate, sizeof(coordinate));
+        vertex[sizeof(coordinate)] = 255U;
+        memcpy(&vertex[sizeof(coordinate) + 1], surface_normal, sizeof(surface_normal));
+    }
+
+    write_file(path, content, sizeof(header) - 1 + (3 * stride));
+}
+
+static void write_xyz_file(
+    char *const path)
+{
+    static const char content[] =
+        "# x y z nx ny nz\n"
+        "1 2 3 0 0 1\n"
+        "\n"
+        "-1.5 0.25 1e-3 0.0 -1.0 0.0\r\n"
+        "  +4.0\t-5 6E2 1 0 0";
+
+    write_file(path, content, sizeof(content) - 1);
+}
+
+static void assert_expected_points(
+    const struct COORD_Coordinate3D *const coordinates,
+    const struct COORD_Coordinate3D *const surface_normals,
+    const long long length)
+{
+    TF_assert(length == LENGTH(expected_coordinates));
+
+    for (long long i = 0; (i < length) && (i < (long long)LENGTH(expected_coordinates)); ++i)
+    {
+        TF_assert_double_eq(coordinates[i].x, expected_coordinates[i].x, granularity);
+        TF_assert_double_eq(coordinates[i].y, expected_coordinates[i].y, granularity);
+        TF_assert_double_eq(coordinates[i].z, expected_coordinates[i].z, granularity);
+        TF_assert_double_eq(surface_normals[i].x, expected_surface_normals[i].x, granularity);
+        TF_assert_double_eq(surface_normals[i].y, expected_surface_normals[i].y, granularity);
+        TF_assert_double_eq(surface_normals[i].z, expected_surface_normals[i].z, granularity);
+    }
+}
+
+static void assert_load(
+    const char *const path)
+{
+    struct PCL_PointCloud *const point_cloud = PCL_open(path);
+    TF_assert(point_cloud != NULL);
+
+    if (point_cloud != NULL)
+    {
+        struct OBJ_Object *const object = PCL_load(point_cloud);
+        TF_assert(object != NULL);
+
+        if (object != NULL)
+        {
+            assert_expected_points(object->coordinates, object->surface_normals, object->length);
+            TF_assert_double_eq(object->bounds.max.z, 600.0, granularity);
+            PCL_free_object(object);
+        }
+
+        PCL_close(point_cloud);
+    }
+}
+
+static void assert_stream(
+    const char *const path)
+{
+    struct PCL_PointCloud *const point_cloud = PCL_open(path);
+    TF_assert(point_cloud != NULL);
+
+    if (point_cloud != NULL)
+    {
+        const struct OBJ_PointSource *const point_source = PCL_get_point_source(point_cloud);
+        struct COORD_Coordinate3D coordinates[LENGTH(expected_coordinates) + 1];
+        struct COORD_Coordinate3D surface_normals[LENGTH(expected_coordinates) + 1];
+        long long position = 0;
+        long long length = 0;
+        long long chunk_length = 0;
+
+        /* Read two points at a time to make sure the position is handled correctly. */
+        while ((chunk_length = point_source->read(
+            point_source->context, &position, &coordinates[length], &surface_normals[length], 2)) > 0)
+        {
+            length += chunk_length;
+        }
+
+        assert_expected_points(coordinates, surface_normals, length);
+        PCL_close(point_cloud);
+    }
+}
+
+static void test_PCL_load_ply(void)
+{
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_ply_file(path);
+    assert_load(path);
+    remove(path);
+}
+
+static void test_PCL_load_xyz(void)
+{
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_xyz_file(path);
+    assert_load(path);
+    remove(path);
+}
+
+static void test_PCL_stream_ply(void)
+{
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_ply_file(path);
+    assert_stream(path);
+    remove(path);
+}
+
+static void test_PCL_stream_xyz(void)
+{
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_xyz_file(path);
+    assert_stream(path);
+    remove(path);
+}
+
+static void test_PCL_load_malformed_xyz(void)
+{
+    static const char content[] = "1 2 3 0 0 1\n1 2 three 0 0 1\n";
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_file(path, content, sizeof(content) - 1);
+
+    struct PCL_PointCloud *const point_cloud = PCL_open(path);
+    TF_assert(point_cloud != NULL);
+
+    if (point_cloud != NULL)
+    {
+        TF_assert(PCL_load(point_cloud) == NULL);
+        PCL_close(point_cloud);
+    }
+
+    remove(path);
+}
+
+static void test_PCL_open_unsupported_ply(void)
+{
+    static const char content[] =
+        "ply\n"
+        "format ascii 1.0\n"
+        "element vertex 1\n"
+        "property float x\n"
+        "end_header\n"
+        "1\n";
+    char path[] = "/tmp/point_cloud_tests_XXXXXX";
+    write_file(path, content, sizeof(content) - 1);
+
+    TF_assert(PCL_open(path) == NULL);
+
+    remove(path);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_PCL_load_ply,
+        test_PCL_load_xyz,
+        test_PCL_stream_ply,
+        test_PCL_stream_xyz,
+        test_PCL_load_malformed_xyz,
+        test_PCL_open_unsupported_ply,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,73 @@
+#include "../quality_governor.h"
+
+#include <Base/common.h>
+#include <TestFramework/test_framework.h>
+
+int TF_test_case_status;
+
+/**
+ * \brief Run frames with the same load
+ *
+ * \return The quality level after the frames
+ */
+static int run_frames(
+    struct QGOV_QualityGovernor *const governor,
+    const double load,
+    const int frames)
+{
+    int level = QGOV_get_level(governor);
+
+    for (int i = 0; i < frames; ++i)
+    {
+        level = QGOV_update(governor, load);
+    }
+
+    return level;
+}
+
+static void test_QGOV_update_overload(void)
+{
+    struct QGOV_QualityGovernor *const governor = QGOV_create();
+
+    TF_assert(QGOV_get_level(governor) == 0);
+
+    /* A single slow frame is not enough */
+    TF_assert(QGOV_update(governor, 2.0) == 0);
+
+    /* The quality is lowered one level at a time down to the lowest level */
+    TF_assert(run_frames(governor, 2.0, 3) == 1);
+    TF_assert(run_frames(governor, 2.0, 5) == 1);
+    TF_assert(run_frames(governor, 2.0, 100) == QGOV_MAX_LEVEL);
+
+    /* And raised again when there is headroom */
+    TF_assert(run_frames(governor, 0.1, 100) == 0);
+
+    QGOV_destroy(governor);
+}
+
+static void test_QGOV_update_hysteresis(void)
+{
+    struct QGOV_QualityGovernor *const governor = QGOV_create();
+
+    /* Lower the quality once */
+    TF_assert(run_frames(governor, 1.2, 10) == 1);
+
+    /* Loads between the thresholds keep the current level */
+    TF_assert(run_frames(governor, 0.9, 100) == 1);
+    TF_assert(run_frames(governor, 0.5, 100) == 1);
+
+    QGOV_destroy(governor);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_QGOV_update_overload,
+        test_QGOV_update_hysteresis,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,162 @@
+#include "../rasterizer.h"
+
+#include <Base/common.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static char shader(
+    const double illumination)
+{
+    return (illumination < 0.5) ? 'd' : 'b';
+}
+
+static void reset_buffers(
+    struct MAT_Matrix *const frame_buffer,
+    struct MAT_Matrix *const z_buffer)
+{
+    MAT_set_all_elements(frame_buffer, (double)' ');
+    MAT_set_all_elements(z_buffer, INFINITY);
+}
+
+static int is_drawn(
+    const struct MAT_Matrix *const frame_buffer,
+    const int y,
+    const int x)
+{
+    return (char)MAT_get_element(frame_buffer, y, x) != ' ';
+}
+
+static void test_RAST_draw_triangle(void)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(10, 10);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 10);
+    const struct RAST_Vertex v0 = {.image_coordinate = {.x = 1.0, .y = 1.0}, .depth = 2.0, .illumination = 1.0};
+    const struct RAST_Vertex v1 = {.image_coordinate = {.x = 8.0, .y = 1.0}, .depth = 2.0, .illumination = 1.0};
+    const struct RAST_Vertex v2 = {.image_coordinate = {.x = 1.0, .y = 8.0}, .depth = 2.0, .illumination = 0.0};
+    const struct RAST_Vertex *const triangle[] = {&v0, &v1, &v2};
+    const struct RAST_Vertex *const reversed_triangle[] = {&v2, &v1, &v0};
+
+    for (int winding = 0; winding < 2; ++winding)
+    {
+        reset_buffers(frame_buffer, z_buffer);
+        RAST_draw_triangle((winding == 0) ? triangle : reversed_triangle, shader, frame_buffer, z_buffer);
+
+        /* Inside, on the edges, partly overlapped and outside of the triangle */
+        TF_assert(is_drawn(frame_buffer, 2, 2));
+        TF_assert(is_drawn(frame_buffer, 1, 7));
+        TF_assert(is_drawn(frame_buffer, 4, 4));
+        TF_assert(is_drawn(frame_buffer, 5, 5));
+        TF_assert(!is_drawn(frame_buffer, 0, 0));
+        TF_assert(!is_drawn(frame_buffer, 6, 6));
+        TF_assert(!is_drawn(frame_buffer, 9, 9));
+
+        /* The illumination is interpolated */
+        TF_assert((char)MAT_get_element(frame_buffer, 1, 1) == 'b');
+        TF_assert((char)MAT_get_element(frame_buffer, 7, 1) == 'd');
+
+        TF_assert_double_eq(MAT_get_element(z_buffer, 2, 2), 2.0, granularity);
+        TF_assert(isinf(MAT_get_element(z_buffer, 6, 6)));
+    }
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+static void test_RAST_draw_triangle_perspective_depth(void)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(10, 10);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 10);
+    const struct RAST_Vertex v0 = {.image_coordinate = {.x = 0.0, .y = 0.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex v1 = {.image_coordinate = {.x = 8.0, .y = 0.0}, .depth = 3.0, .illumination = 1.0};
+    const struct RAST_Vertex v2 = {.image_coordinate = {.x = 0.0, .y = 8.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex *const triangle[] = {&v0, &v1, &v2};
+
+    reset_buffers(frame_buffer, z_buffer);
+    RAST_draw_triangle(triangle, shader, frame_buffer, z_buffer);
+
+    /* Half way between a vertex at depth 1 and a vertex at depth 3 in the image, the inverse depth
+     * is the mean of the inverse depths, i.e. the depth is 1.5 (not 2). */
+    TF_assert_double_eq(MAT_get_element(z_buffer, 0, 4), 1.5, granularity);
+    TF_assert_double_eq(MAT_get_element(z_buffer, 0, 8), 3.0, granularity);
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+static void test_RAST_draw_triangle_occlusion(void)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(10, 10);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 10);
+    const struct RAST_Vertex near0 = {.image_coordinate = {.x = 0.0, .y = 0.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex near1 = {.image_coordinate = {.x = 9.0, .y = 0.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex near2 = {.image_coordinate = {.x = 0.0, .y = 9.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex far0 = {.image_coordinate = {.x = 0.0, .y = 0.0}, .depth = 2.0, .illumination = 0.0};
+    const struct RAST_Vertex far1 = {.image_coordinate = {.x = 9.0, .y = 0.0}, .depth = 2.0, .illumination = 0.0};
+    const struct RAST_Vertex far2 = {.image_coordinate = {.x = 9.0, .y = 9.0}, .depth = 2.0, .illumination = 0.0};
+    const struct RAST_Vertex *const near_triangle[] = {&near0, &near1, &near2};
+    const struct RAST_Vertex *const far_triangle[] = {&far0, &far1, &far2};
+
+    reset_buffers(frame_buffer, z_buffer);
+    RAST_draw_triangle(near_triangle, shader, frame_buffer, z_buffer);
+    RAST_draw_triangle(far_triangle, shader, frame_buffer, z_buffer);
+
+    TF_assert((char)MAT_get_element(frame_buffer, 1, 5) == 'b');
+    TF_assert((char)MAT_get_element(frame_buffer, 5, 8) == 'd');
+    TF_assert_double_eq(MAT_get_element(z_buffer, 1, 5), 1.0, granularity);
+    TF_assert_double_eq(MAT_get_element(z_buffer, 5, 8), 2.0, granularity);
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+static void test_RAST_draw_triangle_not_drawn(void)
+{
+    struct MAT_Matrix *const frame_buffer = MAT_alloc(10, 10);
+    struct MAT_Matrix *const z_buffer = MAT_alloc(10, 10);
+    const struct RAST_Vertex v0 = {.image_coordinate = {.x = 0.0, .y = 0.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex v1 = {.image_coordinate = {.x = 9.0, .y = 0.0}, .depth = 1.0, .illumination = 1.0};
+    const struct RAST_Vertex behind = {.image_coordinate = {.x = 0.0, .y = 9.0}, .depth = -1.0, .illumination = 1.0};
+    const struct RAST_Vertex outside = {.image_coordinate = {.x = 20.0, .y = 20.0}, .depth = 1.0};
+    const struct RAST_Vertex outside_x = {.image_coordinate = {.x = 30.0, .y = 20.0}, .depth = 1.0};
+    const struct RAST_Vertex outside_y = {.image_coordinate = {.x = 20.0, .y = 30.0}, .depth = 1.0};
+    const struct RAST_Vertex *const behind_camera[] = {&v0, &v1, &behind};
+    const struct RAST_Vertex *const degenerate[] = {&v0, &v1, &v1};
+    const struct RAST_Vertex *const outside_screen[] = {&outside, &outside_x, &outside_y};
+
+    reset_buffers(frame_buffer, z_buffer);
+    RAST_draw_triangle(behind_camera, shader, frame_buffer, z_buffer);
+    RAST_draw_triangle(degenerate, shader, frame_buffer, z_buffer);
+    RAST_draw_triangle(outside_screen, shader, frame_buffer, z_buffer);
+
+    for (int y = 0; y < frame_buffer->rows; ++y)
+    {
+        for (int x = 0; x < frame_buffer->cols; ++x)
+        {
+            TF_assert(!is_drawn(frame_buffer, y, x));
+        }
+    }
+
+    MAT_free(z_buffer);
+    MAT_free(frame_buffer);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_RAST_draw_triangle,
+        test_RAST_draw_triangle_perspective_depth,
+        test_RAST_draw_triangle_occlusion,
+        test_RAST_draw_triangle_not_drawn,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,664 @@
+#include <Base/common.h>
+#include <Engine/camera.h>
+#include <Engine/object.h>
+#include <Engine/particles.h>
+#include <Engine/renderer.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <string.h>
+
+int TF_test_case_status;
+
+#define WIDTH (60)
+#define HEIGHT (30)
+#define NUMBER_OF_VIEWS (3)
+#define LATITUDES (40)
+#define LONGITUDES (80)
+#define NUMBER_OF_POINTS (LATITUDES * LONGITUDES)
+#define RADIUS (0.5)
+
+static struct COORD_Coordinate3D coordinates[NUMBER_OF_POINTS];
+static struct COORD_Coordinate3D surface_normals[NUMBER_OF_POINTS];
+/* Two triangles between each pair of neighboring latitudes and longitudes */
+static long long indices[3 * 2 * (LATITUDES - 1) * LONGITUDES];
+
+/* A sphere of points */
+static void create_sphere(
+    struct OBJ_Object *const object)
+{
+    for (int i = 0; i < LATITUDES; ++i)
+    {
+        for (int j = 0; j < LONGITUDES; ++j)
+        {
+            const double latitude = M_PI * (i + 0.5) / LATITUDES;
+            const double longitude = 2.0 * M_PI * j / LONGITUDES;
+            struct COORD_Coordinate3D *const normal = &surface_normals[i * LONGITUDES + j];
+
+            normal->x = sin(latitude) * cos(longitude);
+            normal->y = cos(latitude);
+            normal->z = sin(latitude) * sin(longitude);
+            coordinates[i * LONGITUDES + j] = (struct COORD_Coordinate3D){
+                .x = RADIUS * normal->x, .y = RADIUS * normal->y, .z = RADIUS * normal->z};
+        }
+    }
+
+    *object = (struct OBJ_Object){
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = NUMBER_OF_POINTS,
+        .sample_spacing = RADIUS * M_PI / LATITUDES
+    };
+    OBJ_update_bounds(object);
+}
+
+/* A sphere of triangles, the vertices are the points of the sphere */
+static void create_sphere_mesh(
+    struct OBJ_Mesh *const mesh)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    long long *index = indices;
+
+    for (int i = 0; i < LATITUDES - 1; ++i)
+    {
+        for (int j = 0; j < LONGITUDES; ++j)
+        {
+            const long long corner = i * LONGITUDES + j;
+            const long long right = i * LONGITUDES + (j + 1) % LONGITUDES;
+
+            *index++ = corner;
+            *index++ = right;
+            *index++ = corner + LONGITUDES;
+            *index++ = right;
+            *index++ = right + LONGITUDES;
+            *index++ = corner + LONGITUDES;
+        }
+    }
+
+    *mesh = (struct OBJ_Mesh){
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = NUMBER_OF_POINTS,
+        .indices = indices,
+        .number_of_triangles = LENGTH(indices) / 3,
+        .bounds = sphere.bounds
+    };
+}
+
+static long long read_sphere(
+    const void *const context,
+    long long *const position,
+    struct COORD_Coordinate3D *const chunk_coordinates,
+    struct COORD_Coordinate3D *const chunk_surface_normals,
+    const long long max_points)
+{
+    UNUSED(context);
+
+    const long long remaining = NUMBER_OF_POINTS - *position;
+    const long long length = (remaining < max_points) ? remaining : max_points;
+
+    memcpy(chunk_coordinates, &coordinates[*position], (size_t)length * sizeof(*chunk_coordinates));
+    memcpy(chunk_surface_normals, &surface_normals[*position], (size_t)length * sizeof(*chunk_surface_normals));
+    *position += length;
+
+    return length;
+}
+
+/* A camera at the given position looking along the z-axis */
+static void get_calibration(
+    const struct COORD_Coordinate3D *const translation,
+    struct CAM_CameraParameters *const calibration)
+{
+    const struct COORD_Coordinate2D optical_center = {.x = WIDTH / 2.0, .y = HEIGHT / 2.0};
+    const struct CST_Rotation3D rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0};
+
+    CAM_get_camera_calibration(9.0, 20.0, 1.0, &optical_center, translation, &rotation, calibration);
+}
+
+/* Views side by side, the objects are outside the last view */
+static struct REND_Renderer * create_view(
+    const int view)
+{
+    const struct COORD_Coordinate3D translation = {.x = (view == NUMBER_OF_VIEWS - 1) ? 50.0 : 0.2 * view};
+
+    struct CAM_CameraParameters calibration;
+    get_calibration(&translation, &calibration);
+
+    return REND_create(&calibration, WIDTH, HEIGHT, 100.0);
+}
+
+static int is_equal(
+    const struct MAT_Matrix *const a,
+    const struct MAT_Matrix *const b)
+{
+    return memcmp(a->data, b->data, (size_t)(a->rows * a->cols) * sizeof(*a->data)) == 0;
+}
+
+static void test_REND_render_views(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    struct OBJ_CompressedObject *const compressed_sphere = OBJ_compress(&sphere);
+    const struct OBJ_PointSource point_source = {
+        .read = read_sphere, .context = NULL, .sample_spacing = sphere.sample_spacing};
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = -0.4, .y = 0.0, .z = 3.0}, .rotation = {.pitch = 0.3}},
+        {.point_source = &point_source, .position = {.x = 0.4, .y = 0.2, .z = 3.5}},
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 6.0}, .is_static = 1},
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = -3.0}},
+        {.compressed_object = compressed_sphere, .position = {.x = 0.0, .y = -0.5, .z = 4.0}},
+    };
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+
+    struct REND_Renderer *views[NUMBER_OF_VIEWS];
+    struct REND_Renderer *renderers[NUMBER_OF_VIEWS];
+
+    for (int i = 0; i < NUMBER_OF_VIEWS; ++i)
+    {
+        views[i] = create_view(i);
+        renderers[i] = create_view(i);
+    }
+
+    /* Twice, the second frame reuses the static layers */
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        REND_render_views(views, NUMBER_OF_VIEWS, &light_source, &model);
+
+        for (int i = 0; i < NUMBER_OF_VIEWS; ++i)
+        {
+            REND_render_frame(renderers[i], &light_source, &model);
+
+            TF_assert(is_equal(REND_get_frame_buffer(views[i]), REND_get_frame_buffer(renderers[i])));
+            TF_assert(is_equal(REND_get_z_buffer(views[i]), REND_get_z_buffer(renderers[i])));
+        }
+    }
+
+    /* Something is drawn in the first view and nothing in the last view */
+    TF_assert((char)MAT_get_element(REND_get_frame_buffer(views[0]), HEIGHT / 2, WIDTH / 2) != ' ');
+    TF_assert(isinf(MAT_get_element(REND_get_z_buffer(views[NUMBER_OF_VIEWS - 1]), HEIGHT / 2, WIDTH / 2)));
+
+    for (int i = 0; i < NUMBER_OF_VIEWS; ++i)
+    {
+        REND_destroy(renderers[i]);
+        REND_destroy(views[i]);
+    }
+
+    OBJ_free_compressed(compressed_sphere);
+}
+
+static void test_REND_render_frame_compressed(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    struct OBJ_CompressedObject *const compressed_sphere = OBJ_compress(&sphere);
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 2.0}, .rotation = {.pitch = 0.3, .yaw = 0.5}},
+    };
+    const struct REND_ObjectWithPosition compressed_objects[] = {
+        {.compressed_object = compressed_sphere, .position = {.x = 0.0, .y = 0.0, .z = 2.0},
+         .rotation = {.pitch = 0.3, .yaw = 0.5}},
+    };
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+    const struct REND_Objects compressed_model = {.objects = compressed_objects, .length = LENGTH(compressed_objects)};
+    struct REND_Renderer *const renderer = create_view(0);
+    struct REND_Renderer *const compressed_renderer = create_view(0);
+
+    REND_render_frame(renderer, &light_source, &model);
+    REND_render_frame(compressed_renderer, &light_source, &compressed_model);
+
+    /* The same pixels are drawn with at most the quantization error in depth. The colors are the same
+     * except for a few pixels close to the border between two illumination levels. */
+    const struct MAT_Matrix *const frame_buffer = REND_get_frame_buffer(renderer);
+    const struct MAT_Matrix *const compressed_frame_buffer = REND_get_frame_buffer(compressed_renderer);
+    const struct MAT_Matrix *const z_buffer = REND_get_z_buffer(renderer);
+    const struct MAT_Matrix *const compressed_z_buffer = REND_get_z_buffer(compressed_renderer);
+    const double illumination_step = REND_get_illumination(',') - REND_get_illumination('.');
+    int number_of_drawn_pixels = 0;
+    int number_of_different_pixels = 0;
+
+
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            const double depth = MAT_get_element(z_buffer, y, x);
+            const double compressed_depth = MAT_get_element(compressed_z_buffer, y, x);
+
+            if (isinf(depth))
+            {
+                TF_assert(isinf(compressed_depth));
+            }
+            else
+            {
+                const char color = (char)MAT_get_element(frame_buffer, y, x);
+                const char compressed_color = (char)MAT_get_element(compressed_frame_buffer, y, x);
+
+                TF_assert_double_eq(compressed_depth, depth, 1e-4);
+                TF_assert_double_eq(
+                    REND_get_illumination(compressed_color), REND_get_illumination(color), 1.5 * illumination_step);
+                number_of_different_pixels += (compressed_color != color);
+                ++number_of_drawn_pixels;
+            }
+        }
+    }
+
+    TF_assert(number_of_drawn_pixels > 100);
+    TF_assert(100 * number_of_different_pixels < number_of_drawn_pixels);
+
+    REND_destroy(compressed_renderer);
+    REND_destroy(renderer);
+    OBJ_free_compressed(compressed_sphere);
+}
+
+static void test_REND_render_frame_mesh(void)
+{
+    struct OBJ_Object sphere;
+    struct OBJ_Mesh sphere_mesh;
+    create_sphere_mesh(&sphere_mesh);
+    create_sphere(&sphere);
+
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 2.0}, .rotation = {.pitch = 0.3}},
+    };
+    const struct REND_ObjectWithPosition mesh_objects[] = {
+        {.mesh = &sphere_mesh, .position = {.x = 0.0, .y = 0.0, .z = 2.0}, .rotation = {.pitch = 0.3}},
+    };
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+    const struct REND_Objects mesh_model = {.objects = mesh_objects, .length = LENGTH(mesh_objects)};
+    struct REND_Renderer *const renderer = create_view(0);
+    struct REND_Renderer *const mesh_renderer = create_view(0);
+
+    REND_render_frame(renderer, &light_source, &model);
+    REND_render_frame(mesh_renderer, &light_source, &mesh_model);
+
+    /* The triangles cover the same pixels as the splats except along the silhouette, where the
+     * splats may cover pixels whose centers are just outside the triangles. Inside the silhouette
+     * the depths differ by a few sample spacings since a splat is drawn with the depth of its
+     * point, along the silhouette the surface is too steep to compare the depths. */
+    const struct MAT_Matrix *const z_buffer = REND_get_z_buffer(renderer);
+    const struct MAT_Matrix *const mesh_z_buffer = REND_get_z_buffer(mesh_renderer);
+    const struct MAT_Matrix *const mesh_frame_buffer = REND_get_frame_buffer(mesh_renderer);
+    int number_of_drawn_pixels = 0;
+    int number_of_mesh_pixels = 0;
+
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            const double depth = MAT_get_element(z_buffer, y, x);
+            const double mesh_depth = MAT_get_element(mesh_z_buffer, y, x);
+
+            if (!isinf(mesh_depth))
+            {
+                const int is_inside = (x > 0) && (x < WIDTH - 1) && (y > 0) && (y < HEIGHT - 1) &&
+                    !isinf(MAT_get_element(mesh_z_buffer, y, x - 1)) &&
+                    !isinf(MAT_get_element(mesh_z_buffer, y, x + 1)) &&
+                    !isinf(MAT_get_element(mesh_z_buffer, y - 1, x)) &&
+                    !isinf(MAT_get_element(mesh_z_buffer, y + 1, x));
+
+                TF_assert(!isinf(depth));
+                TF_assert_double_eq(mesh_depth, depth, is_inside ? 3.0 * sphere.sample_spacing : RADIUS);
+                TF_assert(REND_get_illumination((char)MAT_get_element(mesh_frame_buffer, y, x)) >= 0.0);
+                ++number_of_mesh_pixels;
+            }
+
+            number_of_drawn_pixels += !isinf(depth);
+        }
+    }
+
+    TF_assert(number_of_mesh_pixels > 100);
+    TF_assert(10 * number_of_mesh_pixels > 9 * number_of_drawn_pixels);
+
+    REND_destroy(mesh_renderer);
+    REND_destroy(renderer);
+}
+
+static void test_REND_render_frame_static(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = -0.3, .y = 0.0, .z = 3.0}, .is_static = 1},
+        {.object = &sphere, .position = {.x = 0.3, .y = 0.1, .z = 4.0}, .is_static = 1},
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 3.5}},
+    };
+    struct REND_ObjectWithPosition reference_objects[LENGTH(objects)];
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+    const struct REND_Objects reference_model = {.objects = reference_objects, .length = LENGTH(reference_objects)};
+    struct COORD_Coordinate3D translation = {.x = 0.0, .y = 0.0, .z = 0.0};
+    struct CAM_CameraParameters calibration;
+    get_calibration(&translation, &calibration);
+    struct REND_Renderer *const renderer = REND_create(&calibration, WIDTH, HEIGHT, 100.0);
+
+    /* The camera is still for the first frames and moves in the following frames, the dynamic
+     * sphere moves through the static spheres. Every frame is compared to a frame rendered from
+     * scratch without static objects. */
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        if (frame >= 4)
+        {
+            translation.x += 0.05;
+            translation.z -= 0.1;
+            get_calibration(&translation, &calibration);
+            REND_set_camera(renderer, &calibration);
+        }
+
+        objects[2].position.x = -0.4 + (0.1 * frame);
+        objects[2].rotation.yaw = 0.2 * frame;
+
+        for (size_t i = 0; i < LENGTH(objects); ++i)
+        {
+            reference_objects[i] = objects[i];
+            reference_objects[i].is_static = 0;
+        }
+
+        struct REND_Renderer *const reference_renderer = REND_create(&calibration, WIDTH, HEIGHT, 100.0);
+
+        REND_render_frame(renderer, &light_source, &model);
+        REND_render_frame(reference_renderer, &light_source, &reference_model);
+
+        TF_assert(is_equal(REND_get_frame_buffer(renderer), REND_get_frame_buffer(reference_renderer)));
+        TF_assert(is_equal(REND_get_z_buffer(renderer), REND_get_z_buffer(reference_renderer)));
+
+        REND_destroy(reference_renderer);
+    }
+
+    TF_assert((char)MAT_get_element(REND_get_frame_buffer(renderer), HEIGHT / 2, WIDTH / 2) != ' ');
+
+    REND_destroy(renderer);
+}
+
+static void test_REND_render_frame_instances(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    enum { NUMBER_OF_INSTANCES = 12 };
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    struct COORD_Coordinate3D positions[NUMBER_OF_INSTANCES];
+    struct CST_Rotation3D rotations[NUMBER_OF_INSTANCES];
+    struct REND_ObjectWithPosition objects[NUMBER_OF_INSTANCES];
+
+    /* Overlapping spheres at different depths, some of them partly outside the screen */
+    for (int i = 0; i < NUMBER_OF_INSTANCES; ++i)
+    {
+        positions[i] = (struct COORD_Coordinate3D){
+            .x = -1.2 + (0.22 * i), .y = 0.1 * (i % 3), .z = 2.5 + (0.3 * (i % 4))};
+        rotations[i] = (struct CST_Rotation3D){.pitch = 0.1 * i, .yaw = 0.4 * i, .roll = 0.0};
+        objects[i] = (struct REND_ObjectWithPosition){
+            .object = &sphere, .position = positions[i], .rotation = rotations[i]};
+    }
+
+    const struct REND_Instances instances = {
+        .object = &sphere, .positions = positions, .rotations = rotations, .length = NUMBER_OF_INSTANCES};
+    const struct REND_Objects instanced_model = {.instances = &instances, .number_of_instances = 1};
+    const struct REND_Objects model = {.objects = objects, .length = NUMBER_OF_INSTANCES};
+    struct REND_Renderer *const renderer = create_view(0);
+    struct REND_Renderer *const instanced_renderer = create_view(0);
+
+    REND_render_frame(renderer, &light_source, &model);
+    REND_render_frame(instanced_renderer, &light_source, &instanced_model);
+
+    TF_assert(is_equal(REND_get_frame_buffer(instanced_renderer), REND_get_frame_buffer(renderer)));
+    TF_assert(is_equal(REND_get_z_buffer(instanced_renderer), REND_get_z_buffer(renderer)));
+    TF_assert((char)MAT_get_element(REND_get_frame_buffer(instanced_renderer), HEIGHT / 2, WIDTH / 2) != ' ');
+
+    REND_destroy(instanced_renderer);
+    REND_destroy(renderer);
+}
+
+/* Render a particle system alone and find the pixel of its only particle */
+static void find_particle(
+    const struct PART_ParticleSystem *const particle_system,
+    int *const row,
+    int *const col)
+{
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_Objects model = {.particle_systems = &particle_system, .number_of_particle_systems = 1};
+    struct REND_Renderer *const renderer = create_view(0);
+
+    REND_render_frame(renderer, &light_source, &model);
+    *row = -1;
+
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            if (!isinf(MAT_get_element(REND_get_z_buffer(renderer), y, x)))
+            {
+                *row = y;
+                *col = x;
+            }
+        }
+    }
+
+    REND_destroy(renderer);
+}
+
+static void test_REND_render_frame_particles(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    enum { NUMBER_OF_PARTICLES = 3 };
+    /* In front of the sphere, behind the sphere and behind the sphere but beside it */
+    const struct COORD_Coordinate3D positions[NUMBER_OF_PARTICLES] = {
+        {.x = 0.0, .y = 0.0, .z = 2.0},
+        {.x = 0.05, .y = 0.0, .z = 4.0},
+        {.x = 1.0, .y = 0.0, .z = 4.0},
+    };
+    const int is_visible[NUMBER_OF_PARTICLES] = {1, 0, 1};
+    struct PART_ParticleSystem *particle_systems[NUMBER_OF_PARTICLES];
+    int rows[NUMBER_OF_PARTICLES];
+    int cols[NUMBER_OF_PARTICLES];
+
+    for (int i = 0; i < NUMBER_OF_PARTICLES; ++i)
+    {
+        const struct PART_Emitter emitter = {.position = positions[i], .lifetime = 1.0, .intensity = 1.0};
+
+        particle_systems[i] = PART_create(1, 1);
+        TF_assert(PART_emit(particle_systems[i], &emitter, 1) == 1);
+        find_particle(particle_systems[i], &rows[i], &cols[i]);
+        TF_assert(rows[i] >= 0);
+    }
+
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 3.0}},
+    };
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+    const struct REND_Objects particle_model = {
+        .objects = objects,
+        .length = LENGTH(objects),
+        .particle_systems = (const struct PART_ParticleSystem *const *)particle_systems,
+        .number_of_particle_systems = NUMBER_OF_PARTICLES
+    };
+    struct REND_Renderer *const renderer = create_view(0);
+    struct REND_Renderer *const particle_renderer = create_view(0);
+
+    REND_render_frame(renderer, &light_source, &model);
+    REND_render_frame(particle_renderer, &light_source, &particle_model);
+
+    /* The visible particles are drawn to their pixels, the hidden particle leaves the sphere unchanged */
+    for (int i = 0; i < NUMBER_OF_PARTICLES; ++i)
+    {
+        const double sphere_depth = MAT_get_element(REND_get_z_buffer(renderer), rows[i], cols[i]);
+        const double depth = MAT_get_element(REND_get_z_buffer(particle_renderer), rows[i], cols[i]);
+        const char sphere_color = (char)MAT_get_element(REND_get_frame_buffer(renderer), rows[i], cols[i]);
+        const char color = (char)MAT_get_element(REND_get_frame_buffer(particle_renderer), rows[i], cols[i]);
+
+        if (is_visible[i])
+        {
+            TF_assert_double_eq(depth, positions[i].z, 1e-9);
+            TF_assert(color == '@');
+        }
+        else
+        {
+            TF_assert(sphere_depth < positions[i].z);
+            TF_assert_double_eq(depth, sphere_depth, 1e-9);
+            TF_assert(color == sphere_color);
+        }
+    }
+
+    /* The particle in front of the sphere is drawn over it */
+    TF_assert(MAT_get_element(REND_get_z_buffer(renderer), rows[0], cols[0]) > positions[0].z);
+
+    REND_destroy(particle_renderer);
+    REND_destroy(renderer);
+
+    for (int i = 0; i < NUMBER_OF_PARTICLES; ++i)
+    {
+        PART_destroy(particle_systems[i]);
+    }
+}
+
+static void test_REND_render_frame_point_source(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    const struct OBJ_PointSource point_source = {
+        .read = read_sphere, .context = NULL, .sample_spacing = sphere.sample_spacing};
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = 0.1, .y = 0.0, .z = 2.0}, .rotation = {.pitch = 0.3}},
+    };
+    const struct REND_ObjectWithPosition point_source_objects[] = {
+        {.point_source = &point_source, .position = {.x = 0.1, .y = 0.0, .z = 2.0}, .rotation = {.pitch = 0.3}},
+    };
+    const struct REND_Objects model = {.objects = objects, .length = LENGTH(objects)};
+    const struct REND_Objects point_source_model = {
+        .objects = point_source_objects, .length = LENGTH(point_source_objects)};
+    struct REND_Renderer *const renderer = create_view(0);
+    struct REND_Renderer *const point_source_renderer = create_view(0);
+
+    /* The streamed points are drawn with the splats of the object, i.e. without gaps */
+    REND_render_frame(renderer, &light_source, &model);
+    REND_render_frame(point_source_renderer, &light_source, &point_source_model);
+
+    TF_assert(is_equal(REND_get_frame_buffer(point_source_renderer), REND_get_frame_buffer(renderer)));
+    TF_assert(is_equal(REND_get_z_buffer(point_source_renderer), REND_get_z_buffer(renderer)));
+    TF_assert((char)MAT_get_element(REND_get_frame_buffer(point_source_renderer), HEIGHT / 2, WIDTH / 2) != ' ');
+
+    REND_destroy(point_source_renderer);
+    REND_destroy(renderer);
+}
+
+static void test_REND_set_camera_forward(void)
+{
+    struct OBJ_Object sphere;
+    create_sphere(&sphere);
+
+    const struct PART_Emitter emitter = {.position = {.x = 0.0, .y = 0.0, .z = 4.0}, .lifetime = 1.0, .intensity = 1.0};
+    struct PART_ParticleSystem *const particle_system = PART_create(1, 1);
+    const struct PART_ParticleSystem *const particle_systems[] = {particle_system};
+    TF_assert(PART_emit(particle_system, &emitter, 1) == 1);
+
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 3.0}, .rotation = {.pitch = 0.3}},
+    };
+    const struct REND_Objects model = {
+        .objects = objects,
+        .length = LENGTH(objects),
+        .particle_systems = particle_systems,
+        .number_of_particle_systems = LENGTH(particle_systems)
+    };
+    struct COORD_Coordinate3D translation = {.x = 0.0, .y = 0.0, .z = 0.0};
+    struct CAM_CameraParameters calibration;
+    get_calibration(&translation, &calibration);
+    struct REND_Renderer *const renderer = REND_create(&calibration, WIDTH, HEIGHT, 100.0);
+
+    /* The camera moves forward into the sphere (the camera is inside it at 2.75), past it and past
+     * the particle. Each frame is compared to a camera at the origin with the world moved
+     * backward instead. */
+    const double camera_positions[] = {0.0, 1.0, 2.0, 2.75, 3.5, 5.0};
+
+    for (size_t i = 0; i < LENGTH(camera_positions); ++i)
+    {
+        translation.z = camera_positions[i];
+        get_calibration(&translation, &calibration);
+        REND_set_camera(renderer, &calibration);
+        REND_render_frame(renderer, &light_source, &model);
+
+        const struct PART_Emitter moved_emitter = {
+            .position = {.x = 0.0, .y = 0.0, .z = emitter.position.z - translation.z},
+            .lifetime = 1.0,
+            .intensity = 1.0
+        };
+        struct PART_ParticleSystem *const moved_particle_system = PART_create(1, 1);
+        const struct PART_ParticleSystem *const moved_particle_systems[] = {moved_particle_system};
+        TF_assert(PART_emit(moved_particle_system, &moved_emitter, 1) == 1);
+
+        const struct COORD_Coordinate3D moved_light_source = {
+            .x = light_source.x, .y = light_source.y, .z = light_source.z - translation.z};
+        const struct REND_ObjectWithPosition moved_objects[] = {
+            {.object = &sphere, .position = {.x = 0.0, .y = 0.0, .z = 3.0 - translation.z}, .rotation = {.pitch = 0.3}},
+        };
+        const struct REND_Objects moved_model = {
+            .objects = moved_objects,
+            .length = LENGTH(moved_objects),
+            .particle_systems = moved_particle_systems,
+            .number_of_particle_systems = LENGTH(moved_particle_systems)
+        };
+        struct REND_Renderer *const moved_renderer = create_view(0);
+        REND_render_frame(moved_renderer, &moved_light_source, &moved_model);
+
+        const struct MAT_Matrix *const z_buffer = REND_get_z_buffer(renderer);
+        const struct MAT_Matrix *const moved_z_buffer = REND_get_z_buffer(moved_renderer);
+        int number_of_drawn_pixels = 0;
+
+        for (int y = 0; y < HEIGHT; ++y)
+        {
+            for (int x = 0; x < WIDTH; ++x)
+            {
+                const double depth = MAT_get_element(z_buffer, y, x);
+                const double moved_depth = MAT_get_element(moved_z_buffer, y, x);
+
+                TF_assert(isinf(depth) == isinf(moved_depth));
+                TF_assert(isinf(depth) || (fabs(depth - moved_depth) < 1e-9));
+                TF_assert(isinf(depth) || (depth > 0.0));
+                number_of_drawn_pixels += !isinf(depth);
+            }
+        }
+
+        TF_assert(is_equal(REND_get_frame_buffer(renderer), REND_get_frame_buffer(moved_renderer)));
+        /* Nothing is in front of the camera after it has passed the particle */
+        TF_assert((translation.z > emitter.position.z) == (number_of_drawn_pixels == 0));
+
+        REND_destroy(moved_renderer);
+        PART_destroy(moved_particle_system);
+    }
+
+    REND_destroy(renderer);
+    PART_destroy(particle_system);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_REND_render_views,
+        test_REND_render_frame_compressed,
+        test_REND_render_frame_mesh,
+        test_REND_render_frame_static,
+        test_REND_render_frame_instances,
+        test_REND_render_frame_particles,
+        test_REND_render_frame_point_source,
+        test_REND_set_camera_forward,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,156 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <Engine/renderer.h>
+#include <Engine/scene_graph.h>
+#include <LinearAlgebra/matrix.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void test_SG_update(void)
+{
+    const struct OBJ_Object object = {.length = 0};
+    /* The arm is rotated a quarter turn around the y-axis, which maps x to -z. */
+    const struct REND_ObjectWithPosition arm = {
+        .object = &object,
+        .position = {.x = 1.0, .y = 0.0, .z = 5.0},
+        .rotation = {.pitch = 0.0, .yaw = M_PI / 2.0, .roll = 0.0}
+    };
+    const struct REND_ObjectWithPosition joint = {
+        .position = {.x = 2.0, .y = 0.0, .z = 0.0}
+    };
+    const struct REND_ObjectWithPosition hand = {
+        .object = &object,
+        .position = {.x = 0.0, .y = 1.0, .z = 0.0}
+    };
+
+    struct SG_SceneGraph *const graph = SG_create();
+    const int arm_node = SG_add_node(graph, SG_ROOT, &arm);
+    const int joint_node = SG_add_node(graph, arm_node, &joint);
+    const int hand_node = SG_add_node(graph, joint_node, &hand);
+
+    TF_assert(SG_update(graph) == 3);
+
+    struct COORD_Coordinate3D position;
+    SG_get_world_position(graph, joint_node, &position);
+    TF_assert_double_eq(position.x, 1.0, granularity);
+    TF_assert_double_eq(position.y, 0.0, granularity);
+    TF_assert_double_eq(position.z, 3.0, granularity);
+
+    SG_get_world_position(graph, hand_node, &position);
+    TF_assert_double_eq(position.x, 1.0, granularity);
+    TF_assert_double_eq(position.y, 1.0, granularity);
+    TF_assert_double_eq(position.z, 3.0, granularity);
+
+    /* Nothing changed */
+    TF_assert(SG_update(graph) == 0);
+
+    /* Only the changed node and its descendants are recomputed */
+    const struct COORD_Coordinate3D moved_joint_position = {.x = 3.0, .y = 0.0, .z = 0.0};
+    SG_set_local_transform(graph, joint_node, &moved_joint_position, &joint.rotation);
+    TF_assert(SG_update(graph) == 2);
+
+    SG_get_world_position(graph, hand_node, &position);
+    TF_assert_double_eq(position.x, 1.0, granularity);
+    TF_assert_double_eq(position.y, 1.0, granularity);
+    TF_assert_double_eq(position.z, 2.0, granularity);
+
+    SG_destroy(graph);
+}
+
+static void test_SG_get_objects(void)
+{
+    const struct OBJ_Object object = {.length = 0};
+    const struct REND_ObjectWithPosition body = {
+        .object = &object,
+        .position = {.x = 0.0, .y = 0.0, .z = 5.0},
+        .rotation = {.pitch = 0.0, .yaw = 0.0, .roll = M_PI / 2.0},
+        .is_static = 1
+    };
+    const struct REND_ObjectWithPosition pivot = {
+        .position = {.x = 1.0, .y = 0.0, .z = 0.0}
+    };
+    const struct REND_ObjectWithPosition wheel = {
+        .object = &object,
+        .position = {.x = 0.0, .y = 0.0, .z = 0.0}
+    };
+
+    struct SG_SceneGraph *const graph = SG_create();
+    const int body_node = SG_add_node(graph, SG_ROOT, &body);
+    const int pivot_node = SG_add_node(graph, body_node, &pivot);
+    SG_add_node(graph, pivot_node, &wheel);
+    SG_update(graph);
+
+    struct REND_Objects objects;
+    SG_get_objects(graph, &objects);
+
+    /* The pivot has nothing to draw */
+    TF_assert(objects.length == 2);
+    TF_assert(objects.objects[0].object == &object);
+    TF_assert(objects.objects[0].is_static);
+    TF_assert(!objects.objects[1].is_static);
+
+    /* The wheel is at the pivot, rotated with the body. A quarter turn around the z-axis maps x to y. */
+    TF_assert_double_eq(objects.objects[1].position.x, 0.0, granularity);
+    TF_assert_double_eq(objects.objects[1].position.y, 1.0, granularity);
+    TF_assert_double_eq(objects.objects[1].position.z, 5.0, granularity);
+
+    const struct MAT_Matrix *const rotation_matrix = objects.objects[1].rotation_matrix;
+    TF_assert(rotation_matrix != NULL);
+    TF_assert_double_eq(MAT_get_element(rotation_matrix, 1, 0), 1.0, granularity);
+    TF_assert_double_eq(MAT_get_element(rotation_matrix, 0, 1), -1.0, granularity);
+    TF_assert_double_eq(MAT_get_element(rotation_matrix, 2, 2), 1.0, granularity);
+
+    SG_destroy(graph);
+}
+
+static void test_SG_add_many_nodes(void)
+{
+    const struct OBJ_Object object = {.length = 0};
+    const struct REND_ObjectWithPosition link = {
+        .object = &object,
+        .position = {.x = 1.0, .y = 0.0, .z = 0.0}
+    };
+
+    struct SG_SceneGraph *const graph = SG_create();
+    int parent = SG_ROOT;
+
+    /* A chain of nodes, more than fit in the initial storage */
+    for (int i = 0; i < 100; ++i)
+    {
+        parent = SG_add_node(graph, parent, &link);
+    }
+
+    TF_assert(SG_update(graph) == 100);
+
+    struct COORD_Coordinate3D position;
+    SG_get_world_position(graph, parent, &position);
+    TF_assert_double_eq(position.x, 100.0, granularity);
+
+    struct REND_Objects objects;
+    SG_get_objects(graph, &objects);
+    TF_assert(objects.length == 100);
+    TF_assert_double_eq(objects.objects[99].position.x, 100.0, granularity);
+
+    SG_destroy(graph);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_SG_update,
+        test_SG_get_objects,
+        test_SG_add_many_nodes,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,189 @@
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/camera.h>
+#include <Engine/object.h>
+#include <Engine/renderer.h>
+#include <Engine/world_streaming.h>
+#include <TestFramework/test_framework.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+#define NUMBER_OF_CHUNKS (4)
+
+/* A world with one point in each of the chunks (0, 0, 0), (2, 0, 0), (4, 0, 0) and (6, 0, 0), i.e. at
+ * x = 5, 25, 45 and 65 */
+static void write_world(
+    const char *const directory)
+{
+    struct COORD_Coordinate3D coordinates[NUMBER_OF_CHUNKS];
+    struct COORD_Coordinate3D surface_normals[NUMBER_OF_CHUNKS];
+
+    for (int i = 0; i < NUMBER_OF_CHUNKS; ++i)
+    {
+        coordinates[i] = (struct COORD_Coordinate3D){.x = 20.0 * i, .y = 0.0, .z = 0.0};
+        surface_normals[i] = (struct COORD_Coordinate3D){.x = 0.0, .y = 0.0, .z = 1.0};
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = coordinates,
+        .surface_normals = surface_normals,
+        .length = NUMBER_OF_CHUNKS,
+        .sample_spacing = 0.5
+    };
+    OBJ_update_bounds(&object);
+
+    /* Objects without an OBJ_Object are ignored */
+    const struct REND_ObjectWithPosition objects[] = {
+        {.object = &object, .position = {.x = 5.0, .y = 5.0, .z = 5.0}},
+        {.object = NULL}
+    };
+
+    TF_assert(WS_write_world(directory, 10.0, objects, LENGTH(objects)) == 0);
+}
+
+static void remove_world(
+    const char *const directory)
+{
+    char path[4096];
+
+    for (int i = 0; i < NUMBER_OF_CHUNKS; ++i)
+    {
+        snprintf(path, sizeof(path), "%s/chunk_%d_0_0.obj", directory, 2 * i);
+        TF_assert(remove(path) == 0);
+    }
+
+    snprintf(path, sizeof(path), "%s/world.index", directory);
+    TF_assert(remove(path) == 0);
+    TF_assert(rmdir(directory) == 0);
+}
+
+static void move_camera(
+    struct WS_World *const world,
+    const double x)
+{
+    const struct CAM_ExtrinsicParameters extrinsic = {.translation = {.x = x, .y = 5.0, .z = 5.0}};
+
+    WS_set_camera(world, &extrinsic);
+    WS_wait(world);
+}
+
+static void test_WS_stream(void)
+{
+    char directory[] = "/tmp/world_streaming_tests_XXXXXX";
+    TF_assert(mkdtemp(directory) != NULL);
+    write_world(directory);
+
+    struct WS_World *const world = WS_open(directory, 8.0, 1LL << 30);
+    TF_assert(world != NULL);
+
+    /* Nothing is loaded until the camera is set */
+    struct REND_Objects objects;
+    WS_get_objects(world, &objects);
+    TF_assert(objects.length == 0);
+
+    move_camera(world, 5.0);
+    WS_get_objects(world, &objects);
+    TF_assert(objects.length == 1);
+    TF_assert(objects.objects[0].is_static);
+    TF_assert(objects.objects[0].object->length == 1);
+    TF_assert_double_eq(objects.objects[0].object->coordinates[0].x, 5.0, granularity);
+    TF_assert_double_eq(objects.objects[0].object->coordinates[0].y, 5.0, granularity);
+    TF_assert_double_eq(objects.objects[0].object->surface_normals[0].z, 1.0, granularity);
+    TF_assert_double_eq(objects.objects[0].object->sample_spacing, 0.5, granularity);
+
+    struct WS_Statistics statistics;
+    WS_get_statistics(world, &statistics);
+    TF_assert(statistics.number_of_resident_chunks == 1);
+    TF_assert(statistics.number_of_loads == 1);
+    TF_assert(statistics.number_of_evictions == 0);
+    TF_assert(statistics.memory_in_use > 0);
+    TF_assert(statistics.last_load_latency >= 0.0);
+    TF_assert_double_eq(statistics.average_load_latency, statistics.last_load_latency, granularity);
+    TF_assert_double_eq(statistics.max_load_latency, statistics.last_load_latency, granularity);
+
+    /* The first chunk is outside the eviction radius when the camera is in the second chunk */
+    const long long chunk_size = statistics.memory_in_use;
+    move_camera(world, 25.0);
+    WS_get_objects(world, &objects);
+    TF_assert(objects.length == 1);
+    TF_assert_double_eq(objects.objects[0].object->coordinates[0].x, 25.0, granularity);
+
+    WS_get_statistics(world, &statistics);
+    TF_assert(statistics.number_of_loads == 2);
+    TF_assert(statistics.number_of_evictions == 1);
+    TF_assert(statistics.memory_in_use == chunk_size);
+
+    WS_close(world);
+    remove_world(directory);
+}
+
+static void test_WS_memory_budget(void)
+{
+    char directory[] = "/tmp/world_streaming_tests_XXXXXX";
+    TF_assert(mkdtemp(directory) != NULL);
+    write_world(directory);
+
+    char path[4096];
+    struct stat file_status;
+    snprintf(path, sizeof(path), "%s/chunk_0_0_0.obj", directory);
+    TF_assert(stat(path, &file_status) == 0);
+
+    /* All chunks are inside the load radius but only two fit in the memory budget */
+    const long long memory_budget = 2 * (long long)file_status.st_size;
+    struct WS_World *const world = WS_open(directory, 100.0, memory_budget);
+    TF_assert(world != NULL);
+
+    struct REND_Objects objects;
+    move_camera(world, 5.0);
+    WS_get_objects(world, &objects);
+    TF_assert(objects.length == 2);
+    TF_assert_double_eq(objects.objects[0].object->coordinates[0].x, 5.0, granularity);
+    TF_assert_double_eq(objects.objects[1].object->coordinates[0].x, 25.0, granularity);
+
+    /* The farthest chunks are evicted to give room for the closest, one frame at a time */
+    struct WS_Statistics statistics;
+    move_camera(world, 65.0);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        WS_get_objects(world, &objects);
+        WS_wait(world);
+        WS_get_statistics(world, &statistics);
+        TF_assert(statistics.memory_in_use <= memory_budget);
+    }
+
+    TF_assert(objects.length == 2);
+    TF_assert_double_eq(objects.objects[0].object->coordinates[0].x, 45.0, granularity);
+    TF_assert_double_eq(objects.objects[1].object->coordinates[0].x, 65.0, granularity);
+    TF_assert(statistics.number_of_loads == 4);
+    TF_assert(statistics.number_of_evictions == 2);
+
+    WS_close(world);
+    remove_world(directory);
+}
+
+static void test_WS_open_missing_world(void)
+{
+    TF_assert(WS_open("/tmp/world_streaming_tests_missing_directory", 1.0, 1LL << 30) == NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_WS_stream,
+        test_WS_memory_budget,
+        test_WS_open_missing_world,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -0,0 +1,149 @@
+/**
+ * \file
+ * \brief Frame monitor, reference consumer of a frame sink
+ *
+ * Reads all frames written to a frame sink (see frame_sink.h) and reports the number of received
+ * and dropped frames once per second until the writer destroys the frame sink. Usage:
+ *
+ *     FrameMonitor <name of the frame sink>
+ */
+#include <Engine/frame_sink.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define POLL_INTERVAL_NS (1000000L) /* The time to sleep when there is no new frame [ns] */
+#define REPORT_INTERVAL (1.0) /* [s] */
+
+/**
+ * \brief Get the time between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The elapsed time [s]
+ */
+static double get_elapsed_time(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-9);
+}
+
+/**
+ * \brief Sleep for the poll interval
+ */
+static void sleep_poll_interval(void)
+{
+    const struct timespec interval = {.tv_sec = 0, .tv_nsec = POLL_INTERVAL_NS};
+
+    nanosleep(&interval, NULL);
+}
+
+/**
+ * \brief Consume a frame, counts the drawn pixels like a simple monitor would
+ *
+ * \param[in] frame The frame
+ *
+ * \return Number of drawn pixels
+ */
+static long long consume_frame(
+    const struct FSINK_Frame *const frame)
+{
+    long long number_of_drawn_pixels = 0;
+
+    for (int i = 0; i < frame->width * frame->height; ++i)
+    {
+        number_of_drawn_pixels += frame->characters[i] != ' ';
+    }
+
+    return number_of_drawn_pixels;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <name of the frame sink, e.g. /game_frames>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct FSINK_Reader *reader = NULL;
+
+    /* The writer may not have created the frame sink yet */
+    while ((reader = FSINK_open(argv[1])) == NULL)
+    {
+        sleep_poll_interval();
+    }
+
+    unsigned long long next_sequence = 1;
+    long long number_of_received_frames = 0;
+    long long number_of_dropped_frames = 0;
+    long long number_of_drawn_pixels = 0;
+    struct timespec report_time;
+    clock_gettime(CLOCK_MONOTONIC, &report_time);
+
+    printf("%10s %10s %10s %15s\n", "sequence", "received", "dropped", "drawn pixels");
+
+    for (;;)
+    {
+        /* Read the closed state before the latest sequence, no frames are written after it is set */
+        const int is_closed = FSINK_is_closed(reader);
+        const unsigned long long latest_sequence = FSINK_get_latest_sequence(reader);
+
+        if (next_sequence > latest_sequence)
+        {
+            if (is_closed)
+            {
+                break;
+            }
+
+            sleep_poll_interval();
+        }
+
+        for (; next_sequence <= latest_sequence; ++next_sequence)
+        {
+            struct FSINK_Frame frame;
+
+            if (FSINK_get_frame(reader, next_sequence, &frame))
+            {
+                const long long drawn_pixels = consume_frame(&frame);
+
+                /* What was read must be discarded if the frame was overwritten while it was read */
+                if (FSINK_is_valid(reader, &frame))
+                {
+                    number_of_drawn_pixels += drawn_pixels;
+                    ++number_of_received_frames;
+                    continue;
+                }
+            }
+
+            ++number_of_dropped_frames;
+        }
+
+        struct timespec current_time;
+        clock_gettime(CLOCK_MONOTONIC, &current_time);
+
+        if (get_elapsed_time(&report_time, &current_time) >= REPORT_INTERVAL)
+        {
+            printf("%10llu %10lld %10lld %15lld\n",
+                   latest_sequence,
+                   number_of_received_frames,
+                   number_of_dropped_frames,
+                   number_of_drawn_pixels);
+            fflush(stdout);
+            report_time = current_time;
+        }
+    }
+
+    printf("%10llu %10lld %10lld %15lld\n",
+           next_sequence - 1,
+           number_of_received_frames,
+           number_of_dropped_frames,
+           number_of_drawn_pixels);
+
+    FSINK_close(reader);
+
+    return EXIT_SUCCESS;
+}
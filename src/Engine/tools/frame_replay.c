@@ -0,0 +1,102 @@
+/**
+ * \file
+ * \brief Frame replay, plays back a frame recording (see frame_recording.h)
+ *
+ * Shows the frames of a recording at the speed they were recorded, or as fast as possible with
+ * --unlimited, and reports the number of frames and the replay rate when done. Usage:
+ *
+ *     FrameReplay <path of the recording> [--unlimited]
+ */
+#include <Engine/frame_recording.h>
+#include <Engine/renderer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * \brief Get the time between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The elapsed time [s]
+ */
+static double get_elapsed_time(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-9);
+}
+
+/**
+ * \brief Sleep until a point in time relative to a start time
+ *
+ * \param[in] start The start time
+ * \param[in] time The time to sleep until relative to the start time [s]
+ */
+static void sleep_until(
+    const struct timespec *const start,
+    const double time)
+{
+    const long long nanoseconds = start->tv_nsec + (long long)(time * 1e9);
+    const struct timespec deadline = {
+        .tv_sec = start->tv_sec + (time_t)(nanoseconds / 1000000000LL),
+        .tv_nsec = (long)(nanoseconds % 1000000000LL)
+    };
+
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    const int is_unlimited = (argc == 3) && (strcmp(argv[2], "--unlimited") == 0);
+
+    if ((argc != 2) && !is_unlimited)
+    {
+        fprintf(stderr, "Usage: %s <path of the recording> [--unlimited]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct FREC_Player *const player = FREC_open(argv[1]);
+
+    if (player == NULL)
+    {
+        fprintf(stderr, "%s is not a frame recording\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const struct MAT_Matrix *frame_buffer;
+    double time;
+    long long number_of_frames = 0;
+    int status;
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    while ((status = FREC_read_frame(player, &frame_buffer, &time)) > 0)
+    {
+        if (!is_unlimited)
+        {
+            sleep_until(&start_time, time);
+        }
+
+        REND_show_frame(frame_buffer);
+        ++number_of_frames;
+    }
+
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    const double elapsed_time = get_elapsed_time(&start_time, &end_time);
+
+    FREC_close(player);
+
+    fprintf(stderr,
+            "%lld frames in %.3f s (%.1f frames/s)%s\n",
+            number_of_frames,
+            elapsed_time,
+            (elapsed_time > 0.0) ? (double)number_of_frames / elapsed_time : 0.0,
+            (status < 0) ? ", the recording is corrupt" : "");
+
+    return (status < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
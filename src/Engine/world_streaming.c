@@ -0,0 +1,844 @@
+/**
+ * \file
+ * \brief World streaming implementation
+ */
+#include <Base/coordinates.h>
+#include <Engine/camera.h>
+#include <Engine/coordinate_system_transformations.h>
+#include <Engine/object.h>
+#include <Engine/object_file.h>
+#include <Engine/renderer.h>
+#include <Engine/world_streaming.h>
+#include <LinearAlgebra/matrix.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_PATH_LENGTH (4096)
+#define INDEX_FILE_NAME ("world.index")
+#define MAGIC ("GEWORLD")
+#define VERSION (1U)
+#define BYTE_ORDER_MARK (0x01020304U) /* Files are stored in native byte order */
+/* Chunks are evicted when they are this much farther away than the load radius, which keeps chunks
+ * at the border of the load radius from being loaded and evicted over and over. */
+#define EVICTION_RADIUS_FACTOR (1.25)
+
+/**
+ * \brief Index file header, located at the beginning of the index file
+ */
+struct IndexHeader
+{
+    char magic[8]; /**< Identifies the file as a world index file */
+    uint32_t version; /**< The version of the file format */
+    uint32_t byte_order_mark; /**< Used to detect files written on a machine with different byte order */
+    double chunk_size; /**< The length of the sides of the chunks [m] */
+    uint64_t number_of_chunks; /**< Number of index entries following the header */
+};
+
+/**
+ * \brief Index file entry, one for each chunk
+ */
+struct IndexEntry
+{
+    int32_t cell[3]; /**< The position of the chunk in the grid of chunks */
+    uint32_t padding; /**< Always 0 */
+    uint64_t size; /**< The size of the object file of the chunk [bytes] */
+};
+
+/**
+ * \brief A point of the world, used when partitioning the world into chunks
+ */
+struct WorldPoint
+{
+    int cell[3]; /**< The position of the chunk the point belongs to in the grid of chunks */
+    struct COORD_Coordinate3D coordinate; /**< The world coordinate */
+    struct COORD_Coordinate3D surface_normal; /**< The surface normal in the world coordinate system */
+    double sample_spacing; /**< The sample spacing of the object the point belongs to [m] */
+};
+
+/**
+ * \brief The state of a chunk
+ */
+enum ChunkState
+{
+    UNLOADED, /**< Not loaded */
+    LOADING, /**< Being loaded by the loader thread */
+    RESIDENT, /**< Loaded and seen by the renderer */
+    EVICTED, /**< Still loaded but no longer seen by the renderer, unloaded by WS_get_objects() */
+    FAILED /**< Could not be loaded, never loaded again */
+};
+
+/**
+ * \brief A chunk of the world
+ */
+struct Chunk
+{
+    int cell[3]; /**< The position of the chunk in the grid of chunks */
+    struct OBJ_BoundingBox bounds; /**< The part of the world covered by the chunk */
+    long long size; /**< The size of the chunk when loaded [bytes] */
+    enum ChunkState state; /**< The state of the chunk */
+    struct OBJF_MappedObject *mapped_object; /**< The mapped object file, NULL if not loaded */
+    /**
+     * Copy of the mapped object. The copy has the same address as long as the world is open, which
+     * lets the renderer tell the chunks apart even if a mapped object is allocated at the address
+     * of an unloaded one.
+     */
+    struct OBJ_Object object;
+};
+
+/**
+ * \brief What the loader thread should do next
+ */
+enum Action
+{
+    LOAD, /**< Load a chunk */
+    EVICT, /**< Evict a chunk */
+    WAIT /**< Wait for the camera to move or for evicted chunks to be unloaded */
+};
+
+/**
+ * \brief Streamed world
+ *
+ * All members below the mutex are protected by the mutex.
+ */
+struct WS_World
+{
+    char directory[MAX_PATH_LENGTH]; /**< The directory of the world */
+    struct Chunk *chunks; /**< The chunks of the world */
+    int number_of_chunks; /**< Number of chunks */
+    double load_radius; /**< The chunks closer to the camera than this are loaded [m] */
+    long long memory_budget; /**< The maximum size of the loaded chunks [bytes] */
+    struct REND_ObjectWithPosition *draw_list; /**< The resident chunks, fits all chunks */
+    pthread_t loader; /**< The loader thread */
+    pthread_mutex_t mutex; /**< Protects the state shared with the loader thread */
+    pthread_cond_t wake; /**< Signaled when the loader thread may have something to do */
+    pthread_cond_t idle; /**< Signaled when the loader thread has nothing to do */
+    int is_closing; /**< Non-zero when the loader thread shall stop */
+    int is_idle; /**< Non-zero when the loader thread has nothing to do */
+    int has_camera; /**< Non-zero when the camera has been set */
+    struct COORD_Coordinate3D camera_position; /**< The position of the camera */
+    long long memory_in_use; /**< The size of the loaded chunks, including evicted chunks [bytes] */
+    long long evicted_memory; /**< The size of the evicted chunks not yet unloaded [bytes] */
+    int number_of_loads; /**< Number of chunks loaded */
+    int number_of_evictions; /**< Number of chunks evicted */
+    double last_load_latency; /**< The time it took to load the last chunk [s] */
+    double total_load_latency; /**< The total time spent loading chunks [s] */
+    double max_load_latency; /**< The longest time it took to load a chunk [s] */
+};
+
+/**
+ * \brief Get the path of the object file of a chunk
+ *
+ * \param[in] directory The directory of the world
+ * \param[in] cell The position of the chunk in the grid of chunks
+ * \param[out] path The path
+ * \param[in] path_size The size of the path buffer
+ *
+ * \return 0 on success a non-zero value if the path does not fit in the buffer
+ */
+static int get_chunk_path(
+    const char *const directory,
+    const int cell[3],
+    char *const path,
+    const size_t path_size)
+{
+    const int length = snprintf(path, path_size, "%s/chunk_%d_%d_%d.obj", directory, cell[0], cell[1], cell[2]);
+
+    return (length < 0) || ((size_t)length >= path_size);
+}
+
+/**
+ * \brief Get the path of the index file of a world
+ *
+ * \param[in] directory The directory of the world
+ * \param[out] path The path
+ * \param[in] path_size The size of the path buffer
+ *
+ * \return 0 on success a non-zero value if the path does not fit in the buffer
+ */
+static int get_index_path(
+    const char *const directory,
+    char *const path,
+    const size_t path_size)
+{
+    const int length = snprintf(path, path_size, "%s/%s", directory, INDEX_FILE_NAME);
+
+    return (length < 0) || ((size_t)length >= path_size);
+}
+
+/**
+ * \brief Compare the chunks of two points, orders the points by chunk
+ *
+ * \param[in] a The first point
+ * \param[in] b The second point
+ *
+ * \return Negative if a is before b, positive if a is after b and 0 if they are in the same chunk
+ */
+static int compare_cells(
+    const void *const a,
+    const void *const b)
+{
+    const struct WorldPoint *const point_a = a;
+    const struct WorldPoint *const point_b = b;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (point_a->cell[i] != point_b->cell[i])
+        {
+            return (point_a->cell[i] > point_b->cell[i]) - (point_a->cell[i] < point_b->cell[i]);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Transform the points of an object to world coordinates and assign them to chunks
+ *
+ * \param[in] object The object
+ * \param[in] chunk_size The length of the sides of the chunks [m]
+ * \param[out] points The points of the object, must fit all points of the object
+ */
+static void get_world_points(
+    const struct REND_ObjectWithPosition *const object,
+    const double chunk_size,
+    struct WorldPoint *const points)
+{
+    struct MAT_Matrix *const rotation_matrix = (object->rotation_matrix == NULL) ?
+        CST_get_extrinsic_rotation_matrix(&object->rotation) : NULL;
+    const struct MAT_Matrix *const rotation = (rotation_matrix == NULL) ? object->rotation_matrix : rotation_matrix;
+
+    for (long long i = 0; i < object->object->length; ++i)
+    {
+        struct WorldPoint *const point = &points[i];
+
+        CST_affine_transformation(
+            &object->object->coordinates[i], rotation, &object->position, &point->coordinate);
+        CST_linear_transformation(&object->object->surface_normals[i], rotation, &point->surface_normal);
+        point->cell[0] = (int)floor(point->coordinate.x / chunk_size);
+        point->cell[1] = (int)floor(point->coordinate.y / chunk_size);
+        point->cell[2] = (int)floor(point->coordinate.z / chunk_size);
+        point->sample_spacing = object->object->sample_spacing;
+    }
+
+    MAT_free(rotation_matrix);
+}
+
+/**
+ * \brief Write the object file of a chunk
+ *
+ * \param[in] directory The directory of the world
+ * \param[in] points The points of the chunk
+ * \param[in] length The number of points
+ * \param[out] entry The index entry of the chunk
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int write_chunk(
+    const char *const directory,
+    const struct WorldPoint *const points,
+    const long long length,
+    struct IndexEntry *const entry)
+{
+    char path[MAX_PATH_LENGTH];
+
+    if (get_chunk_path(directory, points[0].cell, path, sizeof(path)) != 0)
+    {
+        return -1;
+    }
+
+    struct OBJ_Object object = {
+        .coordinates = calloc((size_t)length, sizeof(*object.coordinates)),
+        .surface_normals = calloc((size_t)length, sizeof(*object.surface_normals)),
+        .length = length
+    };
+
+    for (long long i = 0; i < length; ++i)
+    {
+        object.coordinates[i] = points[i].coordinate;
+        object.surface_normals[i] = points[i].surface_normal;
+        object.sample_spacing = fmax(object.sample_spacing, points[i].sample_spacing);
+    }
+
+    OBJ_update_bounds(&object);
+
+    struct stat file_status;
+    const int error = (OBJF_write(path, &object) != 0) || (stat(path, &file_status) != 0);
+
+    free(object.surface_normals);
+    free(object.coordinates);
+
+    if (error)
+    {
+        return -1;
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    entry->cell[0] = points[0].cell[0];
+    entry->cell[1] = points[0].cell[1];
+    entry->cell[2] = points[0].cell[2];
+    entry->size = (uint64_t)file_status.st_size;
+
+    return 0;
+}
+
+/**
+ * \brief Write the chunks of sorted points and the index file
+ *
+ * \param[in] directory The directory of the world
+ * \param[in] chunk_size The length of the sides of the chunks [m]
+ * \param[in] points The points of the world, sorted by chunk
+ * \param[in] length The number of points
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int write_chunks(
+    const char *const directory,
+    const double chunk_size,
+    const struct WorldPoint *const points,
+    const long long length)
+{
+    struct IndexHeader header = {
+        .version = VERSION,
+        .byte_order_mark = BYTE_ORDER_MARK,
+        .chunk_size = chunk_size
+    };
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+    for (long long i = 0; i < length; ++i)
+    {
+        header.number_of_chunks += (i == 0) || (compare_cells(&points[i - 1], &points[i]) != 0);
+    }
+
+    char path[MAX_PATH_LENGTH];
+
+    if (get_index_path(directory, path, sizeof(path)) != 0)
+    {
+        return -1;
+    }
+
+    FILE *const file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    int error = fwrite(&header, sizeof(header), 1, file) != 1;
+    long long begin = 0;
+
+    while (!error && (begin < length))
+    {
+        long long end = begin + 1;
+
+        while ((end < length) && (compare_cells(&points[begin], &points[end]) == 0))
+        {
+            ++end;
+        }
+
+        struct IndexEntry entry;
+
+        error = (write_chunk(directory, &points[begin], end - begin, &entry) != 0) ||
+            (fwrite(&entry, sizeof(entry), 1, file) != 1);
+        begin = end;
+    }
+
+    error = (fclose(file) != 0) || error;
+
+    return error ? -1 : 0;
+}
+
+int WS_write_world(
+    const char *const directory,
+    const double chunk_size,
+    const struct REND_ObjectWithPosition *const objects,
+    const int length)
+{
+    assert(chunk_size > 0.0); // LCOV_EXCL_LINE
+
+    long long number_of_points = 0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        number_of_points += (objects[i].object == NULL) ? 0 : objects[i].object->length;
+    }
+
+    struct WorldPoint *const points = calloc((size_t)number_of_points + 1U, sizeof(*points));
+    long long offset = 0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        if (objects[i].object != NULL)
+        {
+            get_world_points(&objects[i], chunk_size, &points[offset]);
+            offset += objects[i].object->length;
+        }
+    }
+
+    qsort(points, (size_t)number_of_points, sizeof(*points), compare_cells);
+
+    const int error = write_chunks(directory, chunk_size, points, number_of_points);
+
+    free(points);
+
+    return error;
+}
+
+/**
+ * \brief Read the index file of a world
+ *
+ * \param[in,out] world The world, the directory must be set, the chunks are set
+ *
+ * \return 0 on success a non-zero value otherwise
+ */
+static int read_index(
+    struct WS_World *const world)
+{
+    char path[MAX_PATH_LENGTH];
+
+    if (get_index_path(world->directory, path, sizeof(path)) != 0)
+    {
+        return -1;
+    }
+
+    FILE *const file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    struct IndexHeader header;
+    int error = (fread(&header, sizeof(header), 1, file) != 1) ||
+        (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) ||
+        (header.version != VERSION) ||
+        (header.byte_order_mark != BYTE_ORDER_MARK) ||
+        !(header.chunk_size > 0.0) ||
+        (header.number_of_chunks > (uint64_t)INT_MAX);
+
+    if (!error)
+    {
+        world->number_of_chunks = (int)header.number_of_chunks;
+        world->chunks = calloc((size_t)world->number_of_chunks + 1U, sizeof(*world->chunks));
+    }
+
+    for (int i = 0; !error && (i < world->number_of_chunks); ++i)
+    {
+        struct IndexEntry entry;
+        struct Chunk *const chunk = &world->chunks[i];
+
+        error = (fread(&entry, sizeof(entry), 1, file) != 1) || (entry.size > (uint64_t)LLONG_MAX);
+
+        chunk->cell[0] = entry.cell[0];
+        chunk->cell[1] = entry.cell[1];
+        chunk->cell[2] = entry.cell[2];
+        chunk->bounds.min.x = entry.cell[0] * header.chunk_size;
+        chunk->bounds.min.y = entry.cell[1] * header.chunk_size;
+        chunk->bounds.min.z = entry.cell[2] * header.chunk_size;
+        chunk->bounds.max.x = chunk->bounds.min.x + header.chunk_size;
+        chunk->bounds.max.y = chunk->bounds.min.y + header.chunk_size;
+        chunk->bounds.max.z = chunk->bounds.min.z + header.chunk_size;
+        chunk->size = (long long)entry.size;
+        chunk->state = UNLOADED;
+    }
+
+    fclose(file);
+
+    return error ? -1 : 0;
+}
+
+/**
+ * \brief Get the distance from the camera to the closest point of a chunk
+ *
+ * \param[in] world The world
+ * \param[in] chunk The chunk
+ *
+ * \return The distance, 0 if the camera is inside the chunk [m]
+ */
+static double get_distance(
+    const struct WS_World *const world,
+    const struct Chunk *const chunk)
+{
+    const struct COORD_Coordinate3D *const camera = &world->camera_position;
+    const double dx = fmax(0.0, fmax(chunk->bounds.min.x - camera->x, camera->x - chunk->bounds.max.x));
+    const double dy = fmax(0.0, fmax(chunk->bounds.min.y - camera->y, camera->y - chunk->bounds.max.y));
+    const double dz = fmax(0.0, fmax(chunk->bounds.min.z - camera->z, camera->z - chunk->bounds.max.z));
+
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * \brief Decide what the loader thread should do next, the mutex must be locked
+ *
+ * Chunks outside the eviction radius are evicted first. Then the closest unloaded chunk inside the
+ * load radius is loaded, if it does not fit in the memory budget the farthest resident chunk is
+ * evicted to give room for it. Nothing is evicted while evicted chunks wait to be unloaded, the
+ * memory they free may be enough.
+ *
+ * \param[in] world The world
+ * \param[out] chunk The chunk to load or evict
+ *
+ * \return The action
+ */
+static enum Action get_next_action(
+    const struct WS_World *const world,
+    int *const chunk)
+{
+    int closest = -1;
+    int farthest = -1;
+    double closest_distance = 0.0;
+    double farthest_distance = 0.0;
+
+    if (!world->has_camera)
+    {
+        return WAIT;
+    }
+
+    for (int i = 0; i < world->number_of_chunks; ++i)
+    {
+        const double distance = get_distance(world, &world->chunks[i]);
+
+        if (world->chunks[i].state == RESIDENT)
+        {
+            if (distance > (world->load_radius * EVICTION_RADIUS_FACTOR))
+            {
+                *chunk = i;
+                return EVICT;
+            }
+
+            if ((farthest < 0) || (distance > farthest_distance))
+            {
+                farthest = i;
+                farthest_distance = distance;
+            }
+        }
+        else if ((world->chunks[i].state == UNLOADED) &&
+                 (distance <= world->load_radius) &&
+                 ((closest < 0) || (distance < closest_distance)))
+        {
+            closest = i;
+            closest_distance = distance;
+        }
+    }
+
+    if (closest < 0)
+    {
+        return WAIT;
+    }
+
+    if (world->chunks[closest].size <= (world->memory_budget - world->memory_in_use))
+    {
+        *chunk = closest;
+        return LOAD;
+    }
+
+    if ((world->evicted_memory == 0) && (farthest >= 0) && (farthest_distance > closest_distance))
+    {
+        *chunk = farthest;
+        return EVICT;
+    }
+
+    return WAIT;
+}
+
+/**
+ * \brief Get the time between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The elapsed time [s]
+ */
+static double get_elapsed_time(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + 1e-9 * (double)(end->tv_nsec - start->tv_nsec);
+}
+
+/**
+ * \brief Read one byte of each page of an object, so that the renderer does not have to wait for
+ *        the pages to be read from disk
+ *
+ * \param[in] object The object
+ */
+static void read_pages(
+    const struct OBJ_Object *const object)
+{
+    const long page_size = sysconf(_SC_PAGESIZE);
+    const size_t array_size = (size_t)object->length * sizeof(*object->coordinates);
+    const size_t step = (page_size > 0) ? (size_t)page_size : 4096U;
+    const volatile unsigned char *const coordinates = (const void *)object->coordinates;
+    const volatile unsigned char *const surface_normals = (const void *)object->surface_normals;
+    unsigned char sum = 0;
+
+    for (size_t i = 0; i < array_size; i += step)
+    {
+        sum = (unsigned char)(sum + coordinates[i] + surface_normals[i]);
+    }
+
+    (void)sum;
+}
+
+/**
+ * \brief Load a chunk, the mutex must be locked and is unlocked while the chunk is loaded
+ *
+ * \param[in,out] world The world
+ * \param[in,out] chunk The chunk
+ */
+static void load_chunk(
+    struct WS_World *const world,
+    struct Chunk *const chunk)
+{
+    char path[MAX_PATH_LENGTH];
+    struct timespec start;
+    struct timespec end;
+
+    chunk->state = LOADING;
+    pthread_mutex_unlock(&world->mutex);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    struct OBJF_MappedObject *const mapped_object =
+        (get_chunk_path(world->directory, chunk->cell, path, sizeof(path)) == 0) ? OBJF_map(path) : NULL;
+
+    if (mapped_object != NULL)
+    {
+        read_pages(OBJF_get_object(mapped_object));
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    pthread_mutex_lock(&world->mutex);
+
+    if (mapped_object == NULL)
+    {
+        chunk->state = FAILED;
+        return;
+    }
+
+    chunk->state = RESIDENT;
+    chunk->mapped_object = mapped_object;
+    chunk->object = *OBJF_get_object(mapped_object);
+    world->memory_in_use += chunk->size;
+    world->last_load_latency = get_elapsed_time(&start, &end);
+    world->total_load_latency += world->last_load_latency;
+    world->max_load_latency = fmax(world->max_load_latency, world->last_load_latency);
+    ++world->number_of_loads;
+}
+
+/**
+ * \brief The loader thread, loads and evicts chunks until the world is closed
+ *
+ * \param[in,out] argument The world
+ *
+ * \return NULL
+ */
+static void * run_loader(
+    void *const argument)
+{
+    struct WS_World *const world = argument;
+
+    pthread_mutex_lock(&world->mutex);
+
+    while (!world->is_closing)
+    {
+        int chunk = 0;
+        const enum Action action = get_next_action(world, &chunk);
+
+        switch (action)
+        {
+            case LOAD:
+                load_chunk(world, &world->chunks[chunk]);
+                break;
+            case EVICT:
+                world->chunks[chunk].state = EVICTED;
+                world->evicted_memory += world->chunks[chunk].size;
+                ++world->number_of_evictions;
+                break;
+            case WAIT:
+                world->is_idle = 1;
+                pthread_cond_broadcast(&world->idle);
+                pthread_cond_wait(&world->wake, &world->mutex);
+                break;
+            default: // LCOV_EXCL_LINE
+                assert(0); // LCOV_EXCL_LINE
+        }
+    }
+
+    pthread_mutex_unlock(&world->mutex);
+
+    return NULL;
+}
+
+struct WS_World * WS_open(
+    const char *const directory,
+    const double load_radius,
+    const long long memory_budget)
+{
+    struct WS_World *const world = calloc(1, sizeof(*world));
+    const int length = snprintf(world->directory, sizeof(world->directory), "%s", directory);
+
+    if ((length < 0) || ((size_t)length >= sizeof(world->directory)) || (read_index(world) != 0))
+    {
+        free(world->chunks);
+        free(world);
+        return NULL;
+    }
+
+    world->load_radius = load_radius;
+    world->memory_budget = memory_budget;
+    world->draw_list = calloc((size_t)world->number_of_chunks + 1U, sizeof(*world->draw_list));
+    world->is_idle = 1;
+    pthread_mutex_init(&world->mutex, NULL);
+    pthread_cond_init(&world->wake, NULL);
+    pthread_cond_init(&world->idle, NULL);
+
+    if (pthread_create(&world->loader, NULL, run_loader, world) != 0)
+    {
+        // LCOV_EXCL_START
+        pthread_cond_destroy(&world->idle);
+        pthread_cond_destroy(&world->wake);
+        pthread_mutex_destroy(&world->mutex);
+        free(world->draw_list);
+        free(world->chunks);
+        free(world);
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+
+    return world;
+}
+
+void WS_close(
+    struct WS_World *const world)
+{
+    pthread_mutex_lock(&world->mutex);
+    world->is_closing = 1;
+    pthread_cond_signal(&world->wake);
+    pthread_mutex_unlock(&world->mutex);
+
+    pthread_join(world->loader, NULL);
+
+    for (int i = 0; i < world->number_of_chunks; ++i)
+    {
+        if (world->chunks[i].mapped_object != NULL)
+        {
+            OBJF_unmap(world->chunks[i].mapped_object);
+        }
+    }
+
+    pthread_cond_destroy(&world->idle);
+    pthread_cond_destroy(&world->wake);
+    pthread_mutex_destroy(&world->mutex);
+    free(world->draw_list);
+    free(world->chunks);
+    free(world);
+}
+
+void WS_set_camera(
+    struct WS_World *const world,
+    const struct CAM_ExtrinsicParameters *const extrinsic)
+{
+    pthread_mutex_lock(&world->mutex);
+
+    if (!world->has_camera ||
+        (memcmp(&world->camera_position, &extrinsic->translation, sizeof(extrinsic->translation)) != 0))
+    {
+        world->camera_position = extrinsic->translation;
+        world->has_camera = 1;
+        world->is_idle = 0;
+        pthread_cond_signal(&world->wake);
+    }
+
+    pthread_mutex_unlock(&world->mutex);
+}
+
+void WS_wait(
+    struct WS_World *const world)
+{
+    pthread_mutex_lock(&world->mutex);
+
+    while (!world->is_idle)
+    {
+        pthread_cond_wait(&world->idle, &world->mutex);
+    }
+
+    pthread_mutex_unlock(&world->mutex);
+}
+
+void WS_get_objects(
+    struct WS_World *const world,
+    struct REND_Objects *const objects)
+{
+    int length = 0;
+
+    pthread_mutex_lock(&world->mutex);
+
+    for (int i = 0; i < world->number_of_chunks; ++i)
+    {
+        struct Chunk *const chunk = &world->chunks[i];
+
+        /* The renderer is done with the objects of the previous call, evicted chunks can be unloaded */
+        if (chunk->state == EVICTED)
+        {
+            OBJF_unmap(chunk->mapped_object);
+            chunk->mapped_object = NULL;
+            chunk->state = UNLOADED;
+            world->memory_in_use -= chunk->size;
+            world->evicted_memory -= chunk->size;
+            world->is_idle = 0;
+            pthread_cond_signal(&world->wake);
+        }
+        else if (chunk->state == RESIDENT)
+        {
+            struct REND_ObjectWithPosition *const object = &world->draw_list[length++];
+
+            memset(object, 0, sizeof(*object));
+            object->object = &chunk->object;
+            object->is_static = 1;
+        }
+    }
+
+    pthread_mutex_unlock(&world->mutex);
+
+    objects->objects = world->draw_list;
+    objects->length = length;
+    objects->instances = NULL;
+    objects->number_of_instances = 0;
+    objects->particle_systems = NULL;
+    objects->number_of_particle_systems = 0;
+}
+
+void WS_get_statistics(
+    struct WS_World *const world,
+    struct WS_Statistics *const statistics)
+{
+    pthread_mutex_lock(&world->mutex);
+
+    statistics->memory_in_use = world->memory_in_use;
+    statistics->number_of_resident_chunks = 0;
+    statistics->number_of_loads = world->number_of_loads;
+    statistics->number_of_evictions = world->number_of_evictions;
+    statistics->last_load_latency = world->last_load_latency;
+    statistics->average_load_latency =
+        (world->number_of_loads > 0) ? (world->total_load_latency / world->number_of_loads) : 0.0;
+    statistics->max_load_latency = world->max_load_latency;
+
+    for (int i = 0; i < world->number_of_chunks; ++i)
+    {
+        statistics->number_of_resident_chunks += world->chunks[i].state == RESIDENT;
+    }
+
+    pthread_mutex_unlock(&world->mutex);
+}
@@ -0,0 +1,205 @@
+/**
+ * \file
+ * \brief Parametric surface implementation
+ */
+#include "parametric_surface.h"
+
+#include <Base/coordinates.h>
+#include <Base/parallel.h>
+#include <Engine/object.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define MAX_NUMBER_OF_THREADS (64)
+#define MIN_ROWS_PER_THREAD (16) /* Avoid creating threads for very small objects */
+
+/**
+ * \brief Context shared by all threads generating a surface
+ */
+struct GenerationContext
+{
+    PSURF_Row row; /**< Evaluates one row of the surface */
+    const void *parameters; /**< Surface specific parameters */
+    const struct PSURF_Angles *u; /**< All u angles */
+    const struct PSURF_Angles *v; /**< All v angles */
+    struct OBJ_Object *object; /**< The object to fill */
+    int number_of_threads; /**< The rows are evenly split between this number of threads */
+};
+
+/**
+ * \brief Sample an angle in the range [0, 2 * pi)
+ *
+ * \param[in] resolution The distance between two samples [radians]
+ * \param[in] length The number of samples
+ * \param[out] angle The angles
+ * \param[out] sin_angle Sine of the angles
+ * \param[out] cos_angle Cosine of the angles
+ */
+static void sample_angles(
+    const double resolution,
+    const int length,
+    double *const angle,
+    double *const sin_angle,
+    double *const cos_angle)
+{
+    for (int i = 0; i < length; ++i)
+    {
+        angle[i] = i * resolution;
+        sin_angle[i] = sin(angle[i]);
+        cos_angle[i] = cos(angle[i]);
+    }
+}
+
+/**
+ * \brief Generate the rows of one thread, see PAR_Task
+ *
+ * \param[in,out] context The generation context (struct GenerationContext)
+ * \param[in] thread The index of the thread
+ */
+static void generate_rows(
+    void *const context,
+    const int thread)
+{
+    const struct GenerationContext *const generation = context;
+    const int rows = generation->u->length;
+    const int begin = (int)(((long long)rows * thread) / generation->number_of_threads);
+    const int end = (int)(((long long)rows * (thread + 1)) / generation->number_of_threads);
+
+    for (int i = begin; i < end; ++i)
+    {
+        const struct PSURF_Angle u = {
+            .angle = generation->u->angle[i],
+            .sin = generation->u->sin[i],
+            .cos = generation->u->cos[i]
+        };
+        const long long index = (long long)i * generation->v->length;
+
+        generation->row(
+            &u,
+            generation->v,
+            generation->parameters,
+            &generation->object->coordinates[index],
+            &generation->object->surface_normals[index]);
+    }
+}
+
+struct OBJ_Object * PSURF_create(
+    const PSURF_Row row,
+    const void *const parameters,
+    const double resolution)
+{
+    assert(resolution > 0.0); // LCOV_EXCL_LINE
+
+    const double step_size = (2.0 * M_PI) / resolution;
+    const int steps = (int)step_size;
+
+    assert(fabs((steps * resolution) - (2.0 * M_PI)) < (2 * resolution)); // LCOV_EXCL_LINE
+
+    /* The same samples are used for both angles. */
+    double *const angle = calloc((size_t)steps, sizeof(*angle));
+    double *const sin_angle = calloc((size_t)steps, sizeof(*sin_angle));
+    double *const cos_angle = calloc((size_t)steps, sizeof(*cos_angle));
+
+    sample_angles(resolution, steps, angle, sin_angle, cos_angle);
+
+    const struct PSURF_Angles angles = {
+        .angle = angle,
+        .sin = sin_angle,
+        .cos = cos_angle,
+        .length = steps
+    };
+
+    struct OBJ_Object *const object = calloc(1, sizeof(*object));
+
+    object->length = (long long)steps * steps;
+    object->coordinates = calloc((size_t)object->length, sizeof(*object->coordinates));
+    object->surface_normals = calloc((size_t)object->length, sizeof(*object->surface_normals));
+
+    const int needed_threads = (steps + MIN_ROWS_PER_THREAD - 1) / MIN_ROWS_PER_THREAD;
+    struct GenerationContext context = {
+        .row = row,
+        .parameters = parameters,
+        .u = &angles,
+        .v = &angles,
+        .object = object,
+        .number_of_threads = PAR_get_number_of_threads(
+            (needed_threads < MAX_NUMBER_OF_THREADS) ? needed_threads : MAX_NUMBER_OF_THREADS)
+    };
+
+    PAR_run(generate_rows, &context, context.number_of_threads);
+
+    OBJ_update_bounds(object);
+
+    free(cos_angle);
+    free(sin_angle);
+    free(angle);
+
+    return object;
+}
+
+struct OBJ_Mesh * PSURF_create_mesh(
+    const PSURF_Row row,
+    const void *const parameters,
+    const double resolution)
+{
+    struct OBJ_Object *const object = PSURF_create(row, parameters, resolution);
+    const int steps = (int)((2.0 * M_PI) / resolution);
+
+    assert(object->length == ((long long)steps * steps)); // LCOV_EXCL_LINE
+
+    struct OBJ_Mesh *const mesh = calloc(1, sizeof(*mesh));
+
+    /* The mesh takes over the vertices of the object. */
+    mesh->coordinates = object->coordinates;
+    mesh->surface_normals = object->surface_normals;
+    mesh->length = object->length;
+    mesh->bounds = object->bounds;
+    free(object);
+
+    /* Each sample (u_i, v_j) is the corner of a quad, made of two triangles, that is connected to
+     * the next sample of both angles. Both angles wrap around so the surface is closed. */
+    mesh->number_of_triangles = 2 * mesh->length;
+    mesh->indices = calloc((size_t)(3 * mesh->number_of_triangles), sizeof(*mesh->indices));
+
+    long long *index = mesh->indices;
+
+    for (int i = 0; i < steps; ++i)
+    {
+        const long long row_index = (long long)i * steps;
+        const long long next_row_index = (long long)((i + 1) % steps) * steps;
+
+        for (int j = 0; j < steps; ++j)
+        {
+            const int next_j = (j + 1) % steps;
+
+            *index++ = row_index + j;
+            *index++ = next_row_index + j;
+            *index++ = next_row_index + next_j;
+
+            *index++ = row_index + j;
+            *index++ = next_row_index + next_j;
+            *index++ = row_index + next_j;
+        }
+    }
+
+    return mesh;
+}
+
+void PSURF_free_mesh(
+    struct OBJ_Mesh *const mesh)
+{
+    free(mesh->indices);
+    free(mesh->surface_normals);
+    free(mesh->coordinates);
+    free(mesh);
+}
+
+void PSURF_free(
+    struct OBJ_Object *const object)
+{
+    free(object->surface_normals);
+    free(object->coordinates);
+    free(object);
+}
@@ -0,0 +1,106 @@
+/**
+ * \file
+ * \brief Parametric surface interface
+ *
+ * Generates objects from parametric surfaces, i.e. surfaces where each coordinate and surface
+ * normal is a function of two angles (u, v). Both angles are sampled in the range [0, 2 * pi) with
+ * a certain resolution. The sine and cosine of all samples are precomputed and the rows (samples of
+ * u) are generated in parallel.
+ */
+#ifndef GAME_OBJECTS_PARAMETRICSURFACE_H
+#define GAME_OBJECTS_PARAMETRICSURFACE_H
+
+struct COORD_Coordinate3D;
+struct OBJ_Mesh;
+struct OBJ_Object;
+
+/**
+ * \brief A sampled angle
+ */
+struct PSURF_Angle
+{
+    double angle; /**< The angle [radians] */
+    double sin; /**< Sine of the angle */
+    double cos; /**< Cosine of the angle */
+};
+
+/**
+ * \brief All samples of an angle, stored as separate arrays
+ */
+struct PSURF_Angles
+{
+    const double *angle; /**< The angles [radians] */
+    const double *sin; /**< Sine of the angles */
+    const double *cos; /**< Cosine of the angles */
+    int length; /**< Number of samples */
+};
+
+/**
+ * \brief Evaluates one row of a parametric surface, i.e. one sample of u and all samples of v
+ *
+ * \param[in] u The u angle of the row
+ * \param[in] v All v angles
+ * \param[in] parameters Surface specific parameters
+ * \param[out] coordinates The coordinates of the row, one for each v angle
+ * \param[out] surface_normals The surface normals of the row, one for each v angle
+ */
+typedef void (*PSURF_Row)(
+    const struct PSURF_Angle *u,
+    const struct PSURF_Angles *v,
+    const void *parameters,
+    struct COORD_Coordinate3D *coordinates,
+    struct COORD_Coordinate3D *surface_normals);
+
+/**
+ * \brief Creates an object from a parametric surface
+ *
+ * The coordinate of sample (u_i, v_j) is stored at index i * number_of_v_samples + j. The caller
+ * must free the object using PSURF_free() when it is no longer used.
+ *
+ * \param[in] row Evaluates one row of the surface
+ * \param[in] parameters Surface specific parameters, passed to the row function
+ * \param[in] resolution The distance between two samples [radians]
+ *
+ * \return Object
+ */
+struct OBJ_Object * PSURF_create(
+    PSURF_Row row,
+    const void *parameters,
+    double resolution);
+
+/**
+ * \brief Creates a triangle mesh from a parametric surface
+ *
+ * The vertices are the same as the points of PSURF_create(). Each vertex is connected to its
+ * neighbors by two triangles, the triangles wrap around in both angles. A mesh covers the same
+ * pixels as an object with a much lower resolution. The caller must free the mesh using
+ * PSURF_free_mesh() when it is no longer used.
+ *
+ * \param[in] row Evaluates one row of the surface
+ * \param[in] parameters Surface specific parameters, passed to the row function
+ * \param[in] resolution The distance between two samples [radians]
+ *
+ * \return Mesh
+ */
+struct OBJ_Mesh * PSURF_create_mesh(
+    PSURF_Row row,
+    const void *parameters,
+    double resolution);
+
+/**
+ * \brief Free a mesh created from a parametric surface
+ *
+ * \param[in,out] mesh The mesh to free (do not use it anymore)
+ */
+void PSURF_free_mesh(
+    struct OBJ_Mesh *mesh);
+
+/**
+ * \brief Free an object created from a parametric surface
+ *
+ * \param[in,out] object The object to free (do not use it anymore)
+ */
+void PSURF_free(
+    struct OBJ_Object *object);
+
+#endif /* GAME_OBJECTS_PARAMETRICSURFACE_H */
@@ -0,0 +1,66 @@
+#include "../sphere.h"
+#include "../torus.h"
+
+#include <Base/common.h>
+#include <Engine/object.h>
+
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * \brief Get the time difference between two points in time
+ *
+ * \param[in] start The start time
+ * \param[in] end The end time
+ *
+ * \return The difference [ms]
+ */
+static double get_elapsed_ms(
+    const struct timespec *const start,
+    const struct timespec *const end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e3) + ((double)(end->tv_nsec - start->tv_nsec) * 1e-6);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    static const double resolutions[] = {0.08, 0.04, 0.02, 0.01, 0.005, 0.0025};
+
+    /* The wall time shows the actual generation time, the CPU time includes all threads. */
+    printf("%-12s %-10s %12s %12s %12s %12s %12s\n",
+        "resolution", "points", "sphere wall", "sphere cpu", "torus wall", "torus cpu", "Mpoints/s");
+
+    for (size_t i = 0; i < LENGTH(resolutions); ++i)
+    {
+        struct timespec wall[3];
+        struct timespec cpu[3];
+
+        clock_gettime(CLOCK_MONOTONIC, &wall[0]);
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[0]);
+        struct OBJ_Object *const sphere = SPHERE_create(1.0, resolutions[i]);
+        clock_gettime(CLOCK_MONOTONIC, &wall[1]);
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[1]);
+        struct OBJ_Object *const torus = TORUS_create(0.5, 1.0, resolutions[i]);
+        clock_gettime(CLOCK_MONOTONIC, &wall[2]);
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[2]);
+
+        const double sphere_wall_ms = get_elapsed_ms(&wall[0], &wall[1]);
+        const double torus_wall_ms = get_elapsed_ms(&wall[1], &wall[2]);
+        const double points_per_second = (double)(sphere->length + torus->length) / ((sphere_wall_ms + torus_wall_ms) * 1e-3);
+
+        printf("%-12.4f %-10lld %9.2lf ms %9.2lf ms %9.2lf ms %9.2lf ms %12.1lf\n",
+            resolutions[i],
+            sphere->length,
+            sphere_wall_ms,
+            get_elapsed_ms(&cpu[0], &cpu[1]),
+            torus_wall_ms,
+            get_elapsed_ms(&cpu[1], &cpu[2]),
+            points_per_second * 1e-6);
+
+        TORUS_free(torus);
+        SPHERE_free(sphere);
+    }
+}
@@ -0,0 +1,206 @@
+#include "../sphere.h"
+#include "../torus.h"
+
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/camera.h>
+#include <Engine/coordinate_system_transformations.h>
+#include <Engine/object.h>
+#include <Engine/object_optimization.h>
+#include <Engine/renderer.h>
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SCREEN_WIDTH (1000)
+#define SCREEN_HEIGHT (500)
+#define RESOLUTION (0.01) /* Radians */
+#define FRAMES (10)
+
+/**
+ * \brief Performance counters measured for each configuration
+ */
+enum
+{
+    CACHE_REFERENCES,
+    CACHE_MISSES,
+    L1D_READ_MISSES,
+    NUMBER_OF_COUNTERS
+};
+
+static const char *const counter_names[NUMBER_OF_COUNTERS] = {
+    [CACHE_REFERENCES] = "cache references",
+    [CACHE_MISSES] = "cache misses",
+    [L1D_READ_MISSES] = "L1d read misses",
+};
+
+/**
+ * \brief Open a performance counter for the calling thread
+ *
+ * \param[in] counter The counter
+ *
+ * \return File descriptor of the counter, negative if not available
+ */
+static int open_counter(
+    const int counter)
+{
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+
+    attributes.size = sizeof(attributes);
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    switch (counter)
+    {
+        case CACHE_REFERENCES:
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_REFERENCES;
+            break;
+        case CACHE_MISSES:
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case L1D_READ_MISSES:
+        default:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+            break;
+    }
+
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+/**
+ * \brief Render a number of frames of a rotating torus and an orbiting sphere
+ *
+ * \param[in] torus The torus
+ * \param[in] sphere The sphere
+ * \param[out] counters The performance counters, -1 if not available
+ *
+ * \return The wall time [ms]
+ */
+static double render(
+    const struct OBJ_Object *const torus,
+    const struct OBJ_Object *const sphere,
+    long long counters[NUMBER_OF_COUNTERS])
+{
+    const struct COORD_Coordinate2D optical_center = {.x = SCREEN_WIDTH / 2.0, .y = SCREEN_HEIGHT / 2.0};
+    const struct COORD_Coordinate3D camera_translation = {.x = 0.0, .y = 0.0, .z = 0.0};
+    const struct CST_Rotation3D camera_rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0};
+    const struct COORD_Coordinate3D light_source = {.x = -1.0, .y = 1.0, .z = 1.0};
+    struct CAM_CameraParameters calibration;
+    CAM_get_camera_calibration(0.9, 2.0, 1.0, &optical_center, &camera_translation, &camera_rotation, &calibration);
+
+    struct REND_ObjectWithPosition objects[] = {
+        {.object = torus, .position = {.x = 0.0, .y = 0.0, .z = 3.0}},
+        {.object = sphere, .position = {.x = 1.0, .y = 0.0, .z = 3.0}},
+    };
+    const struct REND_Objects model = {
+        .objects = objects,
+        .length = LENGTH(objects)
+    };
+
+    /* Use a very high frame rate to make sure the frame synchronizer never sleeps. */
+    struct REND_Renderer *const renderer = REND_create(&calibration, SCREEN_WIDTH, SCREEN_HEIGHT, 1e6);
+    int fds[NUMBER_OF_COUNTERS];
+
+    for (int i = 0; i < NUMBER_OF_COUNTERS; ++i)
+    {
+        fds[i] = open_counter(i);
+
+        if (fds[i] >= 0)
+        {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        objects[0].rotation.pitch = 0.08 * frame;
+        objects[0].rotation.yaw = 0.04 * frame;
+        REND_render(renderer, &light_source, &model);
+    }
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    for (int i = 0; i < NUMBER_OF_COUNTERS; ++i)
+    {
+        counters[i] = -1;
+
+        if (fds[i] >= 0)
+        {
+            uint64_t value = 0U;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(fds[i], &value, sizeof(value)) == (ssize_t)sizeof(value))
+            {
+                counters[i] = (long long)value;
+            }
+
+            close(fds[i]);
+        }
+    }
+
+    REND_destroy(renderer);
+
+    return ((double)(end.tv_sec - start.tv_sec) * 1e3) + ((double)(end.tv_nsec - start.tv_nsec) * 1e-6);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    /* The frames are not interesting, only the time it takes to render them. */
+    if (freopen("/dev/null", "w", stdout) == NULL)
+    {
+        return 1;
+    }
+
+    struct OBJ_Object *const torus = TORUS_create(0.5, 1.0, RESOLUTION);
+    struct OBJ_Object *const sphere = SPHERE_create(0.3, RESOLUTION);
+    long long counters[2][NUMBER_OF_COUNTERS];
+    double wall_ms[2];
+
+    wall_ms[0] = render(torus, sphere, counters[0]);
+
+    OBJOPT_sort_morton(torus);
+    OBJOPT_sort_morton(sphere);
+
+    wall_ms[1] = render(torus, sphere, counters[1]);
+
+    fprintf(stderr, "%d frames, %dx%d screen, %lld points per frame\n",
+        FRAMES, SCREEN_WIDTH, SCREEN_HEIGHT, torus->length + sphere->length);
+    fprintf(stderr, "%-20s %16s %16s\n", "", "parameter order", "Morton order");
+    fprintf(stderr, "%-20s %13.1lf ms %13.1lf ms\n", "wall time", wall_ms[0], wall_ms[1]);
+
+    for (int i = 0; i < NUMBER_OF_COUNTERS; ++i)
+    {
+        if ((counters[0][i] < 0) || (counters[1][i] < 0))
+        {
+            fprintf(stderr, "%-20s %16s %16s\n", counter_names[i], "n/a", "n/a");
+        }
+        else
+        {
+            fprintf(stderr, "%-20s %16lld %16lld\n", counter_names[i], counters[0][i], counters[1][i]);
+        }
+    }
+
+    SPHERE_free(sphere);
+    TORUS_free(torus);
+}
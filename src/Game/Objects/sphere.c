@@ -2,57 +2,63 @@
  * \file
  * \brief Sphere implementation
  */
+#include "parametric_surface.h"
 #include "sphere.h"
 
 #include <Base/coordinates.h>
 #include <Engine/object.h>
 
-#include <assert.h>
-#include <math.h>
-#include <stdlib.h>
-
-#define RESOLUTION (0.02) /* Radians */
-
-struct OBJ_Object * SPHERE_create(
-    const double radius)
+/**
+ * \brief Sphere parameters
+ */
+struct SphereParameters
 {
-    const double step_size = (2.0 * M_PI) / RESOLUTION;
-    const int steps = (int)step_size;
-    struct OBJ_Object *const sphere = calloc(1, sizeof(*sphere));
-
-    assert(fabs((steps * RESOLUTION) - (2.0 * M_PI)) < (2 * RESOLUTION)); // LCOV_EXCL_LINE
+    double radius; /**< The radius of the sphere */
+};
 
-    sphere->length = steps * steps;
-    sphere->coordinates = calloc((size_t)sphere->length, sizeof(*sphere->coordinates));
-    sphere->surface_normals = calloc((size_t)sphere->length, sizeof(*sphere->surface_normals));
-
-    int index = 0;
+/**
+ * \brief Evaluates one row of a sphere, see PSURF_Row
+ *
+ * The u angle is the polar angle (fi) and the v angle is the azimuthal angle (theta).
+ */
+static void sphere_row(
+    const struct PSURF_Angle *const u,
+    const struct PSURF_Angles *const v,
+    const void *const parameters,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals)
+{
+    const struct SphereParameters *const sphere = parameters;
+    const double radius_sin_fi = sphere->radius * u->sin;
+    const double radius_cos_fi = sphere->radius * u->cos;
 
-    for (int i = 0; i < steps; ++i)
+    for (int j = 0; j < v->length; ++j)
     {
-        const double fi = i * RESOLUTION;
+        const struct COORD_Coordinate3D coordinate = {
+            .x = radius_sin_fi * v->cos[j],
+            .y = radius_sin_fi * v->sin[j],
+            .z = radius_cos_fi
+        };
 
-        for (int j = 0; j < steps; ++j)
-        {
-            const double theta = j * RESOLUTION;
-            const struct COORD_Coordinate3D coordinate = {
-                .x = radius * sin(fi) * cos(theta),
-                .y = radius * sin(fi) * sin(theta),
-                .z = radius * cos(fi)
-            };
-
-            assert(index < sphere->length); // LCOV_EXCL_LINE
+        coordinates[j] = coordinate;
+        /* Radius is not needed for the surface normal but it does not change the direction of
+         * the vector so it is simplest just to include it. */
+        surface_normals[j] = coordinate;
+    }
+}
 
-            sphere->coordinates[index] = coordinate;
-            /* Radius is not needed for the surface normal but it does not change the direction of
-             * the vector so it is simplest just to include it. */
-            sphere->surface_normals[index] = coordinate;
+struct OBJ_Object * SPHERE_create(
+    const double radius,
+    const double resolution)
+{
+    const struct SphereParameters parameters = {
+        .radius = radius
+    };
 
-            ++index;
-        }
-    }
+    struct OBJ_Object *const sphere = PSURF_create(sphere_row, &parameters, resolution);
 
-    assert(index == sphere->length); // LCOV_EXCL_LINE
+    /* The points are furthest apart along the equator. */
+    sphere->sample_spacing = resolution * radius;
 
     return sphere;
 }
@@ -60,7 +66,5 @@ struct OBJ_Object * SPHERE_create(
 void SPHERE_free(
     struct OBJ_Object *const sphere)
 {
-    free(sphere->surface_normals);
-    free(sphere->coordinates);
-    free(sphere);
+    PSURF_free(sphere);
 }
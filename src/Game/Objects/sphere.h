@@ -13,11 +13,13 @@ struct OBJ_Object;
  * The caller must free the object using SPHERE_free() when it is no longer used.
  *
  * \param[in] radius The radius of the sphere
+ * \param[in] resolution The angular distance between two points [radians]
  *
  * \return Sphere
  */
 struct OBJ_Object * SPHERE_create(
-    double radius);
+    double radius,
+    double resolution);
 
 /**
  * \brief Free a sphere
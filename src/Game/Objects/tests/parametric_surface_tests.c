@@ -0,0 +1,113 @@
+#include "../parametric_surface.h"
+
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/object.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void angle_row(
+    const struct PSURF_Angle *const u,
+    const struct PSURF_Angles *const v,
+    const void *const parameters,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals)
+{
+    const double scale = *(const double *)parameters;
+
+    for (int j = 0; j < v->length; ++j)
+    {
+        coordinates[j].x = scale * u->angle;
+        coordinates[j].y = scale * v->angle[j];
+        coordinates[j].z = (u->sin * u->sin) + (v->cos[j] * v->cos[j]);
+
+        surface_normals[j].x = u->cos;
+        surface_normals[j].y = v->sin[j];
+        surface_normals[j].z = 0.0;
+    }
+}
+
+static void test_PSURF_create(void)
+{
+    const double scale = 2.0;
+    const double resolution = 0.01;
+    const int steps = (int)((2.0 * M_PI) / resolution);
+    struct OBJ_Object *const object = PSURF_create(angle_row, &scale, resolution);
+
+    TF_assert(object->length == (long long)steps * steps);
+
+    for (int i = 0; i < steps; ++i)
+    {
+        for (int j = 0; j < steps; ++j)
+        {
+            const long long index = ((long long)i * steps) + j;
+            const double u = i * resolution;
+            const double v = j * resolution;
+
+            TF_assert_double_eq(object->coordinates[index].x, scale * u, granularity);
+            TF_assert_double_eq(object->coordinates[index].y, scale * v, granularity);
+            TF_assert_double_eq(object->coordinates[index].z, (sin(u) * sin(u)) + (cos(v) * cos(v)), granularity);
+            TF_assert_double_eq(object->surface_normals[index].x, cos(u), granularity);
+            TF_assert_double_eq(object->surface_normals[index].y, sin(v), granularity);
+        }
+    }
+
+    TF_assert_double_eq(object->bounds.min.x, 0.0, granularity);
+    TF_assert_double_eq(object->bounds.max.y, scale * (steps - 1) * resolution, granularity);
+
+    PSURF_free(object);
+}
+
+static void test_PSURF_create_mesh(void)
+{
+    const double scale = 1.0;
+    const double resolution = 0.5;
+    const int steps = (int)((2.0 * M_PI) / resolution);
+    struct OBJ_Mesh *const mesh = PSURF_create_mesh(angle_row, &scale, resolution);
+
+    TF_assert(mesh->length == (long long)steps * steps);
+    TF_assert(mesh->number_of_triangles == 2 * mesh->length);
+
+    /* The vertices of a triangle are neighboring samples, i.e. the sample indices differ by at
+     * most one (modulo wrap around). */
+    for (long long i = 0; i < 3 * mesh->number_of_triangles; i += 3)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            const long long a = mesh->indices[i + k];
+            const long long b = mesh->indices[i + ((k + 1) % 3)];
+
+            TF_assert((a >= 0) && (a < mesh->length));
+
+            const long long u_distance = llabs((a / steps) - (b / steps));
+            const long long v_distance = llabs((a % steps) - (b % steps));
+
+            TF_assert((u_distance <= 1) || (u_distance == steps - 1));
+            TF_assert((v_distance <= 1) || (v_distance == steps - 1));
+        }
+    }
+
+    TF_assert_double_eq(mesh->coordinates[steps + 1].x, resolution, granularity);
+    TF_assert_double_eq(mesh->coordinates[steps + 1].y, resolution, granularity);
+
+    PSURF_free_mesh(mesh);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_PSURF_create,
+        test_PSURF_create_mesh,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
@@ -9,13 +9,14 @@
 int TF_test_case_status;
 
 static const double granularity = 1e-5;
+static const double resolution = 0.02;
 
 static void test_sphere(void)
 {
     const double radius = 2.0;
-    struct OBJ_Object *const sphere = SPHERE_create(radius);
+    struct OBJ_Object *const sphere = SPHERE_create(radius, resolution);
 
-    for (int i = 0; i < sphere->length; ++i)
+    for (long long i = 0; i < sphere->length; ++i)
     {
         const struct COORD_Coordinate3D *const coordinate = &sphere->coordinates[i];
         double vector_data[] = {coordinate->x, coordinate->y, coordinate->z};
@@ -28,6 +29,8 @@ static void test_sphere(void)
         TF_assert_double_eq(norm, radius, granularity);
     }
 
+    TF_assert_double_eq(sphere->sample_spacing, resolution * radius, granularity);
+
     SPHERE_free(sphere);
 }
 
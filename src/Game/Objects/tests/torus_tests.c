@@ -6,20 +6,23 @@
 #include <LinearAlgebra/vector.h>
 #include <TestFramework/test_framework.h>
 
+#include <math.h>
+
 int TF_test_case_status;
 
 static const double granularity = 1e-5;
+static const double resolution = 0.02;
 
 static void test_torus(void)
 {
     /* NOTE: Assumes that the torus is created in a certain orientation. */
     const double inner_radius = 0.2;
     const double outer_radius = 0.6;
-    struct OBJ_Object *const torus = TORUS_create(inner_radius, outer_radius);
+    struct OBJ_Object *const torus = TORUS_create(inner_radius, outer_radius, resolution);
     const double max_radius = outer_radius + inner_radius;
     const double min_radius = outer_radius - inner_radius;
 
-    for (int i = 0; i < torus->length; ++i)
+    for (long long i = 0; i < torus->length; ++i)
     {
         const struct COORD_Coordinate3D *const coordinate = &torus->coordinates[i];
 
@@ -38,9 +41,37 @@ static void test_torus(void)
         TF_assert(valid_y);
     }
 
+    TF_assert_double_eq(torus->sample_spacing, resolution * max_radius, granularity);
+
     TORUS_free(torus);
 }
 
+static void test_torus_mesh(void)
+{
+    const double inner_radius = 0.2;
+    const double outer_radius = 0.6;
+    struct OBJ_Mesh *const torus = TORUS_create_mesh(inner_radius, outer_radius, 0.15);
+
+    TF_assert(torus->length < 2000);
+    TF_assert(torus->number_of_triangles == 2 * torus->length);
+
+    for (long long i = 0; i < torus->length; ++i)
+    {
+        const struct COORD_Coordinate3D *const coordinate = &torus->coordinates[i];
+        const double norm = sqrt((coordinate->x * coordinate->x) + (coordinate->z * coordinate->z));
+
+        TF_assert(norm >= (outer_radius - inner_radius - granularity));
+        TF_assert(norm <= (outer_radius + inner_radius + granularity));
+    }
+
+    for (long long i = 0; i < 3 * torus->number_of_triangles; ++i)
+    {
+        TF_assert((torus->indices[i] >= 0) && (torus->indices[i] < torus->length));
+    }
+
+    TORUS_free_mesh(torus);
+}
+
 int main(int argc, char *argv[])
 {
     UNUSED(argc);
@@ -48,6 +79,7 @@ int main(int argc, char *argv[])
 
     TF_test_case test_cases[] = {
         test_torus,
+        test_torus_mesh,
     };
 
     return TF_run_suite(test_cases, LENGTH(test_cases));
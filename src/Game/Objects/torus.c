@@ -2,89 +2,97 @@
  * \file
  * \brief Torus implementation
  */
+#include "parametric_surface.h"
 #include "torus.h"
 
 #include <Base/coordinates.h>
-#include <Engine/coordinate_system_transformations.h>
 #include <Engine/object.h>
-#include <LinearAlgebra/matrix.h>
-#include <LinearAlgebra/vector.h>
 
 #include <assert.h>
-#include <math.h>
-#include <stdlib.h>
 
-#define RESOLUTION (0.02) /* Radians */
+/**
+ * \brief Torus parameters
+ */
+struct TorusParameters
+{
+    double inner_radius; /**< The radius of the "tube" */
+    double outer_radius; /**< The distance from the center of the torus to the center of the "tube" */
+};
+
+/**
+ * \brief Evaluates one row of a torus, see PSURF_Row
+ *
+ * The v angle (beta) traces a circle of the "tube" in the x-y plane, this circle is then rotated
+ * around the y-axis by the u angle (alpha).
+ */
+static void torus_row(
+    const struct PSURF_Angle *const u,
+    const struct PSURF_Angles *const v,
+    const void *const parameters,
+    struct COORD_Coordinate3D *const coordinates,
+    struct COORD_Coordinate3D *const surface_normals)
+{
+    const struct TorusParameters *const torus = parameters;
+    const double cos_alpha = u->cos;
+    const double sin_alpha = u->sin;
+
+    for (int j = 0; j < v->length; ++j)
+    {
+        const double distance_from_center = torus->outer_radius + (torus->inner_radius * v->cos[j]);
+
+        coordinates[j].x = cos_alpha * distance_from_center;
+        coordinates[j].y = torus->inner_radius * v->sin[j];
+        coordinates[j].z = -sin_alpha * distance_from_center;
+
+        surface_normals[j].x = cos_alpha * v->cos[j];
+        surface_normals[j].y = v->sin[j];
+        surface_normals[j].z = -sin_alpha * v->cos[j];
+    }
+}
 
 struct OBJ_Object * TORUS_create(
     const double inner_radius,
-    const double outer_radius)
+    const double outer_radius,
+    const double resolution)
 {
     assert(outer_radius > inner_radius); // LCOV_EXCL_LINE
 
-    const double step_size = (2.0 * M_PI) / RESOLUTION;
-    const int steps = (int)step_size;
-    struct OBJ_Object *const torus = calloc(1, sizeof(*torus));
-    struct VEC_Vector *const coordinate_vector = VEC_alloc(3);
-    struct VEC_Vector *const surface_normal_vector = VEC_alloc(3);
+    const struct TorusParameters parameters = {
+        .inner_radius = inner_radius,
+        .outer_radius = outer_radius
+    };
 
-    assert(fabs((steps * RESOLUTION) - (2.0 * M_PI)) < (2 * RESOLUTION)); // LCOV_EXCL_LINE
+    struct OBJ_Object *const torus = PSURF_create(torus_row, &parameters, resolution);
 
-    torus->length = steps * steps;
-    torus->coordinates = calloc((size_t)torus->length, sizeof(*torus->coordinates));
-    torus->surface_normals = calloc((size_t)torus->length, sizeof(*torus->surface_normals));
+    /* The points are furthest apart along the outer edge of the torus. */
+    torus->sample_spacing = resolution * (outer_radius + inner_radius);
 
-    int index = 0;
+    return torus;
+}
 
-    for (int i = 0; i < steps; ++i)
-    {
-        const double alpha = i * RESOLUTION;
-        const struct CST_Rotation3D rotation = {
-            .pitch = 0.0,
-            .yaw = alpha,
-            .roll = 0.0,
-        };
-        struct MAT_Matrix *const rotation_matrix = CST_get_extrinsic_rotation_matrix(&rotation);
-
-        for (int j = 0; j < steps; ++j)
-        {
-            const double beta = j * RESOLUTION;
-
-            const struct COORD_Coordinate3D coordinate = {
-                .x = outer_radius + (inner_radius * cos(beta)),
-                .y = inner_radius * sin(beta),
-                .z = 0.0
-            };
-
-            const struct COORD_Coordinate3D surface_normal = {
-                .x = cos(beta),
-                .y = sin(beta),
-                .z = 0.0
-            };
-
-            assert(index < torus->length); // LCOV_EXCL_LINE
-
-            CST_linear_transformation(&coordinate, rotation_matrix, &torus->coordinates[index]);
-            CST_linear_transformation(&surface_normal, rotation_matrix, &torus->surface_normals[index]);
-
-            ++index;
-        }
-
-        MAT_free(rotation_matrix);
-    }
+struct OBJ_Mesh * TORUS_create_mesh(
+    const double inner_radius,
+    const double outer_radius,
+    const double resolution)
+{
+    assert(outer_radius > inner_radius); // LCOV_EXCL_LINE
 
-    assert(index == torus->length); // LCOV_EXCL_LINE
+    const struct TorusParameters parameters = {
+        .inner_radius = inner_radius,
+        .outer_radius = outer_radius
+    };
 
-    VEC_free(surface_normal_vector);
-    VEC_free(coordinate_vector);
+    return PSURF_create_mesh(torus_row, &parameters, resolution);
+}
 
-    return torus;
+void TORUS_free_mesh(
+    struct OBJ_Mesh *const torus)
+{
+    PSURF_free_mesh(torus);
 }
 
 void TORUS_free(
     struct OBJ_Object *const torus)
 {
-    free(torus->surface_normals);
-    free(torus->coordinates);
-    free(torus);
+    PSURF_free(torus);
 }
@@ -5,6 +5,7 @@
 #ifndef GAME_OBJECTS_TORUS_H
 #define GAME_OBJECTS_TORUS_H
 
+struct OBJ_Mesh;
 struct OBJ_Object;
 
 /**
@@ -14,12 +15,40 @@ struct OBJ_Object;
  *
  * \param[in] inner_radius The radius of the "tube"
  * \param[in] outer_radius The distance from the center of the torus to the center of the "tube"
+ * \param[in] resolution The angular distance between two points [radians]
  *
  * \return Torus
  */
 struct OBJ_Object * TORUS_create(
     double inner_radius,
-    double outer_radius);
+    double outer_radius,
+    double resolution);
+
+/**
+ * \brief Creates a torus triangle mesh
+ *
+ * The triangles are filled when rendered, a mesh thus needs a much lower resolution than an object,
+ * e.g. 0.15 radians (less than two thousand vertices), to cover the same pixels. The caller must free the mesh using
+ * TORUS_free_mesh() when it is no longer used.
+ *
+ * \param[in] inner_radius The radius of the "tube"
+ * \param[in] outer_radius The distance from the center of the torus to the center of the "tube"
+ * \param[in] resolution The angular distance between two vertices [radians]
+ *
+ * \return Torus mesh
+ */
+struct OBJ_Mesh * TORUS_create_mesh(
+    double inner_radius,
+    double outer_radius,
+    double resolution);
+
+/**
+ * \brief Free a torus mesh
+ *
+ * \param[in,out] torus The torus mesh to free (do not use it anymore)
+ */
+void TORUS_free_mesh(
+    struct OBJ_Mesh *torus);
 
 /**
  * \brief Free a torus
@@ -0,0 +1,375 @@
+/**
+ * \file
+ * \brief Entity store implementation
+ */
+#include "entities.h"
+
+#include <Base/coordinates.h>
+#include <Engine/coordinate_system_transformations.h>
+#include <Engine/renderer.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FREE_SLOT (-1) /* The dense index of slots that do not hold a live entity */
+#define NUMBER_OF_INTERPOLATED_COMPONENTS (6) /* The rotation and position components */
+
+/**
+ * \brief The component arrays, each component has one array of doubles
+ *
+ * The previous rotation and position are the values before the last update, used to interpolate
+ * between updates.
+ */
+enum Component
+{
+    PATH_CENTER_X,
+    PATH_CENTER_Y,
+    PATH_CENTER_Z,
+    PATH_RADIUS,
+    PATH_ANGLE,
+    PATH_ANGULAR_VELOCITY,
+    ANGULAR_VELOCITY_PITCH,
+    ANGULAR_VELOCITY_YAW,
+    ANGULAR_VELOCITY_ROLL,
+    /* The interpolated components (rotation and position) must be followed by their previous values
+     * in the same order. */
+    ROTATION_PITCH,
+    ROTATION_YAW,
+    ROTATION_ROLL,
+    POSITION_X,
+    POSITION_Y,
+    POSITION_Z,
+    PREVIOUS_ROTATION_PITCH,
+    PREVIOUS_ROTATION_YAW,
+    PREVIOUS_ROTATION_ROLL,
+    PREVIOUS_POSITION_X,
+    PREVIOUS_POSITION_Y,
+    PREVIOUS_POSITION_Z,
+    NUMBER_OF_COMPONENTS
+};
+
+/**
+ * \brief Entity store
+ *
+ * The live entities are stored densely at the beginning of the component arrays. A slot maps a
+ * handle to the dense index of its entity, the dense index changes when another entity is
+ * despawned but the slot does not.
+ */
+struct ENT_EntityStore
+{
+    double *components[NUMBER_OF_COMPONENTS]; /**< The component arrays, indexed by the dense index */
+    const struct OBJ_Object **objects; /**< The objects of the entities, indexed by the dense index */
+    int *slots; /**< The slot of each entity, indexed by the dense index */
+    int *dense_indices; /**< The dense index of the entity in each slot, FREE_SLOT if the slot is free */
+    unsigned int *generations; /**< The generation of each slot, incremented when its entity is despawned */
+    int *free_slots; /**< Stack of free slots */
+    int number_of_free_slots; /**< Number of slots in free_slots */
+    int length; /**< Number of live entities */
+    int capacity; /**< The maximum number of live entities */
+};
+
+/**
+ * \brief Update the positions of entities in a range from their paths
+ *
+ * \param[in,out] store The entity store
+ * \param[in] begin The dense index of the first entity
+ * \param[in] end The dense index after the last entity
+ */
+static void update_positions(
+    const struct ENT_EntityStore *const store,
+    const int begin,
+    const int end)
+{
+    const double *const center_x = store->components[PATH_CENTER_X];
+    const double *const center_y = store->components[PATH_CENTER_Y];
+    const double *const center_z = store->components[PATH_CENTER_Z];
+    const double *const radius = store->components[PATH_RADIUS];
+    const double *const angle = store->components[PATH_ANGLE];
+    double *const x = store->components[POSITION_X];
+    double *const y = store->components[POSITION_Y];
+    double *const z = store->components[POSITION_Z];
+
+    for (int i = begin; i < end; ++i)
+    {
+        x[i] = center_x[i] + (radius[i] * cos(angle[i]));
+        y[i] = center_y[i];
+        z[i] = center_z[i] + (radius[i] * sin(angle[i]));
+    }
+}
+
+/**
+ * \brief Integrate a component array with the constant rate of another component array
+ *
+ * \param[in,out] values The component array to integrate
+ * \param[in] rates The rates of change [1 / s]
+ * \param[in] length The number of entities
+ * \param[in] time_step The time step [s]
+ */
+static void integrate(
+    double *const values,
+    const double *const rates,
+    const int length,
+    const double time_step)
+{
+    for (int i = 0; i < length; ++i)
+    {
+        values[i] += rates[i] * time_step;
+    }
+}
+
+/**
+ * \brief Save the rotations and positions of entities in a range as their previous values
+ *
+ * \param[in,out] store The entity store
+ * \param[in] begin The dense index of the first entity
+ * \param[in] end The dense index after the last entity
+ */
+static void save_previous_state(
+    const struct ENT_EntityStore *const store,
+    const int begin,
+    const int end)
+{
+    for (int i = 0; i < NUMBER_OF_INTERPOLATED_COMPONENTS; ++i)
+    {
+        memcpy(
+            &store->components[PREVIOUS_ROTATION_PITCH + i][begin],
+            &store->components[ROTATION_PITCH + i][begin],
+            (size_t)(end - begin) * sizeof(*store->components[i]));
+    }
+}
+
+/**
+ * \brief Interpolate a component between its previous and current value
+ *
+ * \param[in] store The entity store
+ * \param[in] component The current value component, its previous value component must be
+ *                      NUMBER_OF_INTERPOLATED_COMPONENTS components later
+ * \param[in] index The dense index of the entity
+ * \param[in] interpolation The interpolation factor, 0 gives the previous and 1 the current value
+ *
+ * \return The interpolated value
+ */
+static double interpolate(
+    const struct ENT_EntityStore *const store,
+    const enum Component component,
+    const int index,
+    const double interpolation)
+{
+    const double previous = store->components[component + NUMBER_OF_INTERPOLATED_COMPONENTS][index];
+    const double current = store->components[component][index];
+
+    return previous + (interpolation * (current - previous));
+}
+
+struct ENT_EntityStore * ENT_create(
+    const int capacity)
+{
+    assert(capacity > 0); // LCOV_EXCL_LINE
+
+    struct ENT_EntityStore *const store = calloc(1, sizeof(*store));
+
+    for (int i = 0; i < NUMBER_OF_COMPONENTS; ++i)
+    {
+        store->components[i] = calloc((size_t)capacity, sizeof(*store->components[i]));
+    }
+
+    store->objects = calloc((size_t)capacity, sizeof(*store->objects));
+    store->slots = calloc((size_t)capacity, sizeof(*store->slots));
+    store->dense_indices = calloc((size_t)capacity, sizeof(*store->dense_indices));
+    store->generations = calloc((size_t)capacity, sizeof(*store->generations));
+    store->free_slots = calloc((size_t)capacity, sizeof(*store->free_slots));
+    store->capacity = capacity;
+
+    /* Hand out the slots in increasing order. */
+    for (int i = 0; i < capacity; ++i)
+    {
+        store->dense_indices[i] = FREE_SLOT;
+        store->free_slots[i] = capacity - 1 - i;
+    }
+
+    store->number_of_free_slots = capacity;
+
+    return store;
+}
+
+void ENT_destroy(
+    struct ENT_EntityStore *const store)
+{
+    free(store->free_slots);
+    free(store->generations);
+    free(store->dense_indices);
+    free(store->slots);
+    free(store->objects);
+
+    for (int i = 0; i < NUMBER_OF_COMPONENTS; ++i)
+    {
+        free(store->components[i]);
+    }
+
+    free(store);
+}
+
+int ENT_spawn(
+    struct ENT_EntityStore *const store,
+    const struct ENT_Entity *const entity,
+    struct ENT_Handle *const handle)
+{
+    if (store->number_of_free_slots == 0)
+    {
+        return 0;
+    }
+
+    const int slot = store->free_slots[--store->number_of_free_slots];
+    const int dense_index = store->length++;
+
+    store->slots[dense_index] = slot;
+    store->dense_indices[slot] = dense_index;
+    store->objects[dense_index] = entity->object;
+
+    double *const *const components = store->components;
+    components[PATH_CENTER_X][dense_index] = entity->path_center.x;
+    components[PATH_CENTER_Y][dense_index] = entity->path_center.y;
+    components[PATH_CENTER_Z][dense_index] = entity->path_center.z;
+    components[PATH_RADIUS][dense_index] = entity->path_radius;
+    components[PATH_ANGLE][dense_index] = entity->path_angle;
+    components[PATH_ANGULAR_VELOCITY][dense_index] = entity->path_angular_velocity;
+    components[ROTATION_PITCH][dense_index] = entity->rotation.pitch;
+    components[ROTATION_YAW][dense_index] = entity->rotation.yaw;
+    components[ROTATION_ROLL][dense_index] = entity->rotation.roll;
+    components[ANGULAR_VELOCITY_PITCH][dense_index] = entity->angular_velocity.pitch;
+    components[ANGULAR_VELOCITY_YAW][dense_index] = entity->angular_velocity.yaw;
+    components[ANGULAR_VELOCITY_ROLL][dense_index] = entity->angular_velocity.roll;
+    update_positions(store, dense_index, dense_index + 1);
+    save_previous_state(store, dense_index, dense_index + 1);
+
+    handle->index = slot;
+    handle->generation = store->generations[slot];
+
+    return 1;
+}
+
+void ENT_despawn(
+    struct ENT_EntityStore *const store,
+    const struct ENT_Handle *const handle)
+{
+    if (!ENT_is_alive(store, handle))
+    {
+        return;
+    }
+
+    /* Move the last entity to the despawned entity to keep the live entities dense. */
+    const int dense_index = store->dense_indices[handle->index];
+    const int last = --store->length;
+
+    for (int i = 0; i < NUMBER_OF_COMPONENTS; ++i)
+    {
+        store->components[i][dense_index] = store->components[i][last];
+    }
+
+    store->objects[dense_index] = store->objects[last];
+    store->slots[dense_index] = store->slots[last];
+    store->dense_indices[store->slots[dense_index]] = dense_index;
+
+    store->dense_indices[handle->index] = FREE_SLOT;
+    ++store->generations[handle->index];
+    store->free_slots[store->number_of_free_slots++] = handle->index;
+}
+
+int ENT_is_alive(
+    const struct ENT_EntityStore *const store,
+    const struct ENT_Handle *const handle)
+{
+    return (handle->index >= 0) &&
+        (handle->index < store->capacity) &&
+        (store->dense_indices[handle->index] != FREE_SLOT) &&
+        (store->generations[handle->index] == handle->generation);
+}
+
+void ENT_get(
+    const struct ENT_EntityStore *const store,
+    const struct ENT_Handle *const handle,
+    struct ENT_Entity *const entity)
+{
+    assert(ENT_is_alive(store, handle)); // LCOV_EXCL_LINE
+
+    const int i = store->dense_indices[handle->index];
+    double *const *const components = store->components;
+
+    entity->object = store->objects[i];
+    entity->path_center.x = components[PATH_CENTER_X][i];
+    entity->path_center.y = components[PATH_CENTER_Y][i];
+    entity->path_center.z = components[PATH_CENTER_Z][i];
+    entity->path_radius = components[PATH_RADIUS][i];
+    entity->path_angle = components[PATH_ANGLE][i];
+    entity->path_angular_velocity = components[PATH_ANGULAR_VELOCITY][i];
+    entity->rotation.pitch = components[ROTATION_PITCH][i];
+    entity->rotation.yaw = components[ROTATION_YAW][i];
+    entity->rotation.roll = components[ROTATION_ROLL][i];
+    entity->angular_velocity.pitch = components[ANGULAR_VELOCITY_PITCH][i];
+    entity->angular_velocity.yaw = components[ANGULAR_VELOCITY_YAW][i];
+    entity->angular_velocity.roll = components[ANGULAR_VELOCITY_ROLL][i];
+}
+
+void ENT_get_position(
+    const struct ENT_EntityStore *const store,
+    const struct ENT_Handle *const handle,
+    struct COORD_Coordinate3D *const position)
+{
+    assert(ENT_is_alive(store, handle)); // LCOV_EXCL_LINE
+
+    const int i = store->dense_indices[handle->index];
+
+    position->x = store->components[POSITION_X][i];
+    position->y = store->components[POSITION_Y][i];
+    position->z = store->components[POSITION_Z][i];
+}
+
+int ENT_get_length(
+    const struct ENT_EntityStore *const store)
+{
+    return store->length;
+}
+
+void ENT_update(
+    struct ENT_EntityStore *const store,
+    const double time_step)
+{
+    double *const *const components = store->components;
+
+    save_previous_state(store, 0, store->length);
+
+    /* Rotation system */
+    integrate(components[ROTATION_PITCH], components[ANGULAR_VELOCITY_PITCH], store->length, time_step);
+    integrate(components[ROTATION_YAW], components[ANGULAR_VELOCITY_YAW], store->length, time_step);
+    integrate(components[ROTATION_ROLL], components[ANGULAR_VELOCITY_ROLL], store->length, time_step);
+
+    /* Path system */
+    integrate(components[PATH_ANGLE], components[PATH_ANGULAR_VELOCITY], store->length, time_step);
+    update_positions(store, 0, store->length);
+}
+
+void ENT_get_objects(
+    const struct ENT_EntityStore *const store,
+    const double interpolation,
+    struct REND_ObjectWithPosition *const objects)
+{
+    for (int i = 0; i < store->length; ++i)
+    {
+        struct REND_ObjectWithPosition *const object = &objects[i];
+
+        object->object = store->objects[i];
+        object->point_source = NULL;
+        object->mesh = NULL;
+        object->compressed_object = NULL;
+        object->position.x = interpolate(store, POSITION_X, i, interpolation);
+        object->position.y = interpolate(store, POSITION_Y, i, interpolation);
+        object->position.z = interpolate(store, POSITION_Z, i, interpolation);
+        object->rotation.pitch = interpolate(store, ROTATION_PITCH, i, interpolation);
+        object->rotation.yaw = interpolate(store, ROTATION_YAW, i, interpolation);
+        object->rotation.roll = interpolate(store, ROTATION_ROLL, i, interpolation);
+        object->rotation_matrix = NULL;
+        object->is_static = 0;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \brief Entity store interface
+ *
+ * Data oriented storage of the game entities. The components of the entities are stored as
+ * structure of arrays, packed so that the live entities are at the beginning of the arrays, and
+ * the systems update entire component arrays at a time. Entities are referenced by generational
+ * handles, a handle becomes invalid when its entity is despawned even if the storage is reused by
+ * a later entity. All storage is allocated when the store is created, spawning and despawning
+ * entities is O(1).
+ *
+ * Each entity moves along a circular path in the xz-plane around a center, entities with a zero
+ * path radius stay at the center, and rotates with a constant angular velocity.
+ */
+#ifndef GAME_ENTITIES_H
+#define GAME_ENTITIES_H
+
+#include <Base/coordinates.h>
+#include <Engine/coordinate_system_transformations.h>
+
+struct OBJ_Object;
+struct REND_ObjectWithPosition;
+
+struct ENT_EntityStore;
+
+/**
+ * \brief Handle of an entity
+ */
+struct ENT_Handle
+{
+    int index; /**< The storage slot of the entity */
+    unsigned int generation; /**< The generation of the slot when the entity was spawned */
+};
+
+/**
+ * \brief The components of an entity
+ */
+struct ENT_Entity
+{
+    const struct OBJ_Object *object; /**< The object to draw */
+    struct COORD_Coordinate3D path_center; /**< The center of the circular path */
+    double path_radius; /**< The radius of the circular path */
+    double path_angle; /**< The angle of the entity on the path [radians] */
+    double path_angular_velocity; /**< The angular velocity along the path [radians / s] */
+    struct CST_Rotation3D rotation; /**< The rotation of the entity */
+    struct CST_Rotation3D angular_velocity; /**< The angular velocity of the rotation [radians / s] */
+};
+
+/**
+ * \brief Create an entity store
+ *
+ * \param[in] capacity The maximum number of live entities
+ *
+ * \return Entity store
+ */
+struct ENT_EntityStore * ENT_create(
+    int capacity);
+
+/**
+ * \brief Destroy an entity store
+ *
+ * \param[in] store The entity store to destroy, do not use it anymore
+ */
+void ENT_destroy(
+    struct ENT_EntityStore *store);
+
+/**
+ * \brief Spawn an entity
+ *
+ * \param[in,out] store The entity store
+ * \param[in] entity The initial components of the entity
+ * \param[out] handle The handle of the entity, only set if the entity was spawned
+ *
+ * \return Non-zero if the entity was spawned, zero if the store is full
+ */
+int ENT_spawn(
+    struct ENT_EntityStore *store,
+    const struct ENT_Entity *entity,
+    struct ENT_Handle *handle);
+
+/**
+ * \brief Despawn an entity, the handle (and copies of it) becomes invalid
+ *
+ * \param[in,out] store The entity store
+ * \param[in] handle The handle of the entity, nothing happens if it is already invalid
+ */
+void ENT_despawn(
+    struct ENT_EntityStore *store,
+    const struct ENT_Handle *handle);
+
+/**
+ * \brief Check if a handle refers to a live entity
+ *
+ * \param[in] store The entity store
+ * \param[in] handle The handle
+ *
+ * \return Non-zero if the entity is alive
+ */
+int ENT_is_alive(
+    const struct ENT_EntityStore *store,
+    const struct ENT_Handle *handle);
+
+/**
+ * \brief Get the components of an entity
+ *
+ * \param[in] store The entity store
+ * \param[in] handle The handle of a live entity
+ * \param[out] entity The components of the entity
+ */
+void ENT_get(
+    const struct ENT_EntityStore *store,
+    const struct ENT_Handle *handle,
+    struct ENT_Entity *entity);
+
+/**
+ * \brief Get the position of an entity
+ *
+ * \param[in] store The entity store
+ * \param[in] handle The handle of a live entity
+ * \param[out] position The position of the entity in the world
+ */
+void ENT_get_position(
+    const struct ENT_EntityStore *store,
+    const struct ENT_Handle *handle,
+    struct COORD_Coordinate3D *position);
+
+/**
+ * \brief Get the number of live entities
+ *
+ * \param[in] store The entity store
+ *
+ * \return Number of live entities
+ */
+int ENT_get_length(
+    const struct ENT_EntityStore *store);
+
+/**
+ * \brief Advance all entities in time, i.e. run all systems
+ *
+ * \param[in,out] store The entity store
+ * \param[in] time_step The time step [s]
+ */
+void ENT_update(
+    struct ENT_EntityStore *store,
+    double time_step);
+
+/**
+ * \brief Get the live entities as objects to render
+ *
+ * The positions and rotations are interpolated between the state before and after the last
+ * update, which makes it possible to render at another rate than the entities are updated.
+ *
+ * \param[in] store The entity store
+ * \param[in] interpolation The time since the last update as a fraction of its time step [0, 1],
+ *                          1 gives the state after the last update
+ * \param[out] objects The objects, must fit ENT_get_length() objects
+ */
+void ENT_get_objects(
+    const struct ENT_EntityStore *store,
+    double interpolation,
+    struct REND_ObjectWithPosition *objects);
+
+#endif /* GAME_ENTITIES_H */
@@ -2,17 +2,34 @@
  * \file
  * \brief Game implementation
  */
+#include "entities.h"
 #include "Objects/sphere.h"
 #include "Objects/torus.h"
 
 #include <Base/common.h>
 #include <Base/coordinates.h>
+#include <Base/parallel.h>
+#include <Base/triple_buffer.h>
 #include <Engine/camera.h>
+#include <Engine/compositor.h>
 #include <Engine/coordinate_system_transformations.h>
+#include <Engine/frame_recording.h>
+#include <Engine/frame_sink.h>
+#include <Engine/image_sequence.h>
+#include <Engine/object_cache.h>
+#include <Engine/object_optimization.h>
 #include <Engine/renderer.h>
 #include <Game/game.h>
 
+#include <assert.h>
 #include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 
 /* Compensate for the difference in width and height for terminal characters by setting different
  * pixel size in the x and y direction. */
@@ -21,17 +38,251 @@
 #define FOCAL_LENGTH (1.0)
 #define SCREEN_WIDTH (100)
 #define SCREEN_HEIGHT (50)
+#define OBJECT_RESOLUTION (0.1) /* Radians, sparse since the points are rendered as splats */
+/* Points closer than this fraction of the point spacing (resolution * radius) are welded. */
+#define WELD_TOLERANCE (0.25)
+/* Environment variable specifying the object cache directory, the cache is disabled if not set. */
+#define OBJECT_CACHE_ENVIRONMENT_VARIABLE ("GAME_OBJECT_CACHE")
+/* Environment variable specifying the name of the shared memory frame sink the shown frames are
+ * published to, no frame sink is used if not set. */
+#define FRAME_SINK_ENVIRONMENT_VARIABLE ("GAME_FRAME_SINK")
+#define FRAME_SINK_SLOTS (16)
+/* Environment variable specifying the path of a frame recording the shown frames are recorded to,
+ * no recording is made if not set. */
+#define RECORDING_ENVIRONMENT_VARIABLE ("GAME_RECORDING")
+#define MAX_NUMBER_OF_ENTITIES (16)
+/* The maximum number of simulation steps per frame, simulation time is dropped if the simulation
+ * falls further behind. Avoids that slow simulation steps make the simulation fall further and
+ * further behind. */
+#define MAX_SIMULATION_STEPS_PER_FRAME (10)
+/* The depth written as the darkest gray in depth images, the scene is within a few units of the camera. */
+#define OFFLINE_MAX_DEPTH (6.0)
+#define RENDER_TASK (0) /* Task index of the rendering when running threaded */
+#define SIMULATION_TASK (1) /* Task index of the simulation when running threaded */
 
-enum
+/**
+ * \brief The outputs the shown frames are published to in addition to the terminal
+ */
+struct FrameOutputs
 {
-    SPHERE,
-    TORUS,
-    NUMBER_OF_OBJECTS
+    struct FSINK_FrameSink *frame_sink; /**< The frame sink, may be NULL */
+    struct FREC_Recorder *recorder; /**< The frame recording, may be NULL */
 };
 
-void GAME_run(
+/**
+ * \brief The objects of a game, read-only once created so several games may share them
+ */
+struct GameObjects
+{
+    struct OBJC_CachedObject *sphere; /**< The sphere object */
+    struct OBJC_CachedObject *torus; /**< The torus object */
+};
+
+/**
+ * \brief A running game
+ */
+struct Game
+{
+    struct ENT_EntityStore *entities; /**< The entities of the game */
+    struct REND_Renderer *renderer; /**< The renderer */
+    struct FrameOutputs outputs; /**< The outputs the shown frames are published to */
+    struct COORD_Coordinate3D light_source; /**< The position of the light source */
+    struct REND_ObjectWithPosition objects[MAX_NUMBER_OF_ENTITIES]; /**< Buffer for the objects to render */
+};
+
+/**
+ * \brief Snapshot of the entities published by the simulation thread
+ */
+struct Snapshot
+{
+    int length; /**< Number of objects */
+    struct REND_ObjectWithPosition objects[MAX_NUMBER_OF_ENTITIES]; /**< The objects to render */
+};
+
+/**
+ * \brief A game running the simulation and the rendering in separate threads
+ *
+ * The simulation thread owns the entities and the rendering thread owns the renderer, they only
+ * share the snapshots.
+ */
+struct ThreadedGame
+{
+    struct Game game; /**< The game */
+    struct TB_TripleBuffer *snapshots; /**< Snapshots of struct Snapshot */
+    double time_step; /**< The simulation time step [s] */
+    int frames; /**< The number of frames to render */
+    atomic_int is_done; /**< Set when all frames are rendered */
+};
+
+/**
+ * \brief A game rendered offline by several threads, see GAME_render_offline()
+ */
+struct OfflineRendering
+{
+    const char *directory; /**< The directory the images are written to */
+    enum IMGS_Format format; /**< What is written of each frame */
+    double fps; /**< The frame rate of the rendered sequence [frames / s] */
+    int frames; /**< The number of frames to render */
+    int number_of_threads; /**< The number of threads rendering */
+    const struct GameObjects *objects; /**< The objects shared by the threads */
+    atomic_int has_failed; /**< Set when an image could not be written */
+};
+
+/**
+ * \brief Create a sphere, see SPHERE_create()
+ *
+ * Coincident points (e.g. at the poles) are welded and the remaining points are sorted in Morton
+ * order to make rendering cache friendly.
+ *
+ * \param[in] parameters The radius, resolution and weld tolerance (see WELD_TOLERANCE)
+ *
+ * \return Sphere
+ */
+static struct OBJ_Object * create_sphere(
+    const double parameters[])
+{
+    struct OBJ_Object *const sphere = SPHERE_create(parameters[0], parameters[1]);
+
+    OBJOPT_weld(sphere, parameters[2] * parameters[1] * parameters[0]);
+    OBJOPT_sort_morton(sphere);
+
+    return sphere;
+}
+
+/**
+ * \brief Create a torus, see TORUS_create()
+ *
+ * Coincident points are welded and the remaining points are sorted in Morton order to make
+ * rendering cache friendly.
+ *
+ * \param[in] parameters The inner radius, outer radius, resolution and weld tolerance (see WELD_TOLERANCE)
+ *
+ * \return Torus
+ */
+static struct OBJ_Object * create_torus(
+    const double parameters[])
+{
+    struct OBJ_Object *const torus = TORUS_create(parameters[0], parameters[1], parameters[2]);
+
+    OBJOPT_weld(torus, parameters[3] * parameters[2] * parameters[0]);
+    OBJOPT_sort_morton(torus);
+
+    return torus;
+}
+
+/**
+ * \brief Create the frame outputs given by the environment
+ *
+ * \param[out] outputs The outputs, an output is NULL if it is not given or if it could not be created
+ */
+static void create_frame_outputs(
+    struct FrameOutputs *const outputs)
+{
+    const char *const name = getenv(FRAME_SINK_ENVIRONMENT_VARIABLE);
+    const char *const path = getenv(RECORDING_ENVIRONMENT_VARIABLE);
+
+    outputs->frame_sink =
+        (name == NULL) ? NULL : FSINK_create(name, SCREEN_WIDTH, SCREEN_HEIGHT, FRAME_SINK_SLOTS, 1);
+    outputs->recorder = (path == NULL) ? NULL : FREC_create(path, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+/**
+ * \brief Destroy the frame outputs
+ *
+ * \param[in,out] outputs The outputs, do not use them anymore
+ */
+static void destroy_frame_outputs(
+    struct FrameOutputs *const outputs)
+{
+    if (outputs->recorder != NULL)
+    {
+        FREC_destroy(outputs->recorder);
+    }
+
+    if (outputs->frame_sink != NULL)
+    {
+        FSINK_destroy(outputs->frame_sink);
+    }
+}
+
+/**
+ * \brief Publish a shown frame to the frame outputs
+ *
+ * \param[in,out] outputs The outputs
+ * \param[in] frame_buffer The frame buffer
+ * \param[in] z_buffer The z buffer
+ */
+static void publish_frame(
+    struct FrameOutputs *const outputs,
+    const struct MAT_Matrix *const frame_buffer,
+    const struct MAT_Matrix *const z_buffer)
+{
+    if (outputs->frame_sink != NULL)
+    {
+        FSINK_write_frame(outputs->frame_sink, frame_buffer, z_buffer);
+    }
+
+    if (outputs->recorder != NULL)
+    {
+        FREC_record_frame(outputs->recorder, frame_buffer);
+    }
+}
+
+/**
+ * \brief Create the objects of the game, from the object cache if it is enabled
+ *
+ * \param[out] objects The objects
+ */
+static void create_game_objects(
+    struct GameObjects *const objects)
+{
+    const char *const cache_directory = getenv(OBJECT_CACHE_ENVIRONMENT_VARIABLE);
+
+    /* The weld tolerance is a parameter so that objects cached with another tolerance are not used */
+    const double sphere_parameters[] = {0.2, OBJECT_RESOLUTION, WELD_TOLERANCE};
+    objects->sphere = OBJC_get(
+        cache_directory,
+        "sphere_welded_morton",
+        sphere_parameters,
+        LENGTH(sphere_parameters),
+        create_sphere,
+        SPHERE_free);
+
+    const double torus_parameters[] = {0.15, 0.4, OBJECT_RESOLUTION, WELD_TOLERANCE};
+    objects->torus = OBJC_get(
+        cache_directory,
+        "torus_welded_morton",
+        torus_parameters,
+        LENGTH(torus_parameters),
+        create_torus,
+        TORUS_free);
+}
+
+/**
+ * \brief Destroy the objects of the game
+ *
+ * \param[in,out] objects The objects, no game may use them anymore
+ */
+static void destroy_game_objects(
+    struct GameObjects *const objects)
+{
+    OBJC_release(objects->torus);
+    OBJC_release(objects->sphere);
+}
+
+/**
+ * \brief Create the game, i.e. the entities and the renderer
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] shows_frames Non-zero if the game shows its frames, only then are the frame outputs created
+ * \param[in] objects The objects of the game, see create_game_objects(), must outlive the game
+ * \param[out] game The game
+ */
+static void create_game(
     const double fps,
-    const int steps)
+    const int shows_frames,
+    const struct GameObjects *const objects,
+    struct Game *const game)
 {
     const struct COORD_Coordinate2D optical_center = {
         .x = SCREEN_WIDTH / 2.0,
@@ -60,71 +311,570 @@ void GAME_run(
         &camera_rotation,
         &calibration);
 
-    const struct COORD_Coordinate3D light_source = {
-        .x = -1.0,
-        .y = 1.0,
-        .z = 1.0
-    };
-
-    struct OBJ_Object *const sphere = SPHERE_create(0.2);
+    game->light_source.x = -1.0;
+    game->light_source.y = 1.0;
+    game->light_source.z = 1.0;
 
-    struct OBJ_Object *const torus = TORUS_create(0.15, 0.4);
-
-    const struct COORD_Coordinate3D initial_position = {
+    const struct COORD_Coordinate3D center = {
         .x = 0.0,
         .y = 0.0,
         .z = 3.0
     };
 
-    const struct CST_Rotation3D initial_rotation = {
-        .pitch = 0.0,
-        .yaw = 0.0,
-        .roll = 0.0
-    };
+    game->entities = ENT_create(MAX_NUMBER_OF_ENTITIES);
 
-    const double circle_angular_velocity = 1.2 / fps;
+    /* A sphere orbiting a rotating torus */
+    const struct ENT_Entity sphere_entity = {
+        .object = OBJC_get_object(objects->sphere),
+        .path_center = center,
+        .path_radius = 1.0,
+        .path_angle = 0.0,
+        .path_angular_velocity = 1.2,
+        .rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0},
+        .angular_velocity = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0}
+    };
 
-    const struct CST_Rotation3D torus_angular_velocity = {
-        .pitch = 0.8 / fps,
-        .yaw = 0.4 / fps,
-        .roll = 0.0 / fps
+    const struct ENT_Entity torus_entity = {
+        .object = OBJC_get_object(objects->torus),
+        .path_center = center,
+        .path_radius = 0.0,
+        .path_angle = 0.0,
+        .path_angular_velocity = 0.0,
+        .rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0},
+        .angular_velocity = {.pitch = 0.8, .yaw = 0.4, .roll = 0.0}
     };
 
-    struct REND_ObjectWithPosition objects[NUMBER_OF_OBJECTS];
+    struct ENT_Handle handle;
+    ENT_spawn(game->entities, &sphere_entity, &handle);
+    ENT_spawn(game->entities, &torus_entity, &handle);
 
-    objects[SPHERE].object = sphere;
-    objects[SPHERE].position = initial_position;
-    objects[SPHERE].rotation = initial_rotation;
+    game->renderer = REND_create(&calibration, SCREEN_WIDTH, SCREEN_HEIGHT, fps);
+    game->outputs.frame_sink = NULL;
+    game->outputs.recorder = NULL;
+
+    if (shows_frames)
+    {
+        create_frame_outputs(&game->outputs);
+    }
+}
+
+/**
+ * \brief Destroy the game
+ *
+ * \param[in,out] game The game, do not use it anymore
+ */
+static void destroy_game(
+    struct Game *const game)
+{
+    destroy_frame_outputs(&game->outputs);
+    ENT_destroy(game->entities);
+    REND_destroy(game->renderer);
+}
 
-    objects[TORUS].object = torus;
-    objects[TORUS].position = initial_position;
-    objects[TORUS].rotation = initial_rotation;
+/**
+ * \brief Render a frame of the game
+ *
+ * \param[in,out] game The game
+ * \param[in] interpolation The time since the last simulation step as a fraction of the time step,
+ *                          see ENT_get_objects()
+ */
+static void render_game(
+    struct Game *const game,
+    const double interpolation)
+{
+    ENT_get_objects(game->entities, interpolation, game->objects);
 
-    struct REND_Objects model = {
-        .objects = &objects[0],
-        .length = LENGTH(objects)
+    const struct REND_Objects model = {
+        .objects = &game->objects[0],
+        .length = ENT_get_length(game->entities)
     };
 
-    struct REND_Renderer *const renderer = REND_create(&calibration, SCREEN_WIDTH, SCREEN_HEIGHT, fps);
+    REND_render(game->renderer, &game->light_source, &model);
+    publish_frame(&game->outputs, REND_get_frame_buffer(game->renderer), REND_get_z_buffer(game->renderer));
+}
 
-    const double sphere_path_radius = 1.0;
-    double sphere_path_radius_angle = 0.0;
+/**
+ * \brief Get the time between two points in time
+ *
+ * \param[in] begin The first point in time
+ * \param[in] end The second point in time
+ *
+ * \return The elapsed time [s]
+ */
+static double get_elapsed_time(
+    const struct timespec *const begin,
+    const struct timespec *const end)
+{
+    return (double)(end->tv_sec - begin->tv_sec) + ((double)(end->tv_nsec - begin->tv_nsec) * 1e-9);
+}
+
+/**
+ * \brief Add time to a point in time
+ *
+ * \param[in] time The time to add [s]
+ * \param[in,out] point_in_time The point in time
+ */
+static void add_time(
+    const double time,
+    struct timespec *const point_in_time)
+{
+    const long long nanoseconds = point_in_time->tv_nsec + (long long)(time * 1e9);
+
+    point_in_time->tv_sec += (time_t)(nanoseconds / 1000000000LL);
+    point_in_time->tv_nsec = (long)(nanoseconds % 1000000000LL);
+}
+
+/**
+ * \brief Publish the current state of the entities as the latest snapshot
+ *
+ * \param[in,out] threaded_game The game
+ */
+static void publish_snapshot(
+    struct ThreadedGame *const threaded_game)
+{
+    struct Snapshot *const snapshot = TB_get_write_buffer(threaded_game->snapshots);
+
+    snapshot->length = ENT_get_length(threaded_game->game.entities);
+    ENT_get_objects(threaded_game->game.entities, 1.0, snapshot->objects);
+
+    TB_publish(threaded_game->snapshots);
+}
+
+/**
+ * \brief Render the latest snapshot each frame until all frames are rendered
+ *
+ * \param[in,out] threaded_game The game
+ */
+static void run_rendering(
+    struct ThreadedGame *const threaded_game)
+{
+    for (int i = 0; i < threaded_game->frames; ++i)
+    {
+        const struct Snapshot *const snapshot = TB_read(threaded_game->snapshots);
+        const struct REND_Objects model = {
+            .objects = &snapshot->objects[0],
+            .length = snapshot->length
+        };
+
+        REND_render(threaded_game->game.renderer, &threaded_game->game.light_source, &model);
+        publish_frame(
+            &threaded_game->game.outputs,
+            REND_get_frame_buffer(threaded_game->game.renderer),
+            REND_get_z_buffer(threaded_game->game.renderer));
+    }
+
+    atomic_store(&threaded_game->is_done, 1);
+}
+
+/**
+ * \brief Advance the simulation with fixed time steps in real time until all frames are rendered
+ *
+ * \param[in,out] threaded_game The game
+ */
+static void run_simulation(
+    struct ThreadedGame *const threaded_game)
+{
+    struct timespec next_step_time;
+    clock_gettime(CLOCK_MONOTONIC, &next_step_time);
+
+    while (!atomic_load(&threaded_game->is_done))
+    {
+        ENT_update(threaded_game->game.entities, threaded_game->time_step);
+        publish_snapshot(threaded_game);
+
+        add_time(threaded_game->time_step, &next_step_time);
+
+        /* Drop simulation time rather than running a burst of steps if the simulation has fallen
+         * far behind. */
+        struct timespec current_time;
+        clock_gettime(CLOCK_MONOTONIC, &current_time);
+        if (get_elapsed_time(&next_step_time, &current_time) >
+            MAX_SIMULATION_STEPS_PER_FRAME * threaded_game->time_step)
+        {
+            next_step_time = current_time;
+        }
+
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_step_time, NULL);
+    }
+}
+
+/**
+ * \brief Task running either the rendering or the simulation, see PAR_run()
+ *
+ * \param[in,out] context The game (struct ThreadedGame)
+ * \param[in] index RENDER_TASK or SIMULATION_TASK
+ */
+static void run_threaded_game_task(
+    void *const context,
+    const int index)
+{
+    struct ThreadedGame *const threaded_game = context;
+
+    if (index == RENDER_TASK)
+    {
+        run_rendering(threaded_game);
+    }
+    else
+    {
+        run_simulation(threaded_game);
+    }
+}
+
+/**
+ * \brief Render every number_of_threads:th frame of the game offline, see PAR_run()
+ *
+ * \param[in,out] context The offline rendering (struct OfflineRendering)
+ * \param[in] index The index of the thread, i.e. of its first frame
+ */
+static void run_offline_rendering_task(
+    void *const context,
+    const int index)
+{
+    struct OfflineRendering *const rendering = context;
+    struct Game game;
+    create_game(rendering->fps, 0, rendering->objects, &game);
+
+    struct IMGS_Writer *const writer = IMGS_create(
+        rendering->directory, rendering->format, SCREEN_WIDTH, SCREEN_HEIGHT, OFFLINE_MAX_DEPTH);
+
+    /* The state of frame i is the state after i simulation steps */
+    for (int i = 0; i < index; ++i)
+    {
+        ENT_update(game.entities, 1.0 / rendering->fps);
+    }
+
+    for (int i = index; i < rendering->frames; i += rendering->number_of_threads)
+    {
+        if (atomic_load(&rendering->has_failed))
+        {
+            break;
+        }
+
+        ENT_get_objects(game.entities, 1.0, game.objects);
+
+        const struct REND_Objects model = {
+            .objects = &game.objects[0],
+            .length = ENT_get_length(game.entities)
+        };
+
+        REND_render_frame(game.renderer, &game.light_source, &model);
+
+        if (IMGS_write_frame(writer, i, REND_get_frame_buffer(game.renderer), REND_get_z_buffer(game.renderer)) != 0)
+        {
+            atomic_store(&rendering->has_failed, 1);
+        }
+
+        for (int j = 0; j < rendering->number_of_threads; ++j)
+        {
+            ENT_update(game.entities, 1.0 / rendering->fps);
+        }
+    }
+
+    IMGS_destroy(writer);
+    destroy_game(&game);
+}
+
+/**
+ * \brief Run a worker of the sort-last game, renders its partition of the objects each frame and
+ *        sends the frame to the compositor
+ *
+ * The worker runs its own copy of the simulation, which is advanced one step per frame exactly as
+ * in the other workers.
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] frames The number of frames to render
+ * \param[in] worker The index of the worker
+ * \param[in] number_of_workers The number of workers
+ * \param[in] socket The socket connected to the compositor
+ */
+static void run_worker(
+    const double fps,
+    const int frames,
+    const int worker,
+    const int number_of_workers,
+    const int socket)
+{
+    struct GameObjects objects;
+    create_game_objects(&objects);
+    struct Game game;
+    create_game(fps, 0, &objects, &game);
+
+    struct COMP_Compositor *const compositor = COMP_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (int i = 0; i < frames; ++i)
+    {
+        ENT_get_objects(game.entities, 1.0, game.objects);
+
+        const struct REND_Objects model = {
+            .objects = &game.objects[0],
+            .length = ENT_get_length(game.entities)
+        };
+        struct REND_Objects partition;
+
+        COMP_get_partition(&model, worker, number_of_workers, &partition);
+        REND_render_frame(game.renderer, &game.light_source, &partition);
+
+        if (COMP_send_frame(
+                compositor, socket, REND_get_frame_buffer(game.renderer), REND_get_z_buffer(game.renderer)) != 0)
+        {
+            break;
+        }
+
+        ENT_update(game.entities, 1.0 / fps);
+    }
+
+    COMP_destroy(compositor);
+    destroy_game(&game);
+    destroy_game_objects(&objects);
+}
+
+/**
+ * \brief Composite the frames of the workers and show them at the frame rate
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] frames The number of frames to show
+ * \param[in] sockets The sockets connected to the workers
+ * \param[in] number_of_workers The number of workers
+ */
+static void run_compositor(
+    const double fps,
+    const int frames,
+    const int *const sockets,
+    const int number_of_workers)
+{
+    struct COMP_Compositor *const compositor = COMP_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    struct FrameOutputs outputs;
+    create_frame_outputs(&outputs);
+    struct timespec next_frame_time;
+    clock_gettime(CLOCK_MONOTONIC, &next_frame_time);
+
+    for (int i = 0; i < frames; ++i)
+    {
+        if (COMP_composite(compositor, sockets, number_of_workers) != 0)
+        {
+            break;
+        }
+
+        REND_show_frame(COMP_get_frame_buffer(compositor));
+        publish_frame(&outputs, COMP_get_frame_buffer(compositor), COMP_get_z_buffer(compositor));
+
+        add_time(1.0 / fps, &next_frame_time);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_frame_time, NULL);
+    }
+
+    destroy_frame_outputs(&outputs);
+    COMP_destroy(compositor);
+}
+
+void GAME_run(
+    const double fps,
+    const int steps)
+{
+    struct GameObjects objects;
+    create_game_objects(&objects);
+    struct Game game;
+    create_game(fps, 1, &objects, &game);
 
     for (int i = 0; i < steps; ++i)
     {
-        model.objects[SPHERE].position.x = initial_position.x + (sphere_path_radius * cos(sphere_path_radius_angle));
-        model.objects[SPHERE].position.y = initial_position.y;
-        model.objects[SPHERE].position.z = initial_position.z + (sphere_path_radius * sin(sphere_path_radius_angle));
+        render_game(&game, 1.0);
+        ENT_update(game.entities, 1.0 / fps);
+    }
+
+    destroy_game(&game);
+    destroy_game_objects(&objects);
+}
+
+void GAME_run_fixed_timestep(
+    const double fps,
+    const double simulation_rate,
+    const int frames)
+{
+    assert(simulation_rate > 0.0); // LCOV_EXCL_LINE
 
-        REND_render(renderer, &light_source, &model);
+    const double time_step = 1.0 / simulation_rate;
+    double accumulated_time = 0.0;
 
-        model.objects[TORUS].rotation.pitch += torus_angular_velocity.pitch;
-        model.objects[TORUS].rotation.yaw += torus_angular_velocity.yaw;
-        model.objects[TORUS].rotation.roll += torus_angular_velocity.roll;
-        sphere_path_radius_angle += circle_angular_velocity;
+    struct GameObjects objects;
+    create_game_objects(&objects);
+    struct Game game;
+    create_game(fps, 1, &objects, &game);
+
+    struct timespec previous_time;
+    clock_gettime(CLOCK_MONOTONIC, &previous_time);
+
+    for (int i = 0; i < frames; ++i)
+    {
+        struct timespec current_time;
+        clock_gettime(CLOCK_MONOTONIC, &current_time);
+        accumulated_time += get_elapsed_time(&previous_time, &current_time);
+        accumulated_time = fmin(accumulated_time, MAX_SIMULATION_STEPS_PER_FRAME * time_step);
+        previous_time = current_time;
+
+        /* Run as many fixed steps as the real time that has passed, the remainder is carried over
+         * to the next frame. */
+        while (accumulated_time >= time_step)
+        {
+            ENT_update(game.entities, time_step);
+            accumulated_time -= time_step;
+        }
+
+        render_game(&game, accumulated_time / time_step);
+    }
+
+    destroy_game(&game);
+    destroy_game_objects(&objects);
+}
+
+void GAME_run_threaded(
+    const double fps,
+    const double simulation_rate,
+    const int frames)
+{
+    assert(simulation_rate > 0.0); // LCOV_EXCL_LINE
+
+    struct ThreadedGame threaded_game = {
+        .snapshots = TB_create(sizeof(struct Snapshot)),
+        .time_step = 1.0 / simulation_rate,
+        .frames = frames
+    };
+    atomic_init(&threaded_game.is_done, 0);
+
+    struct GameObjects objects;
+    create_game_objects(&objects);
+    create_game(fps, 1, &objects, &threaded_game.game);
+
+    /* The first frame is rendered from the initial state */
+    publish_snapshot(&threaded_game);
+
+    /* The calling thread renders and a new thread simulates. If the thread can not be created the
+     * simulation is started after the rendering and stops immediately, i.e. the game is frozen. */
+    PAR_run(run_threaded_game_task, &threaded_game, SIMULATION_TASK + 1);
+
+    destroy_game(&threaded_game.game);
+    destroy_game_objects(&objects);
+    TB_destroy(threaded_game.snapshots);
+}
+
+void GAME_run_sort_last(
+    const double fps,
+    const int frames,
+    const int number_of_workers)
+{
+    assert(number_of_workers > 0); // LCOV_EXCL_LINE
+
+    int *const sockets = calloc((size_t)number_of_workers, sizeof(*sockets));
+    pid_t *const workers = calloc((size_t)number_of_workers, sizeof(*workers));
+    int number_of_started_workers = 0;
+
+    while (number_of_started_workers < number_of_workers)
+    {
+        int socket_pair[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_pair) != 0)
+        {
+            break; // LCOV_EXCL_LINE
+        }
+
+        const pid_t worker = fork();
+
+        if (worker == 0)
+        {
+            /* The worker only keeps its own end of its own socket */
+            for (int i = 0; i < number_of_started_workers; ++i)
+            {
+                close(sockets[i]);
+            }
+            close(socket_pair[0]);
+
+            run_worker(fps, frames, number_of_started_workers, number_of_workers, socket_pair[1]);
+
+            close(socket_pair[1]);
+            _exit(EXIT_SUCCESS);
+        }
+
+        close(socket_pair[1]);
+
+        if (worker < 0)
+        {
+            close(socket_pair[0]); // LCOV_EXCL_LINE
+            break; // LCOV_EXCL_LINE
+        }
+
+        sockets[number_of_started_workers] = socket_pair[0];
+        workers[number_of_started_workers] = worker;
+        ++number_of_started_workers;
+    }
+
+    /* If not all workers could be started nothing is shown, closing the sockets stops the started
+     * workers. */
+    if (number_of_started_workers == number_of_workers)
+    {
+        run_compositor(fps, frames, sockets, number_of_workers);
+    }
+
+    for (int i = 0; i < number_of_started_workers; ++i)
+    {
+        close(sockets[i]);
+        waitpid(workers[i], NULL, 0);
+    }
+
+    free(workers);
+    free(sockets);
+}
+
+double GAME_render_offline(
+    const char *const directory,
+    const enum GAME_ImageFormat format,
+    const double fps,
+    const int frames,
+    const int number_of_threads)
+{
+    assert(number_of_threads > 0); // LCOV_EXCL_LINE
+
+    struct OfflineRendering rendering = {
+        .directory = directory,
+        .format = IMGS_DEPTH,
+        .fps = fps,
+        .frames = frames,
+        .number_of_threads = number_of_threads
+    };
+    atomic_init(&rendering.has_failed, 0);
+
+    /* The objects are only read while rendering, so they are created once and shared by the threads */
+    struct GameObjects objects;
+    create_game_objects(&objects);
+    rendering.objects = &objects;
+
+    switch (format)
+    {
+        case GAME_DEPTH_IMAGES:
+            rendering.format = IMGS_DEPTH;
+            break;
+        case GAME_ILLUMINATION_IMAGES:
+            rendering.format = IMGS_ILLUMINATION;
+            break;
+        case GAME_TEXT_IMAGES:
+            rendering.format = IMGS_TEXT;
+            break;
+        default: // LCOV_EXCL_LINE
+            assert(0); // LCOV_EXCL_LINE
+    }
+
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    PAR_run(run_offline_rendering_task, &rendering, number_of_threads);
+
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+    destroy_game_objects(&objects);
+
+    if (atomic_load(&rendering.has_failed))
+    {
+        return -1.0;
     }
 
-    TORUS_free(torus);
-    SPHERE_free(sphere);
-    REND_destroy(renderer);
+    return frames / get_elapsed_time(&start_time, &end_time);
 }
@@ -6,7 +6,20 @@
 #define GAME_GAME_H
 
 /**
- * \brief Run the game
+ * \brief What is written of each frame when rendering offline, see GAME_render_offline()
+ */
+enum GAME_ImageFormat
+{
+    GAME_DEPTH_IMAGES, /**< The depths as grayscale PGM images */
+    GAME_ILLUMINATION_IMAGES, /**< The illumination as grayscale PGM images */
+    GAME_TEXT_IMAGES /**< The characters as text files */
+};
+
+/**
+ * \brief Run the game, the simulation is advanced one step per frame
+ *
+ * The simulation time step is the frame time, i.e. the game slows down if the frame rate can not
+ * be achieved.
  *
  * \param[in] fps The frame rate [frames / s]
  * \param[in] steps The number of steps/frames to run
@@ -15,4 +28,77 @@ void GAME_run(
     double fps,
     int steps);
 
+/**
+ * \brief Run the game with a fixed simulation time step, independent of the frame rate
+ *
+ * Each frame the simulation is advanced with the number of fixed time steps that corresponds to
+ * the real time that has passed, and the rendered state is interpolated between the last two
+ * steps. A lower frame rate, e.g. due to overload, thus makes the game less smooth but does not
+ * change its speed.
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] simulation_rate The simulation rate [steps / s]
+ * \param[in] frames The number of frames to run
+ */
+void GAME_run_fixed_timestep(
+    double fps,
+    double simulation_rate,
+    int frames);
+
+/**
+ * \brief Run the game with the simulation and the rendering in separate threads
+ *
+ * The simulation thread advances the simulation with a fixed time step in real time and publishes
+ * a snapshot of the objects after each step. Each frame renders the latest complete snapshot
+ * without waiting for the simulation, so the simulation and the rendering overlap and a slow
+ * simulation step does not delay the frames.
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] simulation_rate The simulation rate [steps / s]
+ * \param[in] frames The number of frames to run
+ */
+void GAME_run_threaded(
+    double fps,
+    double simulation_rate,
+    int frames);
+
+/**
+ * \brief Run the game with the rendering split between several worker processes (sort-last)
+ *
+ * Each worker process runs its own copy of the simulation, advanced one step per frame as in
+ * GAME_run(), renders its partition of the objects and sends the frame and the depths over a Unix
+ * domain socket. The calling process composites the frames of all workers and shows them at the
+ * frame rate.
+ *
+ * \param[in] fps The frame rate [frames / s]
+ * \param[in] frames The number of frames to run
+ * \param[in] number_of_workers The number of worker processes
+ */
+void GAME_run_sort_last(
+    double fps,
+    int frames,
+    int number_of_workers);
+
+/**
+ * \brief Render the game offline as fast as possible and write the frames as images
+ *
+ * The simulation is advanced one step of the frame time per frame as in GAME_run(), but the frames
+ * are neither synchronized to the frame rate nor shown. The frames are rendered in parallel, each
+ * thread has its own copy of the game and renderer and renders every number_of_threads:th frame.
+ *
+ * \param[in] directory The directory to write the images to, must exist
+ * \param[in] format What is written of each frame
+ * \param[in] fps The frame rate of the rendered sequence [frames / s]
+ * \param[in] frames The number of frames to render
+ * \param[in] number_of_threads The number of threads to render with
+ *
+ * \return The throughput [frames / s], a negative value if an image could not be written
+ */
+double GAME_render_offline(
+    const char *directory,
+    enum GAME_ImageFormat format,
+    double fps,
+    int frames,
+    int number_of_threads);
+
 #endif /* GAME_GAME_H */
@@ -0,0 +1,144 @@
+#include "../entities.h"
+
+#include <Base/common.h>
+#include <Base/coordinates.h>
+#include <Engine/renderer.h>
+#include <TestFramework/test_framework.h>
+
+#include <math.h>
+#include <stddef.h>
+
+int TF_test_case_status;
+
+static const double granularity = 1e-5;
+
+static void test_ENT_spawn(void)
+{
+    struct ENT_EntityStore *const store = ENT_create(2);
+    const struct ENT_Entity entity = {
+        .path_center = {.x = 1.0, .y = 2.0, .z = 3.0},
+        .path_radius = 0.5,
+        .path_angle = 0.0,
+        .rotation = {.pitch = 0.1, .yaw = 0.2, .roll = 0.3}
+    };
+    struct ENT_Handle first;
+    struct ENT_Handle second;
+    struct ENT_Handle third;
+
+    TF_assert(ENT_spawn(store, &entity, &first));
+    TF_assert(ENT_spawn(store, &entity, &second));
+    TF_assert(!ENT_spawn(store, &entity, &third));
+    TF_assert(ENT_get_length(store) == 2);
+    TF_assert(ENT_is_alive(store, &first));
+    TF_assert(ENT_is_alive(store, &second));
+
+    struct COORD_Coordinate3D position;
+    ENT_get_position(store, &first, &position);
+    TF_assert_double_eq(position.x, 1.5, granularity);
+    TF_assert_double_eq(position.y, 2.0, granularity);
+    TF_assert_double_eq(position.z, 3.0, granularity);
+
+    struct ENT_Entity components;
+    ENT_get(store, &second, &components);
+    TF_assert_double_eq(components.path_radius, 0.5, granularity);
+    TF_assert_double_eq(components.rotation.roll, 0.3, granularity);
+
+    ENT_destroy(store);
+}
+
+static void test_ENT_despawn(void)
+{
+    struct ENT_EntityStore *const store = ENT_create(3);
+    const struct ENT_Entity a = {.path_center = {.x = 1.0}};
+    const struct ENT_Entity b = {.path_center = {.x = 2.0}};
+    const struct ENT_Entity c = {.path_center = {.x = 3.0}};
+    struct ENT_Handle handle_a;
+    struct ENT_Handle handle_b;
+    struct ENT_Handle handle_c;
+    struct ENT_Handle handle_d;
+
+    ENT_spawn(store, &a, &handle_a);
+    ENT_spawn(store, &b, &handle_b);
+    ENT_spawn(store, &c, &handle_c);
+
+    ENT_despawn(store, &handle_a);
+    TF_assert(!ENT_is_alive(store, &handle_a));
+    TF_assert(ENT_get_length(store) == 2);
+
+    /* The other entities are still found through their handles after being moved */
+    struct COORD_Coordinate3D position;
+    ENT_get_position(store, &handle_b, &position);
+    TF_assert_double_eq(position.x, 2.0, granularity);
+    ENT_get_position(store, &handle_c, &position);
+    TF_assert_double_eq(position.x, 3.0, granularity);
+
+    /* The storage is reused but the old handle stays invalid */
+    TF_assert(ENT_spawn(store, &c, &handle_d));
+    TF_assert(handle_d.index == handle_a.index);
+    TF_assert(!ENT_is_alive(store, &handle_a));
+    TF_assert(ENT_is_alive(store, &handle_d));
+
+    /* Despawning an invalid handle does nothing */
+    ENT_despawn(store, &handle_a);
+    TF_assert(ENT_get_length(store) == 3);
+
+    ENT_destroy(store);
+}
+
+static void test_ENT_update(void)
+{
+    struct ENT_EntityStore *const store = ENT_create(1);
+    const struct ENT_Entity entity = {
+        .path_center = {.x = 0.0, .y = 1.0, .z = 3.0},
+        .path_radius = 2.0,
+        .path_angle = 0.0,
+        .path_angular_velocity = M_PI,
+        .rotation = {.pitch = 0.0, .yaw = 0.0, .roll = 0.0},
+        .angular_velocity = {.pitch = 1.0, .yaw = 2.0, .roll = 3.0}
+    };
+    struct ENT_Handle handle;
+    ENT_spawn(store, &entity, &handle);
+
+    ENT_update(store, 0.5);
+
+    struct COORD_Coordinate3D position;
+    ENT_get_position(store, &handle, &position);
+    TF_assert_double_eq(position.x, 0.0, granularity);
+    TF_assert_double_eq(position.y, 1.0, granularity);
+    TF_assert_double_eq(position.z, 5.0, granularity);
+
+    struct ENT_Entity components;
+    ENT_get(store, &handle, &components);
+    TF_assert_double_eq(components.path_angle, M_PI / 2.0, granularity);
+    TF_assert_double_eq(components.rotation.pitch, 0.5, granularity);
+    TF_assert_double_eq(components.rotation.yaw, 1.0, granularity);
+    TF_assert_double_eq(components.rotation.roll, 1.5, granularity);
+
+    struct REND_ObjectWithPosition objects[1];
+    ENT_get_objects(store, 1.0, objects);
+    TF_assert_double_eq(objects[0].position.z, 5.0, granularity);
+    TF_assert_double_eq(objects[0].rotation.roll, 1.5, granularity);
+    TF_assert(objects[0].rotation_matrix == NULL);
+
+    /* Half way between the state before and after the update */
+    ENT_get_objects(store, 0.5, objects);
+    TF_assert_double_eq(objects[0].position.x, 1.0, granularity);
+    TF_assert_double_eq(objects[0].position.z, 4.0, granularity);
+    TF_assert_double_eq(objects[0].rotation.roll, 0.75, granularity);
+
+    ENT_destroy(store);
+}
+
+int main(int argc, char *argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    TF_test_case test_cases[] = {
+        test_ENT_spawn,
+        test_ENT_despawn,
+        test_ENT_update,
+    };
+
+    return TF_run_suite(test_cases, LENGTH(test_cases));
+}
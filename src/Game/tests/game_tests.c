@@ -3,6 +3,8 @@
 #include <TestFramework/test_framework.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 
 int TF_test_case_status;
 
@@ -24,6 +26,28 @@ static void test_GAME_run(void)
      */
     fclose(stdout);
     GAME_run(100.0, 2);
+    GAME_run_fixed_timestep(100.0, 300.0, 2);
+    GAME_run_threaded(100.0, 300.0, 2);
+    GAME_run_sort_last(100.0, 2, 2);
+}
+
+static void test_GAME_render_offline(void)
+{
+    char directory[] = "/tmp/game_tests_XXXXXX";
+    TF_assert(mkdtemp(directory) != NULL);
+
+    TF_assert(GAME_render_offline(directory, GAME_DEPTH_IMAGES, 100.0, 3, 2) > 0.0);
+
+    /* Each frame is written exactly once */
+    for (int i = 0; i < 3; ++i)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "%s/frame_%06d.pgm", directory, i);
+        TF_assert(remove(path) == 0);
+    }
+
+    TF_assert(rmdir(directory) == 0);
+    TF_assert(GAME_render_offline(directory, GAME_TEXT_IMAGES, 100.0, 1, 1) < 0.0);
 }
 
 int main(int argc, char *argv[])
@@ -33,6 +57,7 @@ int main(int argc, char *argv[])
 
     TF_test_case test_cases[] = {
         test_GAME_run,
+        test_GAME_render_offline,
     };
 
     return TF_run_suite(test_cases, LENGTH(test_cases));
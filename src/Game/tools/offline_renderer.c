@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief Offline renderer, renders the game as fast as possible to a sequence of images
+ *
+ * See GAME_render_offline(). The throughput is reported when done. Usage:
+ *
+ *     OfflineRenderer <directory> <frames> [depth|illumination|text] [threads]
+ *
+ * The images are depth images rendered by one thread per online CPU by default.
+ */
+#include <Base/parallel.h>
+#include <Game/game.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FPS (20.0)
+#define MAX_THREADS (64)
+
+int main(int argc, char *argv[])
+{
+    if ((argc < 3) || (argc > 5))
+    {
+        fprintf(stderr, "Usage: %s <directory> <frames> [depth|illumination|text] [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const int frames = atoi(argv[2]);
+    const char *const format_name = (argc > 3) ? argv[3] : "depth";
+    const int number_of_threads = (argc > 4) ? atoi(argv[4]) : PAR_get_number_of_threads(MAX_THREADS);
+    enum GAME_ImageFormat format;
+
+    if (strcmp(format_name, "depth") == 0)
+    {
+        format = GAME_DEPTH_IMAGES;
+    }
+    else if (strcmp(format_name, "illumination") == 0)
+    {
+        format = GAME_ILLUMINATION_IMAGES;
+    }
+    else if (strcmp(format_name, "text") == 0)
+    {
+        format = GAME_TEXT_IMAGES;
+    }
+    else
+    {
+        fprintf(stderr, "Unknown image format: %s\n", format_name);
+        return EXIT_FAILURE;
+    }
+
+    if ((frames <= 0) || (number_of_threads <= 0))
+    {
+        fprintf(stderr, "The number of frames and threads must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    const double frames_per_second = GAME_render_offline(argv[1], format, FPS, frames, number_of_threads);
+
+    if (frames_per_second < 0.0)
+    {
+        fprintf(stderr, "Could not write the images to %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%d frames with %d threads: %.1f frames/s\n", frames, number_of_threads, frames_per_second);
+
+    return EXIT_SUCCESS;
+}
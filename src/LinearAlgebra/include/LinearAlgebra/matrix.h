@@ -61,6 +61,42 @@ void MAT_set_all_elements(
     struct MAT_Matrix *matrix,
     double value);
 
+/**
+ * \brief Set all elements in a block (submatrix) of a matrix to a certain value
+ *
+ * \param[in,out] matrix The matrix
+ * \param[in] first_row The first row of the block
+ * \param[in] first_col The first column of the block
+ * \param[in] rows The number of rows in the block
+ * \param[in] cols The number of columns in the block
+ * \param[in] value The value
+ */
+void MAT_set_block_elements(
+    struct MAT_Matrix *matrix,
+    int first_row,
+    int first_col,
+    int rows,
+    int cols,
+    double value);
+
+/**
+ * \brief Copy a block (submatrix) from one matrix to the same block of another matrix
+ *
+ * \param[in] source The matrix to copy from
+ * \param[in] first_row The first row of the block
+ * \param[in] first_col The first column of the block
+ * \param[in] rows The number of rows in the block
+ * \param[in] cols The number of columns in the block
+ * \param[in,out] destination The matrix to copy to, same size as the source
+ */
+void MAT_copy_block(
+    const struct MAT_Matrix *source,
+    int first_row,
+    int first_col,
+    int rows,
+    int cols,
+    struct MAT_Matrix *destination);
+
 /**
  * \brief Get a certain element from a mtrix
  *
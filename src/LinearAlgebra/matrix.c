@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 struct MAT_Matrix * MAT_alloc(
     const int rows,
@@ -46,15 +47,57 @@ void MAT_set_all_elements(
     struct MAT_Matrix *const matrix,
     const double value)
 {
-    for (int r = 0; r < matrix->rows; ++r)
+    const int number_of_elements = matrix->rows * matrix->cols;
+
+    /* Access the data directly, this is used to clear large buffers every frame. */
+    for (int i = 0; i < number_of_elements; ++i)
+    {
+        matrix->data[i] = value;
+    }
+}
+
+void MAT_set_block_elements(
+    struct MAT_Matrix *const matrix,
+    const int first_row,
+    const int first_col,
+    const int rows,
+    const int cols,
+    const double value)
+{
+    assert((first_row >= 0) && (rows >= 0) && (first_row + rows <= matrix->rows)); // LCOV_EXCL_LINE
+    assert((first_col >= 0) && (cols >= 0) && (first_col + cols <= matrix->cols)); // LCOV_EXCL_LINE
+
+    for (int r = first_row; r < first_row + rows; ++r)
     {
-        for (int c = 0; c < matrix->cols; ++c)
+        double *const row = &matrix->data[(matrix->cols * r) + first_col];
+
+        for (int c = 0; c < cols; ++c)
         {
-            MAT_set_element(matrix, r, c, value);
+            row[c] = value;
         }
     }
 }
 
+void MAT_copy_block(
+    const struct MAT_Matrix *const source,
+    const int first_row,
+    const int first_col,
+    const int rows,
+    const int cols,
+    struct MAT_Matrix *const destination)
+{
+    assert((source->rows == destination->rows) && (source->cols == destination->cols)); // LCOV_EXCL_LINE
+    assert((first_row >= 0) && (rows >= 0) && (first_row + rows <= source->rows)); // LCOV_EXCL_LINE
+    assert((first_col >= 0) && (cols >= 0) && (first_col + cols <= source->cols)); // LCOV_EXCL_LINE
+
+    for (int r = first_row; r < first_row + rows; ++r)
+    {
+        const int offset = (source->cols * r) + first_col;
+
+        memcpy(&destination->data[offset], &source->data[offset], (size_t)cols * sizeof(*source->data));
+    }
+}
+
 double MAT_get_element(
     const struct MAT_Matrix *const matrix,
     const int row,
@@ -125,6 +125,66 @@ static void test_MAT_matrix_vector_multiplication(void)
     VEC_free(output);
 }
 
+static void test_MAT_set_all_elements(void)
+{
+    struct MAT_Matrix *const matrix = MAT_alloc(3, 4);
+
+    MAT_set_all_elements(matrix, 2.5);
+
+    for (int r = 0; r < matrix->rows; ++r)
+    {
+        for (int c = 0; c < matrix->cols; ++c)
+        {
+            TF_assert_double_eq(MAT_get_element(matrix, r, c), 2.5, granularity);
+        }
+    }
+
+    MAT_free(matrix);
+}
+
+static void test_MAT_set_block_elements(void)
+{
+    struct MAT_Matrix *const matrix = MAT_alloc(4, 5);
+
+    MAT_set_all_elements(matrix, 1.0);
+    MAT_set_block_elements(matrix, 1, 2, 2, 3, 7.0);
+
+    for (int r = 0; r < matrix->rows; ++r)
+    {
+        for (int c = 0; c < matrix->cols; ++c)
+        {
+            const int inside = (r >= 1) && (r < 3) && (c >= 2);
+
+            TF_assert_double_eq(MAT_get_element(matrix, r, c), inside ? 7.0 : 1.0, granularity);
+        }
+    }
+
+    MAT_free(matrix);
+}
+
+static void test_MAT_copy_block(void)
+{
+    struct MAT_Matrix *const source = MAT_alloc(4, 5);
+    struct MAT_Matrix *const destination = MAT_alloc(4, 5);
+
+    MAT_set_all_elements(source, 3.0);
+    MAT_set_all_elements(destination, 1.0);
+    MAT_copy_block(source, 2, 0, 2, 4, destination);
+
+    for (int r = 0; r < destination->rows; ++r)
+    {
+        for (int c = 0; c < destination->cols; ++c)
+        {
+            const int inside = (r >= 2) && (c < 4);
+
+            TF_assert_double_eq(MAT_get_element(destination, r, c), inside ? 3.0 : 1.0, granularity);
+        }
+    }
+
+    MAT_free(destination);
+    MAT_free(source);
+}
+
 int main(int argc, char *argv[])
 {
     UNUSED(argc);
@@ -134,6 +194,9 @@ int main(int argc, char *argv[])
         test_MAT_transpose_square,
         test_MAT_matrix_matrix_multiplication,
         test_MAT_matrix_vector_multiplication,
+        test_MAT_set_all_elements,
+        test_MAT_set_block_elements,
+        test_MAT_copy_block,
     };
 
     return TF_run_suite(test_cases, LENGTH(test_cases));
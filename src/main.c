@@ -2,12 +2,13 @@
 #include <Game/Game.h>
 
 #define FPS (20.0)
-#define STEPS (1000)
+#define SIMULATION_RATE (60.0)
+#define FRAMES (1000)
 
 int main(int argc, char *argv[])
 {
     UNUSED(argc);
     UNUSED(argv);
 
-    GAME_run(FPS, STEPS);
+    GAME_run_threaded(FPS, SIMULATION_RATE, FRAMES);
 }